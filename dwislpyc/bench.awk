@@ -0,0 +1,33 @@
+#
+# bench.awk
+#
+# Generates a large DWISLPY program for timing the compiler (see `make
+# bench`). It has `defs` functions, each with a loop of `body` lines of
+# arithmetic, followed by a main script that calls and prints each one.
+# With the defaults this is about 100k lines.
+#
+#     awk -v defs=2000 -v body=38 -f bench.awk > bench.slpy
+#
+BEGIN {
+    if (defs == "") defs = 2000
+    if (body == "") body = 38
+    for (d = 0; d < defs; d++) {
+        printf "def f%d(a : int, b : int) -> int:\n", d
+        print  "    x : int = a + b"
+        print  "    y : int = a * 3"
+        print  "    i : int = 0"
+        print  "    while i < b:"
+        for (k = 1; k <= body; k++) {
+            printf "        x = x + y * %d - i // %d\n", k, k+1
+        }
+        print  "        i += 1"
+        print  "    if x < y:"
+        print  "        return x"
+        print  "    else:"
+        print  "        return y + x % 7"
+        print  ""
+    }
+    for (d = 0; d < defs; d++) {
+        printf "print(f%d(%d,3))\n", d, d
+    }
+}
@@ -44,6 +44,12 @@
 typedef std::variant<int, bool, std::string, none> Valu;
 typedef std::optional<Valu> RtnO;
 
+// to_string(v)
+//
+// The text of a value, as `print` outputs it.
+//
+std::string to_string(Valu v);
+
 //
 // We "pre-declare" each AST subclass for mutually recursive definitions.
 //
@@ -84,10 +90,18 @@ class Lkup;
 class Ltrl;
 class FCll;
 
+class PassManager; // See dwislpy-pass.hh.
+class AsmOut;      // See dwislpy-emit.hh.
+class Cache;       // See dwislpy-cach.hh.
+
+//
+// The machines that `Prgm::compile` can generate code for.
+//
+enum Target { MIPS32, X86_64, LLVM_IR };
+
 //
 // We alias some types, including pointers and vectors.
 //
-typedef std::string Labl;
 typedef std::string Name;
 typedef std::unordered_map<Name,Valu> Ctxt;
 //
@@ -194,8 +208,14 @@ public:
     virtual void dump(int level = 0) const;
     virtual void run(void) const;                // Execute the program.
     virtual void output(std::ostream& os) const; // Output formatted code.
-    virtual void trans(void);                    // Translate to IR. (HW5)
-    virtual void compile(std::ostream& os);      // Generate MIPS. (HW5)
+    virtual void trans(int jobs = 1);            // Translate to IR. (HW5)
+    virtual void trans_main(void);
+    virtual void compile(AsmOut& os,             // Generate MIPS. (HW5)
+                         PassManager& passes, Cache* cache = nullptr,
+                         Target target = MIPS32);
+    virtual void dump_cfg(std::ostream& os);     // Output the IR's CFGs.
+    virtual void interpret(PassManager& passes); // Run the IR.
+    virtual void load_spim(PassManager& passes); // Load into SPIM.
 };
 
 //
@@ -259,7 +279,7 @@ public:
     virtual std::optional<Valu> exec(const Defs& defs, Ctxt& ctxt) const = 0;
     virtual void output(std::ostream& os, std::string indent) const = 0;
     virtual void output(std::ostream& os) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code) = 0;
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code) = 0;
                                               // Generate IR code. (HW5)
 };
 
@@ -278,7 +298,7 @@ public:
     virtual std::optional<Valu> exec(const Defs& defs, Ctxt& ctxt) const;
     virtual void output(std::ostream& os, std::string indent) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code);
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code);
 };
 
 //
@@ -294,7 +314,7 @@ public:
     virtual std::optional<Valu> exec(const Defs& defs, Ctxt& ctxt) const;
     virtual void output(std::ostream& os, std::string indent) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code);
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code);
 };
 
 //
@@ -310,7 +330,7 @@ public:
     virtual std::optional<Valu> exec(const Defs& defs, Ctxt& ctxt) const;
     virtual void output(std::ostream& os, std::string indent) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code);
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code);
 };
 
 //
@@ -326,7 +346,7 @@ public:
     virtual std::optional<Valu> exec(const Defs& defs, Ctxt& ctxt) const;
     virtual void output(std::ostream& os, std::string indent) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code);
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code);
 };
 
 //
@@ -341,7 +361,7 @@ public:
     virtual std::optional<Valu> exec(const Defs& defs, Ctxt& ctxt) const;
     virtual void output(std::ostream& os, std::string indent) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code);
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code);
 };
 
 
@@ -356,7 +376,7 @@ public:
     virtual std::optional<Valu> exec(const Defs& defs, Ctxt& ctxt) const;
     virtual void output(std::ostream& os, std::string indent) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code);
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code);
 };
 
 class PCll : public Stmt {
@@ -369,7 +389,7 @@ public:
     virtual std::optional<Valu> exec(const Defs& defs, Ctxt& ctxt) const;
     virtual void output(std::ostream& os, std::string indent) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code);
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code);
 };
 
 class PRtn : public Stmt {
@@ -380,7 +400,7 @@ public:
     virtual std::optional<Valu> exec(const Defs& defs, Ctxt& ctxt) const;
     virtual void output(std::ostream& os, std::string indent) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code);
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code);
 };
 
 class FRtn : public Stmt {
@@ -392,7 +412,7 @@ public:
     virtual std::optional<Valu> exec(const Defs& defs, Ctxt& ctxt) const;
     virtual void output(std::ostream& os, std::string indent) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code);
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code);
 };
 
 class IfEl : public Stmt {
@@ -407,7 +427,7 @@ public:
     virtual std::optional<Valu> exec(const Defs& defs, Ctxt& ctxt) const;
     virtual void output(std::ostream& os, std::string indent) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code);
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code);
 };
 
 class Whle : public Stmt {
@@ -420,7 +440,7 @@ public:
     virtual std::optional<Valu> exec(const Defs& defs, Ctxt& ctxt) const;
     virtual void output(std::ostream& os, std::string indent) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code);
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code);
 };
 
 //
@@ -438,7 +458,7 @@ public:
     virtual void output(std::ostream& os, std::string indent) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string exit, SymT& symt, INST_vec& code);
+    virtual void trans(Labl exit, SymT& symt, INST_vec& code);
 };
 
 
@@ -461,6 +481,8 @@ public:
 //  * eval(ctxt): evaluate the expression; return its result
 //  * output(os): output formatted DwiSlpy code of the expression.
 //  * dump: output the syntax tree of the expression
+//  * pure: whether evaluating it has no effect and can't fail, and so
+//        it can be computed even where `and`/`or` would skip it.
 //
 class Expn : public AST {
 public:
@@ -469,10 +491,10 @@ public:
     virtual ~Expn(void) = default;
     virtual Type chck(Defs& defs, SymT& symt) = 0;
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const = 0;
-    virtual void trans(Name dest, SymT& symt, INST_vec& code) = 0;
-    virtual void trans_cndn(std::string then_lbl, std::string else_lbl,
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code) = 0;
+    virtual void trans_cndn(Labl then_lbl, Labl else_lbl,
                             SymT& symt, INST_vec& code); // Generate IR (HW5)
-                
+    virtual bool pure(void) const; // No effects and can't fail?
 };
 
 //
@@ -489,7 +511,7 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
 };
 
 //
@@ -506,7 +528,7 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
 };
 
 //
@@ -523,7 +545,8 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
+    virtual bool pure(void) const;
 };
 
 //
@@ -540,7 +563,7 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
 };
 
 //
@@ -557,7 +580,7 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
 };
 
 class Less : public Expn {
@@ -571,8 +594,9 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
-    virtual void trans_cndn(std::string then_lbl, std::string else_lbl, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
+    virtual void trans_cndn(Labl then_lbl, Labl else_lbl, SymT& symt, INST_vec& code);
+    virtual bool pure(void) const;
 };
 
 class LsEq : public Expn {
@@ -586,8 +610,9 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
-    virtual void trans_cndn(std::string then_lbl, std::string else_lbl, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
+    virtual void trans_cndn(Labl then_lbl, Labl else_lbl, SymT& symt, INST_vec& code);
+    virtual bool pure(void) const;
 };
 
 class Equl : public Expn {
@@ -601,8 +626,9 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
-    virtual void trans_cndn(std::string then_lbl, std::string else_lbl, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
+    virtual void trans_cndn(Labl then_lbl, Labl else_lbl, SymT& symt, INST_vec& code);
+    virtual bool pure(void) const;
 };
 
 class And : public Expn {
@@ -616,8 +642,9 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
-    virtual void trans_cndn(std::string then_lbl, std::string else_lbl, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
+    virtual void trans_cndn(Labl then_lbl, Labl else_lbl, SymT& symt, INST_vec& code);
+    virtual bool pure(void) const;
 };
 
 class Or : public Expn {
@@ -631,8 +658,9 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
-    virtual void trans_cndn(std::string then_lbl, std::string else_lbl, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
+    virtual void trans_cndn(Labl then_lbl, Labl else_lbl, SymT& symt, INST_vec& code);
+    virtual bool pure(void) const;
 };
 
 class Not : public Expn {
@@ -645,8 +673,9 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
-    virtual void trans_cndn(std::string then_lbl, std::string else_lbl, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
+    virtual void trans_cndn(Labl then_lbl, Labl else_lbl, SymT& symt, INST_vec& code);
+    virtual bool pure(void) const;
 };
 
 //
@@ -661,8 +690,9 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
-    virtual void trans_cndn(std::string then_lbl, std::string else_lbl, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
+    virtual void trans_cndn(Labl then_lbl, Labl else_lbl, SymT& symt, INST_vec& code);
+    virtual bool pure(void) const;
 };
 
 //
@@ -677,8 +707,9 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
-    virtual void trans_cndn(std::string then_lbl, std::string else_lbl, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
+    virtual void trans_cndn(Labl then_lbl, Labl else_lbl, SymT& symt, INST_vec& code);
+    virtual bool pure(void) const;
 };
 
 //
@@ -693,7 +724,7 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
 };
 
 //
@@ -708,7 +739,7 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
 };
 
 //
@@ -723,7 +754,7 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
 };
 
 class FCll : public Expn {
@@ -736,8 +767,8 @@ public:
     virtual Valu eval(const Defs& defs, const Ctxt& ctxt) const;
     virtual void output(std::ostream& os) const;
     virtual void dump(int level = 0) const;
-    virtual void trans(std::string dest, SymT& symt, INST_vec& code);
-    virtual void trans_cndn(std::string then_lbl, std::string else_lbl, SymT& symt, INST_vec& code);
+    virtual void trans(Symb dest, SymT& symt, INST_vec& code);
+    virtual void trans_cndn(Labl then_lbl, Labl else_lbl, SymT& symt, INST_vec& code);
 };
 
 #endif
@@ -0,0 +1,139 @@
+#include <string>
+#include <sstream>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <system_error>
+#include <unistd.h>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-cach.hh"
+
+//
+// dwislpy-cach.cc
+//
+// The on-disk cache of compiled functions. See `dwislpy-cach.hh`.
+//
+
+__extension__ typedef unsigned __int128 Hash;
+
+//
+// hash_of(text)
+//
+// The 128-bit FNV-1a hash of `text`, as 32 hex digits.
+//
+static std::string hash_of(const std::string& text) {
+    const Hash prime = ((Hash)1 << 88) + 0x13b;
+    Hash hash = ((Hash)0x6c62272e07bb0142ULL << 64) + 0x62b821756295c58dULL;
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= prime;
+    }
+    static const char* digits = "0123456789abcdef";
+    std::string hex(32,'0');
+    for (int i = 31; i >= 0; i--) {
+        hex[i] = digits[(int)(hash & 0xf)];
+        hash >>= 4;
+    }
+    return hex;
+}
+
+Cache::Cache(std::string d) : dir {d}, hits {0}, misses {0} {
+    std::error_code err;
+    std::filesystem::create_directories(dir,err);
+}
+
+std::string Cache::path_of(const std::string& hash) const {
+    return dir + "/" + hash + ".s";
+}
+
+//
+// Cache::key_of(tag,symt,code)
+//
+// The key of the assembly compiled from `code` by way of `tag`, which
+// names the target and the passes to be run. Each instruction is keyed
+// by its dump followed by the numbers of its operands.
+//
+std::string Cache::key_of(std::string tag,
+                          const SymT& symt, const INST_vec& code) {
+    std::unordered_map<Symb,int> number {};
+    auto number_of = [&number](Symb sym) {
+        auto known = number.find(sym);
+        if (known != number.end()) {
+            return known->second;
+        }
+        int n = number.size();
+        number[sym] = n;
+        return n;
+    };
+    std::ostringstream key {};
+    key << "dwislpyc " << CACHE_VERSION << " " << tag << "\n";
+    for (unsigned int i = 0; i < symt.get_frmls_size(); i++) {
+        key << "FRML " << number_of(symt.get_frml_symb(i)) << "\n";
+    }
+    for (const INST& inst : code) {
+        inst.dump(key);
+        key << " |";
+        for (Symb* src : inst.srcs()) {
+            key << " " << number_of(*src);
+        }
+        key << " |";
+        for (Symb* dst : inst.dsts()) {
+            key << " " << number_of(*dst);
+        }
+        key << "\n";
+    }
+    return key.str();
+}
+
+//
+// Cache::fetch(key,text)
+//
+bool Cache::fetch(const std::string& key, std::string& text) {
+    std::string hash = hash_of(key);
+    std::ifstream in {path_of(hash), std::ios::binary};
+    std::string header;
+    if (in && std::getline(in,header) && header == "# dwislpyc " + hash) {
+        text.assign(std::istreambuf_iterator<char> {in},
+                    std::istreambuf_iterator<char> {});
+        hits++;
+        return true;
+    }
+    misses++;
+    return false;
+}
+
+//
+// Cache::store(key,text)
+//
+// Writes the entry under a name no other thread or process is using,
+// then renames it into place. Any failure just leaves the entry out.
+//
+void Cache::store(const std::string& key, const std::string& text) {
+    static std::atomic<int> count {0};
+    std::string hash = hash_of(key);
+    std::string path = path_of(hash);
+    std::string temp = path + ".tmp." + std::to_string(getpid())
+                       + "." + std::to_string(count++);
+    {
+        std::ofstream out {temp, std::ios::binary};
+        out << "# dwislpyc " << hash << "\n" << text;
+        out.close();
+        if (!out) {
+            std::remove(temp.c_str());
+            return;
+        }
+    }
+    std::error_code err;
+    std::filesystem::rename(temp,path,err);
+    if (err) {
+        std::remove(temp.c_str());
+    }
+}
+
+void Cache::report(std::ostream& os) const {
+    os << "cache: " << hits << " hits, " << misses << " misses" << std::endl;
+}
@@ -0,0 +1,63 @@
+#ifndef _DWISLPY_CACH_HH
+#define _DWISLPY_CACH_HH
+
+//
+// dwislpy-cach.hh
+//
+// An on-disk cache of the assembly compiled for each function, so that
+// recompiling a program with only a few changed `def`s only redoes the
+// work for those (see `dwislpyc --cache=<dir>`).
+//
+// A function's entry is keyed by a hash of everything its assembly
+// depends on: the function's IR as it stands after the whole-program
+// passes (see `PassManager::run`), its formals, the per-function passes
+// that are still to run, and the target. Inlining copies a callee's
+// code into its caller, and whether it does so depends on the whole
+// program, so the IR at this point is what tells whether anything
+// that matters to a function has changed. Its variables are keyed by
+// the order in which they first appear rather than by their names.
+// Labels, including those of called functions and string constants,
+// are keyed as they are, since they appear in the assembly.
+//
+// What's skipped on a hit is the optimization, register allocation,
+// and output of the function. The string constants are still output
+// from the symbol tables as usual.
+//
+// An entry is never changed once written, since a change to what it
+// depends on gives a different key. Entries are written to a file of
+// their own and then renamed into place, so that concurrent builds
+// sharing a cache only ever see whole entries. Each entry starts with
+// its key's hash, and one that doesn't match is treated as missing.
+// Bump CACHE_VERSION whenever the compiler would output different code
+// for the same IR.
+//
+// * Cache(dir)            - a cache kept in `dir`, which is made if need be.
+// * key_of(tag,symt,code) - the key of the assembly compiled from `code`.
+// * fetch(key,text)       - sets `text` to the entry for `key`, if any.
+// * store(key,text)       - records `text` as the entry for `key`.
+// * report(os)            - outputs the number of hits and misses.
+//
+
+#include <string>
+#include <atomic>
+#include <iostream>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+
+class Cache {
+public:
+    static const int CACHE_VERSION = 1;
+    Cache(std::string dir);
+    static std::string key_of(std::string tag,
+                              const SymT& symt, const INST_vec& code);
+    bool fetch(const std::string& key, std::string& text);
+    void store(const std::string& key, const std::string& text);
+    void report(std::ostream& os) const;
+private:
+    std::string dir;
+    std::atomic<int> hits;
+    std::atomic<int> misses;
+    std::string path_of(const std::string& hash) const;
+};
+
+#endif
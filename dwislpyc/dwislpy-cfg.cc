@@ -0,0 +1,341 @@
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <iostream>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-cfg.hh"
+
+//
+// dwislpy-cfg.cc
+//
+// Construction and manipulation of the control-flow graph of IR code.
+// See the header for an overview.
+//
+
+//
+// BBlk::lbls()
+//
+// The labels at the start of the block.
+//
+std::vector<Labl> BBlk::lbls(void) const {
+    std::vector<Labl> ls {};
+    for (const INST& inst : code) {
+        const LBL* lbl = inst.as<LBL>();
+        if (lbl == nullptr) {
+            break;
+        }
+        ls.push_back(lbl->lbl);
+    }
+    return ls;
+}
+
+//
+// BBlk::falls()
+//
+// Whether control can run off the end of the block.
+//
+bool BBlk::falls(void) const {
+    return code.empty() || code.back().fall();
+}
+
+//
+// CFG::CFG(code)
+//
+// Split `code` into basic blocks and link them.
+//
+CFG::CFG(const INST_vec& code) : blocks {} {
+    bool lead = true;
+    for (const INST& inst : code) {
+        if (lead || inst.as<LBL>()) {
+            blocks.push_back(BBlk {});
+        }
+        blocks.back().code.push_back(inst);
+        lead = !inst.fall() || !inst.jmps().empty();
+    }
+    if (blocks.empty()) {
+        blocks.push_back(BBlk {});
+    }
+    for (unsigned int b = 0; b+1 < blocks.size(); b++) {
+        if (blocks[b].falls()) {
+            blocks[b].next = b+1;
+        }
+    }
+    link();
+}
+
+//
+// CFG::link()
+//
+// Recompute the label map and each block's successors and predecessors.
+// A block that no longer falls through loses its `next`.
+//
+void CFG::link(void) {
+    labels.clear();
+    for (unsigned int b = 0; b < blocks.size(); b++) {
+        for (Labl lbl : blocks[b].lbls()) {
+            labels[lbl] = b;
+        }
+        blocks[b].succs.clear();
+        blocks[b].preds.clear();
+    }
+    for (unsigned int b = 0; b < blocks.size(); b++) {
+        BBlk& blk = blocks[b];
+        if (!blk.falls()) {
+            blk.next = -1;
+        }
+        std::vector<int> succs {};
+        if (blk.next >= 0) {
+            succs.push_back(blk.next);
+        }
+        if (!blk.code.empty()) {
+            for (Labl lbl : blk.code.back().jmps()) {
+                succs.push_back(labels.at(lbl));
+            }
+        }
+        for (int s : succs) {
+            if (std::find(blk.succs.begin(),blk.succs.end(),s) == blk.succs.end()) {
+                blk.succs.push_back(s);
+                blocks[s].preds.push_back(b);
+            }
+        }
+    }
+}
+
+int CFG::block_of(Labl lbl) const {
+    return labels.at(lbl);
+}
+
+//
+// CFG::rpo()
+//
+// Reverse postorder of the blocks reachable from block 0. This is the
+// order in which forward dataflow analyses converge fastest.
+//
+std::vector<int> CFG::rpo(void) const {
+    std::vector<int> order {};
+    std::vector<bool> seen(blocks.size(),false);
+    std::vector<std::pair<int,unsigned int>> stack { {0,0} };
+    seen[0] = true;
+    while (!stack.empty()) {
+        int b = stack.back().first;
+        unsigned int& i = stack.back().second;
+        if (i < blocks[b].succs.size()) {
+            int s = blocks[b].succs[i++];
+            if (!seen[s]) {
+                seen[s] = true;
+                stack.push_back({s,0});
+            }
+        } else {
+            order.push_back(b);
+            stack.pop_back();
+        }
+    }
+    std::reverse(order.begin(),order.end());
+    return order;
+}
+
+//
+// CFG::dominate()
+//
+// Computes immediate dominators with the iterative algorithm from
+// Cooper, Harvey, and Kennedy, "A Simple, Fast Dominance Algorithm".
+//
+void CFG::dominate(void) {
+    std::vector<int> order = rpo();
+    std::vector<int> index(blocks.size(),-1);
+    for (unsigned int i = 0; i < order.size(); i++) {
+        index[order[i]] = i;
+    }
+    for (BBlk& blk : blocks) {
+        blk.idom = -1;
+    }
+    std::vector<int> doms(blocks.size(),-1);
+    doms[0] = 0;
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (unsigned int i = 1; i < order.size(); i++) {
+            int b = order[i];
+            int dom = -1;
+            for (int p : blocks[b].preds) {
+                if (doms[p] < 0) {
+                    continue;
+                }
+                if (dom < 0) {
+                    dom = p;
+                    continue;
+                }
+                // Intersect: walk both up the tree to a common block.
+                int f1 = p;
+                int f2 = dom;
+                while (f1 != f2) {
+                    while (index[f1] > index[f2]) f1 = doms[f1];
+                    while (index[f2] > index[f1]) f2 = doms[f2];
+                }
+                dom = f1;
+            }
+            if (doms[b] != dom) {
+                doms[b] = dom;
+                changed = true;
+            }
+        }
+    }
+    for (unsigned int b = 1; b < blocks.size(); b++) {
+        blocks[b].idom = doms[b];
+    }
+}
+
+//
+// CFG::dominates(b1,b2)
+//
+// Whether every path from the entry to block `b2` goes through `b1`.
+// Relies on `dominate` having been called.
+//
+bool CFG::dominates(int b1, int b2) const {
+    while (b2 >= 0) {
+        if (b1 == b2) {
+            return true;
+        }
+        b2 = blocks[b2].idom;
+    }
+    return false;
+}
+
+//
+// CFG::loop(head)
+//
+// The blocks of the natural loop with header `head`, or none if no
+// block jumps back to it. Relies on `dominate` having been called.
+//
+std::vector<bool> CFG::loop(int head) const {
+    std::vector<bool> body(blocks.size(),false);
+    std::vector<int> work {};
+    for (int p : blocks[head].preds) {
+        if (dominates(head,p)) {
+            work.push_back(p);
+        }
+    }
+    if (work.empty()) {
+        return body;
+    }
+    body[head] = true;
+    while (!work.empty()) {
+        int b = work.back();
+        work.pop_back();
+        if (!body[b]) {
+            body[b] = true;
+            for (int p : blocks[b].preds) {
+                work.push_back(p);
+            }
+        }
+    }
+    return body;
+}
+
+//
+// CFG::prune()
+//
+// Delete every block that can't be reached from block 0.
+//
+void CFG::prune(void) {
+    std::vector<int> order = rpo();
+    std::vector<bool> reached(blocks.size(),false);
+    for (int b : order) {
+        reached[b] = true;
+    }
+    std::vector<int> keep {};
+    for (unsigned int b = 0; b < blocks.size(); b++) {
+        if (reached[b]) {
+            keep.push_back(b);
+        }
+    }
+    reorder(keep);
+}
+
+//
+// CFG::reorder(order)
+//
+// Rearrange the blocks so that the i-th one is `order[i]`. Blocks
+// missing from `order` are dropped. Block 0 must stay first.
+//
+void CFG::reorder(const std::vector<int>& order) {
+    std::vector<int> index(blocks.size(),-1);
+    for (unsigned int i = 0; i < order.size(); i++) {
+        index[order[i]] = i;
+    }
+    std::vector<BBlk> reordered {};
+    for (int b : order) {
+        reordered.push_back(blocks[b]);
+        BBlk& blk = reordered.back();
+        blk.next = (blk.next >= 0) ? index[blk.next] : -1;
+    }
+    blocks = reordered;
+    link();
+}
+
+//
+// CFG::linearize(symt)
+//
+// Give back the flat code of the blocks in their current order. Where
+// a block falls through to a block other than the one that follows it,
+// a JMP is added, labelling the target with a new label from `symt` if
+// it has none. The targets are all labelled first, since one may come
+// before the block that jumps to it.
+//
+INST_vec CFG::linearize(SymT& symt) {
+    std::vector<Labl> jump(blocks.size());
+    for (unsigned int b = 0; b < blocks.size(); b++) {
+        BBlk& blk = blocks[b];
+        if (blk.next >= 0 && blk.next != (int)b+1) {
+            BBlk& trgt = blocks[blk.next];
+            std::vector<Labl> ls = trgt.lbls();
+            if (ls.empty()) {
+                Labl lbl = symt.add_labl();
+                trgt.code.insert(trgt.code.begin(), LBL {lbl});
+                ls.push_back(lbl);
+            }
+            jump[b] = ls.front();
+        }
+    }
+    INST_vec code {};
+    for (unsigned int b = 0; b < blocks.size(); b++) {
+        BBlk& blk = blocks[b];
+        code.insert(code.end(),blk.code.begin(),blk.code.end());
+        if (blk.next >= 0 && blk.next != (int)b+1) {
+            code.push_back(JMP {jump[b]});
+        }
+    }
+    return code;
+}
+
+//
+// CFG::dump(os)
+//
+// Output each block with its edges, dominator, and code.
+//
+void CFG::dump(std::ostream& os) const {
+    for (unsigned int b = 0; b < blocks.size(); b++) {
+        const BBlk& blk = blocks[b];
+        os << "B" << b << ":";
+        os << " preds=[";
+        for (unsigned int i = 0; i < blk.preds.size(); i++) {
+            os << (i ? "," : "") << "B" << blk.preds[i];
+        }
+        os << "] succs=[";
+        for (unsigned int i = 0; i < blk.succs.size(); i++) {
+            os << (i ? "," : "") << "B" << blk.succs[i];
+        }
+        os << "]";
+        if (blk.idom >= 0) {
+            os << " idom=B" << blk.idom;
+        }
+        os << std::endl;
+        for (const INST& inst : blk.code) {
+            os << "\t";
+            inst.dump(os);
+            os << std::endl;
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef _DWISLPY_CFG_HH
+#define _DWISLPY_CFG_HH
+
+//
+// dwislpy-cfg.hh
+//
+// A control-flow graph over the IR code of a `def` or the `main` script.
+//
+// The code is split into basic blocks: maximal runs of instructions
+// that are only entered at their start and only left at their end.
+// A block starts at the first instruction, at any LBL, and just after
+// any instruction that jumps or doesn't fall through (JMP, BCN, BCZ,
+// LEAVE).
+// Consecutive labels each start their own block, which is then empty
+// apart from that label.
+//
+// Blocks are numbered by their position in `blocks`, with block 0 the
+// entry. Each block records the blocks it can pass control to (`succs`)
+// and those that can pass control to it (`preds`). A block whose last
+// instruction falls through names the block it falls into as `next`.
+// Normally that is the block that follows it in `blocks`, but passes
+// that reorder blocks can change that, in which case `linearize` adds
+// the JMP needed to get there.
+//
+// Methods of CFG:
+// ---------------
+//
+// * link      - recomputes `succs` and `preds` from the blocks' code
+//               and their `next`. Call this after editing blocks.
+// * dominate  - computes each block's immediate dominator `idom`.
+// * dominates - whether one block dominates another.
+// * loop      - the blocks of the natural loop with a given header.
+// * rpo       - the reachable blocks in reverse postorder.
+// * prune     - deletes the blocks that can't be reached from block 0.
+// * reorder   - rearranges the blocks into a given order.
+// * linearize - gives back the flat code of the blocks, in order.
+// * dump      - outputs the blocks, their edges, and their code.
+//
+// These are meant for writing dataflow analyses and optimizations
+// over the IR without having each re-derive its structure from label
+// strings.
+//
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <iostream>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+
+//
+// class BBlk - a basic block.
+//
+class BBlk {
+public:
+    INST_vec code;
+    std::vector<int> succs;
+    std::vector<int> preds;
+    int next; // Block it falls through to, or -1.
+    int idom; // Immediate dominator, or -1 if entry or unreachable.
+    BBlk(void) : code {}, succs {}, preds {}, next {-1}, idom {-1} { }
+    std::vector<Labl> lbls(void) const;
+    bool falls(void) const;
+};
+
+//
+// class CFG - the basic blocks of some code.
+//
+class CFG {
+public:
+    std::vector<BBlk> blocks;
+    CFG(const INST_vec& code);
+    void link(void);
+    void dominate(void);
+    bool dominates(int b1, int b2) const;
+    std::vector<bool> loop(int head) const;
+    std::vector<int> rpo(void) const;
+    void prune(void);
+    void reorder(const std::vector<int>& order);
+    INST_vec linearize(SymT& symt);
+    void dump(std::ostream& os) const;
+    int block_of(Labl lbl) const;
+private:
+    std::unordered_map<Labl,int> labels;
+};
+
+#endif
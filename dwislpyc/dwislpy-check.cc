@@ -3,6 +3,13 @@
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <cstdint>
 
 #include "dwislpy-check.hh"
 #include "dwislpy-ast.hh"
@@ -60,6 +67,211 @@ std::string type_name(Type type) {
     return "wtf";
 }
 
+//
+// The `SymInfo` records of every symbol table, indexed by symbol. The
+// chunks are never moved or freed, so the pointers given by
+// `SymT::get_info` stay good, and a chunk's pointer is set before any
+// ID in it is given out.
+//
+std::atomic<SymInfo*> SymT::info_chunks[SymT::INFO_CHUNKS] {};
+std::atomic<int> SymT::info_count {0};
+std::atomic<int> SymT::next_table {0};
+static std::mutex info_chunk_lock;
+
+Symb SymT::new_info(const SymInfo& info) {
+    int id = info_count.fetch_add(1);
+    if (id >= INFO_CHUNK * INFO_CHUNKS) {
+        throw DwislpyError {Locn {"dwislpyc"}, "Too many variables."};
+    }
+    std::atomic<SymInfo*>& slot = info_chunks[id >> INFO_CHUNK_BITS];
+    SymInfo* chunk = slot.load(std::memory_order_acquire);
+    if (chunk == nullptr) {
+        std::lock_guard<std::mutex> hold {info_chunk_lock};
+        chunk = slot.load(std::memory_order_acquire);
+        if (chunk == nullptr) {
+            void* mem = ::operator new(sizeof(SymInfo) * INFO_CHUNK);
+            chunk = static_cast<SymInfo*>(mem);
+            slot.store(chunk, std::memory_order_release);
+        }
+    }
+    new (&chunk[id & (INFO_CHUNK - 1)]) SymInfo {info};
+    return Symb {id};
+}
+
+//
+// StrgPool::add(strg)
+//
+// The label is `S_` followed by the 64-bit FNV-1a hash of the string.
+//
+std::string StrgPool::add(const std::string& strg) {
+    std::lock_guard<std::mutex> hold {lock};
+    auto known = labels.find(strg);
+    if (known != labels.end()) {
+        return known->second;
+    }
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : strg) {
+        hash = (hash ^ c) * 1099511628211ULL;
+    }
+    std::ostringstream name {};
+    name << "S_" << std::hex << std::setw(16) << std::setfill('0') << hash;
+    std::string labl = name.str();
+    if (strings.count(labl) > 0) {
+        std::vector<std::string>& same = collided[labl];
+        if (same.empty()) {
+            same.push_back(strings.at(labl));
+        }
+        same.push_back(strg);
+        labl += "_" + std::to_string(same.size() - 1);
+    }
+    labels[strg] = labl;
+    strings[labl] = strg;
+    return labl;
+}
+
+//
+// StrgPool::settle()
+//
+// Each set of strings with the same hash keeps the same labels, but
+// they're given out in sorted order of the strings: the least gets
+// the label with no suffix, the next `_1`, and so on. The labels the
+// IR holds are renamed to match.
+//
+void StrgPool::settle(void) {
+    std::lock_guard<std::mutex> hold {lock};
+    for (std::pair<const std::string,std::vector<std::string>>& hash_strgs : collided) {
+        std::vector<std::string>& same = hash_strgs.second;
+        std::vector<Labl> lbls {};
+        for (const std::string& strg : same) {
+            lbls.push_back(Labl::of(labels.at(strg)));
+        }
+        std::vector<std::string> sorted = same;
+        std::sort(sorted.begin(), sorted.end());
+        for (unsigned int i = 0; i < same.size(); i++) {
+            unsigned int n = std::find(sorted.begin(), sorted.end(), same[i]) - sorted.begin();
+            std::string labl = hash_strgs.first;
+            if (n > 0) {
+                labl += "_" + std::to_string(n);
+            }
+            lbls[i].rename(labl);
+            labels[same[i]] = labl;
+            strings[labl] = same[i];
+        }
+        same = sorted;
+    }
+}
+
+//
+// StrgPool::layout()
+//
+// Sorting the strings by their reversals puts each just before those
+// it's a suffix of, if any. Working back from the end of that order,
+// each string is placed in the same one as the string after it if it
+// ends that string, and otherwise is output on its own.
+//
+std::vector<StrgData> StrgPool::layout(void) const {
+    std::vector<std::string> strgs {};
+    for (const std::pair<const std::string,std::string>& strg_lbl : labels) {
+        strgs.push_back(strg_lbl.first);
+    }
+    std::sort(strgs.begin(), strgs.end(),
+              [](const std::string& s1, const std::string& s2) {
+                  return std::lexicographical_compare(s1.rbegin(), s1.rend(),
+                                                      s2.rbegin(), s2.rend());
+              });
+    std::vector<StrgData> datas {};
+    std::vector<int> host(strgs.size());
+    for (int i = strgs.size() - 1; i >= 0; i--) {
+        const std::string& strg = strgs[i];
+        if (i + 1 < (int)strgs.size()) {
+            const std::string& next = strgs[i+1];
+            if (next.size() >= strg.size()
+                && next.compare(next.size() - strg.size(), strg.size(), strg) == 0) {
+                host[i] = host[i+1];
+                StrgData& data = datas[host[i]];
+                unsigned int offset = data.strg.size() - strg.size();
+                data.lbls.push_back({offset, labels.at(strg)});
+                continue;
+            }
+        }
+        host[i] = datas.size();
+        datas.push_back(StrgData {strg, {{0, labels.at(strg)}}});
+    }
+    return datas;
+}
+
+std::string Symb::name(void) const {
+    return SymT::name_of(*this);
+}
+
+std::string SymT::name_of(Symb sym) {
+    if (sym.empty()) {
+        return "";
+    }
+    const SymInfo& info = info_of(sym);
+    if (info.kind == TEMP && info.name.empty()) {
+        return "temp_" + std::to_string(info.identifier);
+    }
+    return info.name;
+}
+
+std::ostream& operator<<(std::ostream& os, Symb sym) {
+    return os << sym.name();
+}
+
+//
+// The names of the labels, indexed by `Labl::id`, in chunks of
+// LABL_CHUNK, and the ID of each name. A name is put in its chunk
+// before its ID is given out.
+//
+static const int LABL_CHUNK_BITS = 12;
+static const int LABL_CHUNK = 1 << LABL_CHUNK_BITS;
+static const int LABL_CHUNKS = 1 << 16;
+static std::atomic<std::string*> labl_chunks[LABL_CHUNKS] {};
+static std::unordered_map<std::string,int> labl_ids {};
+static std::mutex labl_lock;
+
+Labl Labl::of(const std::string& nm) {
+    std::lock_guard<std::mutex> hold {labl_lock};
+    auto known = labl_ids.find(nm);
+    if (known != labl_ids.end()) {
+        return Labl {known->second};
+    }
+    int id = labl_ids.size();
+    if (id >= LABL_CHUNK * LABL_CHUNKS) {
+        throw DwislpyError {Locn {"dwislpyc"}, "Too many labels."};
+    }
+    std::atomic<std::string*>& slot = labl_chunks[id >> LABL_CHUNK_BITS];
+    std::string* chunk = slot.load(std::memory_order_relaxed);
+    if (chunk == nullptr) {
+        chunk = new std::string[LABL_CHUNK];
+        slot.store(chunk, std::memory_order_release);
+    }
+    chunk[id & (LABL_CHUNK - 1)] = nm;
+    labl_ids[nm] = id;
+    return Labl {id};
+}
+
+const std::string& Labl::name(void) const {
+    static const std::string none {};
+    if (empty()) {
+        return none;
+    }
+    std::string* chunk = labl_chunks[id >> LABL_CHUNK_BITS].load(std::memory_order_acquire);
+    return chunk[id & (LABL_CHUNK - 1)];
+}
+
+void Labl::rename(const std::string& nm) {
+    std::lock_guard<std::mutex> hold {labl_lock};
+    std::string* chunk = labl_chunks[id >> LABL_CHUNK_BITS].load(std::memory_order_relaxed);
+    chunk[id & (LABL_CHUNK - 1)] = nm;
+    labl_ids[nm] = id;
+}
+
+std::ostream& operator<<(std::ostream& os, Labl lbl) {
+    return os << lbl.name();
+}
+
 unsigned int Defn::arity(void) const {
     return symt.get_frmls_size();
 }
@@ -265,33 +477,48 @@ Rtns PRtn::chck(Rtns expd,
     return Rtns {Type {NoneTy {}}};
 }
 
+//
+// chck_call(name,params,where,defs,symt)
+//
+// Check a call to the definition `name`, used by both PCll and FCll.
+// Each argument expression is checked first, whether or not there is
+// such a definition, and then their number and types are checked
+// against its formals. Gives the definition.
+//
+static Defn_ptr chck_call(Name name, Expn_vec& params, Locn where,
+                          Defs& defs, SymT& symt) {
+    std::vector<Type> arg_tys {};
+    for (Expn_ptr param : params) {
+        arg_tys.push_back(param->chck(defs,symt));
+    }
+    if (defs.count(name) == 0) {
+        throw DwislpyError {where, "Unknown definition."};
+    }
+    Defn_ptr dptr = defs.at(name);
+    if (params.size() != dptr->symt.get_frmls_size()) {
+        std::string msg = "Incorrect number of arguments.";
+        throw DwislpyError { where, msg };
+    };
+    for (unsigned int i=0; i<arg_tys.size(); i++) {
+        if (arg_tys[i] != dptr->symt.get_frml(i)->type) {
+            std::string msg = "Argument ";
+            msg += std::to_string(i) + " is an incorrect type.";
+            throw DwislpyError {where, msg};
+        }
+    }
+    return dptr;
+}
+
 Rtns PCll::chck([[maybe_unused]] Rtns expd, Defs& defs, SymT& symt) {
     //
     // This should look up a procedure's definition. It should check:
     // * that the correct number of arguments are passed.
-    // * that the return type is None
     // * that each of the argument expressions type check
     // * that the type of each argument matches the type signature
+    // A call, whatever its definition returns, doesn't return from the
+    // code that makes it.
     //
-    for (std::pair<Name,Defn_ptr> dfpr : defs) {
-        if (dfpr.first == name) {
-            Defn_ptr dptr = dfpr.second;
-            if (params.size() != dptr->symt.get_frmls_size()) {
-                std::string msg = "Incorrect number of arguments.";
-                throw DwislpyError { where(), msg };
-            };
-            for (unsigned int i=0; i<symt.get_frmls_size(); i++) {
-                if(symt.get_frml(i) != dptr->symt.get_frml(i)){
-                    std::string msg = "Argument ";
-                    msg += std::to_string(i) + " is an incorrect type.";
-                    throw DwislpyError {where(), msg};
-                }
-            }
-            if (dptr->rety == type_of(expd)) {
-                return expd;
-            }
-        }
-    }
+    chck_call(name,params,where(),defs,symt);
     return Rtns {Void {}};
 }
 
@@ -558,23 +785,6 @@ Type FCll::chck(Defs& defs, SymT& symt) {
     // * that the type of each argument matches the type signature
     // It should report the return type of the function.
     //
-    for (std::pair<Name,Defn_ptr> dfpr : defs) {
-        if (dfpr.first == name) {
-            Defn_ptr dptr = dfpr.second;
-            if (params.size() != dptr->symt.get_frmls_size()) {
-                std::string msg = "Incorrect number of arguments.";
-                throw DwislpyError { where(), msg };
-            };
-            for (unsigned int i=0; i<symt.get_frmls_size(); i++) {
-                if(symt.get_frml(i) != dptr->symt.get_frml(i)){
-                    std::string msg = "Argument ";
-                    msg += std::to_string(i) + " is an incorrect type.";
-                    throw DwislpyError {where(), msg};
-                }
-            }
-            return dptr->rety;
-        }
-    }
-    type = Type {NoneTy {}};
+    type = chck_call(name,params,where(),defs,symt)->rety;
     return type;
 }
@@ -44,6 +44,8 @@
 #include <vector>
 #include <memory>
 #include <unordered_map>
+#include <atomic>
+#include <mutex>
 
 // * * * * *
 //
@@ -165,12 +167,47 @@ typedef std::variant<Void,VoidOr,Type> Rtns;
 // 3rd, etc parameter's information. The method `get_frmls_size` tells you
 // how many formal parameters are stored in a symbol table.
 //
+// Each variable is also given a symbol, a `Symb`, when it is added. This
+// is a dense integer ID that indexes the `SymInfo` records of all the
+// symbol tables. The IR names its operands by these (see
+// `dwislpy-inst.hh`), and so looking up a variable's frame offset,
+// register, or type while compiling is an array access rather than the
+// hashing of its name. The checker and the translation to IR, which
+// work from the names in the source, find a variable's symbol with
+// `get_symb`.
+//
+// The `def`s are compiled in parallel (see `dwislpy-jobs.hh`), each
+// adding temporaries to its own table, so the records are kept in
+// chunks that never move. Adding one takes the next ID atomically, and
+// looking one up takes no lock.
+//
+// Labels are also made by each table for itself. Each table's labels
+// have their own prefix (see `set_labl_prefix`), so the labels of one
+// function don't depend on the order the others were compiled in.
+// Their IDs (see `Labl`) do, so nothing output is ordered by those.
+//
+// The string constants of a program are instead kept by the global
+// symbol table, in a `StrgPool` shared with the table of each function
+// (see `set_pool`), so that a string used in many places is output
+// once. A table with no pool keeps its own, in `strings`, as does
+// `add_buff` for data that mustn't be shared.
+//
 
 enum SymKind { FRML, LOCL, TEMP };
 
+// When compiling, each variable also gets a slot in the stack frame
+// of its function and, if the register allocator finds room for it, a
+// MIPS register that holds its value instead of that slot. An empty
+// `reg` means the variable lives in its frame slot.
+//
+
 //
 // class SymInfo - struct of the variable information stored 
 //
+// Temporaries are named `temp_` followed by their `identifier`. Their
+// names are only needed to dump the IR, and so they're made when asked
+// for by `Symb::name` rather than kept here.
+//
 class SymInfo {
 public:
     std::string name;
@@ -178,82 +215,202 @@ public:
     Type type;
     SymKind kind;
     int frame_offset;
-    SymInfo(std::string nm, Type ty, int id, SymKind kd) :
-        name {nm}, identifier {id}, type {ty}, kind {kd} {}
+    std::string reg;
+    int table;         // The `SymT` it was added to (see `SymT::has_info`).
+    SymInfo(std::string nm, Type ty, int id, SymKind kd, int tb) :
+        name {nm}, identifier {id}, type {ty}, kind {kd}, frame_offset {0},
+        reg {}, table {tb} {}
 };
 
 class SymT;
-typedef std::shared_ptr<SymInfo> SymInfo_ptr;
+typedef SymInfo* SymInfo_ptr;
 typedef std::shared_ptr<SymT> SymT_ptr;
 
+//
+// class Symb - a variable's symbol.
+//
+// An empty symbol (as made by `Symb {}`) stands for no variable. A
+// symbol can be output, giving the name of its variable.
+//
+class Symb {
+public:
+    int id;
+    Symb(void) : id {-1} { }
+    explicit Symb(int i) : id {i} { }
+    bool empty(void) const { return id < 0; }
+    bool operator==(Symb other) const { return id == other.id; }
+    bool operator!=(Symb other) const { return id != other.id; }
+    bool operator<(Symb other) const { return id < other.id; }
+    std::string name(void) const;
+};
+
+std::ostream& operator<<(std::ostream& os, Symb sym);
+
+namespace std {
+    template <> struct hash<Symb> {
+        size_t operator()(Symb sym) const { return sym.id; }
+    };
+}
+
+//
+// class Labl - a label.
+//
+// Labels are interned: `Labl::of` gives each distinct name a dense
+// integer ID the first time it's asked for, and the same ID after
+// that. The IR names its labels by these (see `dwislpy-inst.hh`), so
+// comparing two labels, or keeping one in a map, doesn't touch its
+// characters. An empty label (as made by `Labl {}`) stands for none.
+// A label can be output, giving its name.
+//
+// The names are kept in chunks that never move, like the `SymInfo`
+// records, so `name` takes no lock. Interning a name takes one.
+// `rename` gives a label a new name, keeping its ID. It must not be
+// done while another thread might be reading that name.
+//
+class Labl {
+public:
+    int id;
+    Labl(void) : id {-1} { }
+    explicit Labl(int i) : id {i} { }
+    static Labl of(const std::string& nm);
+    bool empty(void) const { return id < 0; }
+    bool operator==(Labl other) const { return id == other.id; }
+    bool operator!=(Labl other) const { return id != other.id; }
+    const std::string& name(void) const;
+    void rename(const std::string& nm);
+};
+
+std::ostream& operator<<(std::ostream& os, Labl lbl);
+
+namespace std {
+    template <> struct hash<Labl> {
+        size_t operator()(Labl lbl) const { return lbl.id; }
+    };
+}
+
+//
+// class StrgPool - the string constants of a whole program.
+//
+// Each distinct string is kept once, under a label made from a hash of
+// its characters. The label of a string doesn't depend on which
+// function added it first, nor when, and so the code translated on
+// each thread (see `dwislpy-jobs.hh`) is the same whatever the order.
+// Adding a string takes a lock. Should two strings have the same hash,
+// `add` gives all but the first a suffix, `_1`, `_2`, and so on, just
+// so that their labels differ. Which came first depends on the
+// threads, and so once every string is in, `settle` hands these labels
+// out again in the order of the strings themselves.
+//
+// A string that ends another needn't be output on its own. The
+// `layout` of the pool gives the strings that must be output, each
+// along with the labels that point into it: the string's own at
+// offset 0, and those of its suffixes at their offsets. So "None" and
+// "\n" might label the tails of "is None\n".
+//
+// * add(strg)  - the label of `strg`, adding it if it's new.
+// * settle()   - relabels the strings whose hashes collide.
+// * labels     - the label of each string.
+// * layout()   - the strings to output, each with the labels within
+//                it in order of their offsets.
+//
+class StrgData {
+public:
+    std::string strg;
+    std::vector<std::pair<unsigned int,std::string>> lbls; // Offset, label.
+};
+
+class StrgPool {
+public:
+    std::unordered_map<std::string,std::string> labels;
+    StrgPool(void) : labels {}, strings {}, collided {}, lock {} { }
+    std::string add(const std::string& strg);
+    void settle(void);
+    std::vector<StrgData> layout(void) const;
+private:
+    std::unordered_map<std::string,std::string> strings; // Label's string.
+    std::unordered_map<std::string,std::vector<std::string>> collided; // Hash label's strings.
+    std::mutex lock;
+};
+
+typedef std::shared_ptr<StrgPool> StrgPool_ptr;
+
 //
 // class SymT - convenient cover to a dictionary of Name-SymInfo_ptr pairs.
 //
 class SymT {
 public:
     std::unordered_map<std::string, std::string> strings;
-    SymT() : sym_table {}, formals {}, globals {nullptr} { }
-    std::string add_frml(std::string nm, Type ty) {
-        sym_table[nm] = SymInfo_ptr{ new SymInfo {nm, ty, 0, FRML} };
-        formals.push_back(nm);
-        return nm;
-    }
-    std::string add_locl(std::string nm, Type ty) {
-        sym_table[nm] = SymInfo_ptr{ new SymInfo {nm, ty, sym_id++, LOCL} };
-        locals.push_back(nm);
-        return nm;
-    }
-    std::string add_temp(std::string nm, Type ty) {
-        sym_table[nm] = SymInfo_ptr{ new SymInfo {nm, ty, sym_id++, TEMP} };
-        locals.push_back(nm);
-        return nm;
-    }
-    std::string add_temp(Type ty) {
-        int id = sym_id++;
-        std::string nm = "temp_" + std::to_string(id);
-        sym_table[nm] = SymInfo_ptr{ new SymInfo {nm, ty, id, TEMP} };
-        locals.push_back(nm);
-        return nm;
-    }
-    void set_parent(SymT_ptr p) {
-        globals = p;
-    }               
-    std::string add_labl(std::string nm) {
-        if (globals == nullptr) {
-            return nm;
-        } else {
-            return globals->add_labl(nm);
-        }
+    SymT() : names {}, formals {}, labl_prefix {"L_"}, table {next_table++},
+             pool {} { }
+    Symb add_frml(std::string nm, Type ty) {
+        Symb sym = add_symb(nm, ty, 0, FRML);
+        formals.push_back(sym);
+        return sym;
     }
-    std::string add_labl() {
-        if (globals == nullptr) {
-            int id = sym_id++;
-            std::string nm = "L_" + std::to_string(id);
-            return add_labl(nm);
-        } else {
-            return globals->add_labl();
-        }
+    Symb add_locl(std::string nm, Type ty) {
+        Symb sym = add_symb(nm, ty, sym_id++, LOCL);
+        locals.push_back(sym);
+        return sym;
+    }
+    Symb add_temp(std::string nm, Type ty) {
+        Symb sym = add_symb(nm, ty, sym_id++, TEMP);
+        locals.push_back(sym);
+        return sym;
+    }
+    Symb add_temp(Type ty) {
+        Symb sym = new_info(SymInfo {"", ty, sym_id++, TEMP, table});
+        locals.push_back(sym);
+        return sym;
+    }
+    void set_labl_prefix(std::string pf) {
+        labl_prefix = pf;
     }
-    std::string add_strg(std::string strg) {
-        if (globals == nullptr) {
-            std::string labl = this->add_labl();
-            strings[labl] = strg;
-            return labl;
-        } else {
-            return globals->add_strg(strg);
+    Labl add_labl(std::string nm) {
+        return Labl::of(nm);
+    }
+    Labl add_labl() {
+        return Labl::of(labl_prefix + std::to_string(labl_id++));
+    }
+    void set_pool(StrgPool_ptr pl) {
+        pool = pl;
+    }
+    StrgPool_ptr get_pool(void) const {
+        return pool;
+    }
+    Labl add_strg(std::string strg) {
+        if (pool) {
+            return Labl::of(pool->add(strg));
         }
+        return add_buff(strg);
+    }
+    Labl add_buff(std::string strg) {
+        Labl labl = add_labl();
+        strings[labl.name()] = strg;
+        return labl;
+    }
+    bool has_info(const std::string& nm) const {
+        return (names.count(nm) > 0);
+    }
+    bool has_info(Symb sym) const {
+        return !sym.empty() && info_of(sym).table == table;
     }
-    bool has_info(std::string nm) const {
-        return (sym_table.count(nm) > 0);
+    Symb get_symb(const std::string& nm) const {
+        return names.at(nm);
     }
-    SymInfo_ptr get_info(std::string nm) const {
-        return sym_table.at(nm);
+    SymInfo_ptr get_info(const std::string& nm) const {
+        return get_info(names.at(nm));
+    }
+    SymInfo_ptr get_info(Symb sym) const {
+        return &info_of(sym);
     }
     SymInfo_ptr get_locl(int i) const {
-        return sym_table.at(locals[i]);
+        return get_info(locals[i]);
     }
     SymInfo_ptr get_frml(int i) const {
-        return sym_table.at(formals[i]);
+        return get_info(formals[i]);
+    }
+    Symb get_frml_symb(int i) const {
+        return formals[i];
     }
     unsigned int get_frmls_size(void) const {
         return formals.size();
@@ -261,25 +418,84 @@ public:
     unsigned int get_locls_size(void) const {
         return locals.size();
     }
-    void set_frame_offset(std::string nm, int offset) {
-        get_info(nm)->frame_offset = offset;
+    void set_frame_offset(Symb sym, int offset) {
+        get_info(sym)->frame_offset = offset;
     }
-    int get_frame_offset(std::string nm) const {
+    int get_frame_offset(Symb sym) const {
+        return get_info(sym)->frame_offset;
+    }
+    int get_frame_offset(const std::string& nm) const {
         return get_info(nm)->frame_offset;
     }
+    void set_reg(Symb sym, std::string rg) {
+        get_info(sym)->reg = rg;
+    }
+    const std::string& get_reg(Symb sym) const {
+        return get_info(sym)->reg;
+    }
+    void add_save(std::string rg) {
+        saves.push_back(rg);
+    }
+    std::string get_save(int i) const {
+        return saves[i];
+    }
+    unsigned int get_saves_size(void) const {
+        return saves.size();
+    }
+    void set_leaf(bool lf) {
+        leaf = lf;
+    }
+    bool is_leaf(void) const {
+        return leaf;
+    }
     void set_frame_size(int sz) {
         frame_size = sz;
     }
     int get_frame_size(void) const {
         return frame_size;
     }
+    static std::string name_of(Symb sym);
 private:
-    std::unordered_map<std::string, SymInfo_ptr> sym_table;
-    std::vector<std::string> formals;
-    std::vector<std::string> locals;
-    SymT_ptr globals;
+    Symb add_symb(std::string nm, Type ty, int id, SymKind kd) {
+        auto known = names.find(nm);
+        if (known != names.end()) {
+            // Re-declared, so the name's symbol now has this info.
+            SymInfo& info = info_of(known->second);
+            info.identifier = id;
+            info.type = ty;
+            info.kind = kd;
+            return known->second;
+        }
+        Symb sym = new_info(SymInfo {nm, ty, id, kd, table});
+        names[nm] = sym;
+        return sym;
+    }
+    std::unordered_map<std::string, Symb> names;
+    std::vector<Symb> formals;
+    std::vector<Symb> locals;
+    std::vector<std::string> saves; // Callee-saved registers used.
+    std::string labl_prefix;
+    int table;
     int sym_id = 0;
+    int labl_id = 0;
     int frame_size;
+    bool leaf = false; // Makes no calls, so needn't save $ra.
+    StrgPool_ptr pool; // The program's string constants, if shared.
+    //
+    // The records of every table, indexed by `Symb::id`, in chunks of
+    // INFO_CHUNK.
+    //
+    static const int INFO_CHUNK_BITS = 12;
+    static const int INFO_CHUNK = 1 << INFO_CHUNK_BITS;
+    static const int INFO_CHUNKS = 1 << 16;
+    static std::atomic<SymInfo*> info_chunks[INFO_CHUNKS];
+    static std::atomic<int> info_count;
+    static std::atomic<int> next_table;
+    static Symb new_info(const SymInfo& info);
+    static SymInfo& info_of(Symb sym) {
+        SymInfo* chunk = info_chunks[sym.id >> INFO_CHUNK_BITS].load(std::memory_order_acquire);
+        return chunk[sym.id & (INFO_CHUNK - 1)];
+    }
 };
 
 
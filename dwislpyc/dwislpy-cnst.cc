@@ -0,0 +1,294 @@
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <optional>
+#include <climits>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-cfg.hh"
+#include "dwislpy-opt.hh"
+
+//
+// dwislpy-cnst.cc
+//
+// Conditional constant propagation over the IR (see Wegman and Zadeck,
+// "Constant Propagation with Conditional Branches", TOPLAS 1991).
+//
+// The analysis runs over the blocks of the code's CFG, computing for
+// each block that might be executed the variables known to hold a
+// constant value on entry to it. A block is only considered once some
+// executed branch can reach it, and a branch whose outcome is known
+// only leads to the block it picks. This lets code guarded by constant
+// conditions drop out, and lets values assigned only on the paths that
+// can be taken stay known where those paths meet.
+//
+// The code is then rewritten: arithmetic and copies of known values
+// become SETs, branches with known outcomes become JMPs, and blocks
+// that can't be reached are deleted.
+//
+// Arithmetic is only folded when it would compute the same value at
+// run time. So sums, differences, and products that overflow a 32-bit
+// word are left alone (`add` and `sub` trap on overflow), as is any
+// division by zero.
+//
+
+//
+// Known values of variables. A variable without an entry isn't known.
+//
+typedef std::unordered_map<Symb,int> Cnst_map;
+
+static std::optional<int> value_of(const Cnst_map& known, Symb nm) {
+    auto kv = known.find(nm);
+    if (kv == known.end()) {
+        return std::nullopt;
+    }
+    return kv->second;
+}
+
+//
+// fold_immediate(inst,known)
+//
+// The value computed by an instruction with an immediate operand (see
+// `dwislpy-lowr.cc`) when its other operand is known.
+//
+static std::optional<int> fold_immediate(const INST& inst, const Cnst_map& known) {
+    std::optional<int> v1 = value_of(known,*inst.srcs()[0]);
+    if (!v1) {
+        return std::nullopt;
+    }
+    long long x = *v1;
+    long long v;
+    if (const ADDI* addi = inst.as<ADDI>()) {
+        v = x + addi->val;
+    } else if (const ADDIU* addiu = inst.as<ADDIU>()) {
+        v = (int)(unsigned int)(x + addiu->val);
+    } else if (const SLTI* slti = inst.as<SLTI>()) {
+        v = x < slti->val;
+    } else if (const MULP* mulp = inst.as<MULP>()) {
+        v = x * (1LL << mulp->val);
+    } else if (const DIVP* divp = inst.as<DIVP>()) {
+        v = x / (1LL << divp->val);
+    } else if (const MODP* modp = inst.as<MODP>()) {
+        v = x % (1LL << modp->val);
+    } else {
+        return std::nullopt;
+    }
+    if (v < INT_MIN || v > INT_MAX) {
+        return std::nullopt;
+    }
+    return (int)v;
+}
+//
+// fold(inst,known)
+//
+// The value computed by an arithmetic or boolean instruction with known
+// operands, if it can be folded.
+//
+static std::optional<int> fold(const INST& inst, const Cnst_map& known) {
+    Opnds srcs = inst.srcs();
+    if (const NOT* nt = inst.as<NOT>()) {
+        std::optional<int> v = value_of(known,nt->src);
+        if (v) {
+            return *v ^ 1;
+        }
+        return std::nullopt;
+    }
+    if (srcs.size() == 1) {
+        return fold_immediate(inst,known);
+    }
+    if (srcs.size() != 2) {
+        return std::nullopt;
+    }
+    std::optional<int> v1 = value_of(known,*srcs[0]);
+    std::optional<int> v2 = value_of(known,*srcs[1]);
+    if (!v1 || !v2) {
+        return std::nullopt;
+    }
+    long long x = *v1;
+    long long y = *v2;
+    long long v;
+    if (inst.as<ADD>()) {
+        v = x + y;
+    } else if (inst.as<SUB>()) {
+        v = x - y;
+    } else if (inst.as<MUL>()) {
+        v = x * y;
+    } else if (inst.as<DIV>() && y != 0) {
+        v = x / y;
+    } else if (inst.as<MOD>() && y != 0) {
+        v = x % y;
+    } else if (inst.as<SLT>()) {
+        v = x < y;
+    } else if (inst.as<SLE>()) {
+        v = x <= y;
+    } else if (inst.as<SEQ>()) {
+        v = x == y;
+    } else if (inst.as<AND>()) {
+        v = x & y;
+    } else if (inst.as<OR>()) {
+        v = x | y;
+    } else {
+        return std::nullopt;
+    }
+    if (v < INT_MIN || v > INT_MAX) {
+        return std::nullopt;
+    }
+    return (int)v;
+}
+
+//
+// compare(cndn,x,y)
+//
+// The outcome of a BCN or BCZ branch condition.
+//
+static bool compare(Cndn cndn, int x, int y) {
+    switch (cndn) {
+    case Cndn::LT: case Cndn::LTZ: return x < y;
+    case Cndn::LE: case Cndn::LEZ: return x <= y;
+    case Cndn::GT: case Cndn::GTZ: return x > y;
+    case Cndn::GE: case Cndn::GEZ: return x >= y;
+    case Cndn::EQ: case Cndn::EQZ: return x == y;
+    default:                       return x != y;
+    }
+}
+
+//
+// outcome(inst,known)
+//
+// The label a BCN or BCZ branch will definitely take, if known. This
+// is empty if the branch will fall through.
+//
+static std::optional<Labl> outcome(const INST& inst, const Cnst_map& known) {
+    if (const BCN* bcn = inst.as<BCN>()) {
+        std::optional<int> v1 = value_of(known,bcn->src1);
+        std::optional<int> v2 = value_of(known,bcn->src2);
+        if (v1 && v2) {
+            return compare(bcn->cndn,*v1,*v2) ? bcn->lblt : bcn->lblf;
+        }
+    }
+    if (const BCZ* bcz = inst.as<BCZ>()) {
+        std::optional<int> v = value_of(known,bcz->src);
+        if (v) {
+            return compare(bcz->cndn,*v,0) ? bcz->lblt : bcz->lblf;
+        }
+    }
+    return std::nullopt;
+}
+
+//
+// step(inst,known)
+//
+// Update the known values according to the effect of `inst`.
+//
+static void step(const INST& inst, Cnst_map& known) {
+    std::optional<int> v = std::nullopt;
+    if (const SET* set = inst.as<SET>()) {
+        v = set->val;
+    } else if (const MOV* mov = inst.as<MOV>()) {
+        v = value_of(known,mov->src);
+    } else {
+        v = fold(inst,known);
+    }
+    for (Symb* dst : inst.dsts()) {
+        if (v) {
+            known[*dst] = *v;
+        } else {
+            known.erase(*dst);
+        }
+    }
+}
+
+//
+// propagate_constants(symt,code)
+//
+void propagate_constants(SymT& symt, INST_vec& code) {
+    CFG cfg {code};
+    int size = cfg.blocks.size();
+
+    // Find the known values on entry to each executable block. They
+    // only ever shrink as more paths into a block are found.
+    //
+    std::vector<std::optional<Cnst_map>> entry(size);
+    entry[0] = Cnst_map {};
+    std::vector<int> work {0};
+    while (!work.empty()) {
+        int b = work.back();
+        work.pop_back();
+        Cnst_map known = *entry[b];
+        const BBlk& blk = cfg.blocks[b];
+        for (const INST& inst : blk.code) {
+            step(inst,known);
+        }
+
+        // Pass the values along each edge that might be taken.
+        //
+        std::vector<int> succs = blk.succs;
+        if (!blk.code.empty()) {
+            std::optional<Labl> lbl = outcome(blk.code.back(),known);
+            if (lbl) {
+                succs = {lbl->empty() ? blk.next : cfg.block_of(*lbl)};
+            }
+        }
+        for (int s : succs) {
+            if (!entry[s]) {
+                entry[s] = known;
+                work.push_back(s);
+                continue;
+            }
+            Cnst_map& meet = *entry[s];
+            bool changed = false;
+            for (auto kv = meet.begin(); kv != meet.end(); ) {
+                auto other = known.find(kv->first);
+                if (other == known.end() || other->second != kv->second) {
+                    kv = meet.erase(kv);
+                    changed = true;
+                } else {
+                    kv++;
+                }
+            }
+            if (changed) {
+                work.push_back(s);
+            }
+        }
+    }
+
+    // Rewrite each executable block.
+    //
+    for (int b = 0; b < size; b++) {
+        if (!entry[b]) {
+            continue;
+        }
+        Cnst_map known = *entry[b];
+        INST_vec rewritten {};
+        for (INST& inst : cfg.blocks[b].code) {
+            Opnds dsts = inst.dsts();
+            if (dsts.size() == 1 && !inst.as<SET>()) {
+                std::optional<int> v = std::nullopt;
+                if (MOV* mov = inst.as<MOV>()) {
+                    v = value_of(known,mov->src);
+                } else {
+                    v = fold(inst,known);
+                }
+                if (v) {
+                    inst = SET {*dsts[0],*v};
+                }
+            }
+            std::optional<Labl> lbl = outcome(inst,known);
+            if (lbl && lbl->empty()) {
+                continue;
+            }
+            if (lbl) {
+                inst = JMP {*lbl};
+            }
+            step(inst,known);
+            rewritten.push_back(inst);
+        }
+        cfg.blocks[b].code = rewritten;
+    }
+
+    // Drop the blocks that can no longer be reached.
+    //
+    cfg.link();
+    cfg.prune();
+    code = cfg.linearize(symt);
+}
@@ -0,0 +1,131 @@
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <optional>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-cfg.hh"
+#include "dwislpy-opt.hh"
+
+//
+// dwislpy-copy.cc
+//
+// Copy propagation over the IR.
+//
+// The translation leaves many MOVs of a variable into a fresh temporary
+// that is then read in its place, as in
+//
+//     MOV temp_5,x
+//     ADD x,temp_5,temp_6
+//
+// After a MOV d,s, and until either d or s is written again, any read
+// of d can read s instead. The copies that hold on entry to each block
+// are found by a forward dataflow analysis over the CFG, keeping only
+// those copies that hold along every path into the block. The reads
+// are then rewritten, leaving the MOV itself dead for `remove_dead_code`
+// to clean up.
+//
+
+//
+// The copies in effect, mapping each copied-to variable to its source.
+//
+typedef std::unordered_map<Symb,Symb> Copy_map;
+
+//
+// step(inst,copies)
+//
+// Update the copies in effect according to the effect of `inst`.
+//
+static void step(INST& inst, Copy_map& copies) {
+    for (Symb* dst : inst.dsts()) {
+        copies.erase(*dst);
+        for (auto cp = copies.begin(); cp != copies.end(); ) {
+            if (cp->second == *dst) {
+                cp = copies.erase(cp);
+            } else {
+                cp++;
+            }
+        }
+    }
+    if (MOV* mov = inst.as<MOV>()) {
+        // Record the copy's original source, so that chains of copies
+        // across blocks collapse just as they do within one.
+        Symb src = mov->src;
+        auto cp = copies.find(src);
+        if (cp != copies.end()) {
+            src = cp->second;
+        }
+        if (mov->dst != src) {
+            copies[mov->dst] = src;
+        }
+    }
+}
+
+//
+// propagate_copies(symt,code)
+//
+void propagate_copies(SymT& symt, INST_vec& code) {
+    CFG cfg {code};
+    std::vector<int> order = cfg.rpo();
+
+    // Find the copies in effect on entry to each block. A block that
+    // hasn't been reached yet places no constraint on its successors.
+    //
+    std::vector<std::optional<Copy_map>> entry(cfg.blocks.size());
+    entry[0] = Copy_map {};
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int b : order) {
+            if (!entry[b]) {
+                continue;
+            }
+            Copy_map copies = *entry[b];
+            for (INST& inst : cfg.blocks[b].code) {
+                step(inst,copies);
+            }
+            for (int s : cfg.blocks[b].succs) {
+                if (!entry[s]) {
+                    entry[s] = copies;
+                    changed = true;
+                    continue;
+                }
+                Copy_map& meet = *entry[s];
+                for (auto cp = meet.begin(); cp != meet.end(); ) {
+                    auto other = copies.find(cp->first);
+                    if (other == copies.end() || other->second != cp->second) {
+                        cp = meet.erase(cp);
+                        changed = true;
+                    } else {
+                        cp++;
+                    }
+                }
+            }
+        }
+    }
+
+    // Rewrite the reads of copies, and drop any MOV of a variable to
+    // itself that results.
+    //
+    for (int b : order) {
+        Copy_map copies = *entry[b];
+        INST_vec rewritten {};
+        for (INST& inst : cfg.blocks[b].code) {
+            for (Symb* src : inst.srcs()) {
+                auto cp = copies.find(*src);
+                if (cp != copies.end()) {
+                    *src = cp->second;
+                }
+            }
+            MOV* mov = inst.as<MOV>();
+            if (mov && mov->dst == mov->src) {
+                continue;
+            }
+            step(inst,copies);
+            rewritten.push_back(inst);
+        }
+        cfg.blocks[b].code = rewritten;
+    }
+
+    code = cfg.linearize(symt);
+}
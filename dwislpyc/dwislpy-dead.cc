@@ -0,0 +1,116 @@
+#include <vector>
+#include <string>
+#include <unordered_set>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-cfg.hh"
+#include "dwislpy-opt.hh"
+
+//
+// dwislpy-dead.cc
+//
+// Dead code elimination over the IR.
+//
+// An instruction is dead if all it does is write a variable whose value
+// is never read afterwards. The variables live on exit from each block
+// are found by a backward dataflow analysis over the CFG. Each block is
+// then scanned backwards, dropping its dead instructions, which can in
+// turn leave the instructions that computed their sources dead. Since
+// that can change what's live on exit from other blocks, the whole
+// thing is repeated until nothing more is dropped.
+//
+// Only instructions without side effects are considered: SET, STL, MOV,
+// ADD, SUB, MUL, the set-on-condition instructions, the immediate forms,
+// and RTV. A DIV or MOD is kept in case it divides by
+// zero, and GTI is kept since it consumes input.
+//
+
+typedef std::unordered_set<Symb> Name_set;
+
+static bool is_pure(const INST& inst) {
+    return inst.as<SET>() || inst.as<STL>()
+        || inst.as<MOV>() || inst.as<ADD>()
+        || inst.as<SUB>() || inst.as<MUL>()
+        || inst.as<SLT>() || inst.as<SLE>()
+        || inst.as<SEQ>() || inst.as<AND>()
+        || inst.as<OR>() || inst.as<NOT>()
+        || inst.as<ADDI>() || inst.as<ADDIU>()
+        || inst.as<SLTI>() || inst.as<MULP>()
+        || inst.as<DIVP>() || inst.as<MODP>()
+        || inst.as<RTV>();
+}
+
+//
+// step(inst,live)
+//
+// Update the live variables backwards across `inst`.
+//
+static void step(INST& inst, Name_set& live) {
+    for (Symb* dst : inst.dsts()) {
+        live.erase(*dst);
+    }
+    for (Symb* src : inst.srcs()) {
+        live.insert(*src);
+    }
+}
+
+//
+// remove_dead_code(symt,code)
+//
+void remove_dead_code(SymT& symt, INST_vec& code) {
+    CFG cfg {code};
+    int size = cfg.blocks.size();
+    std::vector<int> order = cfg.rpo();
+
+    bool removed = true;
+    while (removed) {
+        removed = false;
+
+        // Find the variables live on entry to each block, visiting the
+        // blocks in postorder so that most successors come first.
+        //
+        std::vector<Name_set> live_in(size);
+        bool changed = true;
+        while (changed) {
+            changed = false;
+            for (auto b = order.rbegin(); b != order.rend(); b++) {
+                Name_set live {};
+                for (int s : cfg.blocks[*b].succs) {
+                    live.insert(live_in[s].begin(),live_in[s].end());
+                }
+                INST_vec& blk_code = cfg.blocks[*b].code;
+                for (auto inst = blk_code.rbegin(); inst != blk_code.rend(); inst++) {
+                    step(*inst,live);
+                }
+                if (live.size() != live_in[*b].size()) {
+                    live_in[*b] = live;
+                    changed = true;
+                }
+            }
+        }
+
+        // Drop the dead instructions of each block.
+        //
+        for (int b : order) {
+            Name_set live {};
+            for (int s : cfg.blocks[b].succs) {
+                live.insert(live_in[s].begin(),live_in[s].end());
+            }
+            INST_vec& blk_code = cfg.blocks[b].code;
+            INST_vec kept {};
+            for (auto inst = blk_code.rbegin(); inst != blk_code.rend(); inst++) {
+                Opnds dsts = inst->dsts();
+                if (is_pure(*inst) && dsts.size() == 1
+                    && live.count(*dsts[0]) == 0) {
+                    removed = true;
+                    continue;
+                }
+                step(*inst,live);
+                kept.push_back(*inst);
+            }
+            blk_code = INST_vec {kept.rbegin(),kept.rend()};
+        }
+    }
+
+    code = cfg.linearize(symt);
+}
@@ -0,0 +1,45 @@
+#include <string>
+#include <iostream>
+#include "dwislpy-emit.hh"
+
+//
+// dwislpy-emit.cc
+//
+// The assembly writer. See `dwislpy-emit.hh`.
+//
+
+//
+// AsmOut::operator<<(n)
+//
+// Append the decimal digits of `n`, built from the right in a small
+// array. The magnitude is taken as unsigned so that the most negative
+// `int` is handled too.
+//
+AsmOut& AsmOut::operator<<(int n) {
+    char digits[12];
+    char* end = digits + sizeof(digits);
+    char* start = end;
+    unsigned int mag = n < 0 ? 0u - (unsigned int)n : (unsigned int)n;
+    do {
+        *--start = '0' + mag % 10;
+        mag /= 10;
+    } while (mag > 0);
+    if (n < 0) {
+        *--start = '-';
+    }
+    buffer.append(start, end - start);
+    return check();
+}
+
+//
+// AsmOut::flush()
+//
+// Write what's been buffered to the stream. Does nothing if the
+// assembly is being kept in memory.
+//
+void AsmOut::flush(void) {
+    if (sink != nullptr && !buffer.empty()) {
+        sink->write(buffer.data(), buffer.size());
+        buffer.clear();
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef _DWISLPY_EMIT_HH
+#define _DWISLPY_EMIT_HH
+
+//
+// dwislpy-emit.hh
+//
+// The writer of the assembly that the compiler outputs (see
+// `dwislpy-mips.cc`).
+//
+// An `AsmOut` gathers what's written to it in a large buffer. It
+// either hands that buffer to a `std::ostream` whenever it fills, and
+// when `flush` is called, or it keeps all of the assembly in memory
+// so that it can be given, as `text`, to an assembler in the same
+// process. Either way, the stream sees a few large writes rather than
+// a flush on every line as `std::endl` would give. Lines are ended by
+// writing `'\n'`.
+//
+// Integers are formatted by hand rather than through the locale
+// machinery of `std::ostream`.
+//
+
+#include <string>
+#include <iostream>
+
+//
+// class AsmOut
+//
+// * AsmOut(os) - writes through to `os` in chunks of `BUFFER_SIZE`.
+// * AsmOut()   - keeps everything written to it.
+//
+// * os << x  - append a string, character, or integer.
+// * flush()  - hand what's been buffered to the stream, if any.
+// * text()   - everything that's been written and not flushed.
+//
+class AsmOut {
+public:
+    static const size_t BUFFER_SIZE = 1 << 20;
+    AsmOut(std::ostream& os) : sink {&os}, buffer {} {
+        buffer.reserve(BUFFER_SIZE + 256);
+    }
+    AsmOut(void) : sink {nullptr}, buffer {} { }
+    ~AsmOut(void) { flush(); }
+    AsmOut(const AsmOut&) = delete;
+    AsmOut& operator=(const AsmOut&) = delete;
+    //
+    AsmOut& operator<<(const std::string& s) {
+        buffer.append(s);
+        return check();
+    }
+    AsmOut& operator<<(const char* s) {
+        buffer.append(s);
+        return check();
+    }
+    AsmOut& operator<<(char c) {
+        buffer.push_back(c);
+        return check();
+    }
+    AsmOut& operator<<(int n);
+    //
+    void flush(void);
+    const std::string& text(void) const { return buffer; }
+private:
+    std::ostream* sink;  // Null if kept in memory.
+    std::string buffer;
+    AsmOut& check(void) {
+        if (sink != nullptr && buffer.size() >= BUFFER_SIZE) {
+            flush();
+        }
+        return *this;
+    }
+};
+
+#endif
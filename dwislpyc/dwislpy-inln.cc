@@ -0,0 +1,268 @@
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <functional>
+#include "dwislpy-ast.hh"
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-opt.hh"
+
+//
+// dwislpy-inln.cc
+//
+// Inlining of calls to small `def`s.
+//
+// Each call is translated as a run of ARGs, a CLL, and (for functions)
+// an RTV, and it costs the callee's ENTER and LEAVE besides. This pass
+// replaces such a call with a copy of the callee's code:
+//
+//     ARG i,s  ->  MOV f_i,s        (f_i a fresh temporary for formal i)
+//     ENTER    ->  (dropped)
+//     RTN s    ->  MOV r,s          (r a fresh temporary for the result)
+//     LEAVE    ->  (dropped)
+//     RTV d    ->  MOV d,r
+//
+// Every variable of the callee, and every label of its code, is renamed
+// to a fresh one of the caller, so the callee's locals take up frame
+// slots (or registers) of the caller, and the same callee can be inlined
+// more than once. The copied body is then optimized along with the rest
+// of the caller, e.g. with the caller's constants as its arguments.
+//
+// A call is inlined if the callee is small, or if it's the callee's only
+// call anywhere in the program and the callee isn't too large. Calls to
+// a `def` that can call itself, directly or through other `def`s, are
+// never inlined. The `def`s are visited callees first, so that inlining
+// into a caller copies the callee's code with its own calls inlined.
+//
+
+//
+// Limits on the size of an inlined callee, counting its instructions
+// other than labels, NOPs, ENTER, and LEAVE.
+//
+static const int INLINE_SIZE = 24;
+static const int INLINE_ONCE_SIZE = 120;
+
+static int size_of(const INST_vec& code) {
+    int size = 0;
+    for (const INST& inst : code) {
+        if (!inst.as<LBL>() && !inst.as<NOP>()
+            && !inst.as<ENTER>() && !inst.as<LEAVE>()) {
+            size++;
+        }
+    }
+    return size;
+}
+
+//
+// callees(code)
+//
+// The labels called by `code`, once for each call.
+//
+static std::vector<std::string> callees(const INST_vec& code) {
+    std::vector<std::string> lbls {};
+    for (const INST& inst : code) {
+        if (const CLL* cll = inst.as<CLL>()) {
+            lbls.push_back(cll->lbl.name());
+        }
+    }
+    return lbls;
+}
+
+//
+// relabel(inst,lbls)
+//
+// Rename the labels defined or jumped to by `inst`.
+//
+static void relabel(INST& inst, const std::unordered_map<Labl,Labl>& lbls) {
+    auto rename = [&lbls](Labl& lbl) {
+        auto nl = lbls.find(lbl);
+        if (nl != lbls.end()) {
+            lbl = nl->second;
+        }
+    };
+    if (LBL* lbl = inst.as<LBL>()) {
+        rename(lbl->lbl);
+    } else if (JMP* jmp = inst.as<JMP>()) {
+        rename(jmp->lbl);
+    } else if (BCN* bcn = inst.as<BCN>()) {
+        rename(bcn->lblt);
+        rename(bcn->lblf);
+    } else if (BCZ* bcz = inst.as<BCZ>()) {
+        rename(bcz->lblt);
+        rename(bcz->lblf);
+    }
+}
+
+//
+// expand(defn,args,symt,code)
+//
+// Add to `code` a copy of the code of `defn` called with the arguments
+// `args`, renamed to use fresh variables and labels of `symt`. Gives
+// the temporary holding the value returned.
+//
+static Symb expand(const Defn& defn, const std::vector<Symb>& args,
+                          SymT& symt, INST_vec& code) {
+    std::unordered_map<Symb,Symb> names {};
+    auto rename = [&](Symb& nm) {
+        if (names.count(nm) == 0 && defn.symt.has_info(nm)) {
+            names[nm] = symt.add_temp(defn.symt.get_info(nm)->type);
+        }
+        if (names.count(nm) > 0) {
+            nm = names[nm];
+        }
+    };
+    std::unordered_map<Labl,Labl> lbls {};
+    for (const INST& inst : defn.code) {
+        if (const LBL* lbl = inst.as<LBL>()) {
+            lbls[lbl->lbl] = symt.add_labl();
+        }
+    }
+
+    for (unsigned int i = 0; i < args.size(); i++) {
+        Symb frml = defn.symt.get_frml_symb(i);
+        rename(frml);
+        code.push_back(MOV {frml,args[i]});
+    }
+    Symb rslt = symt.add_temp(defn.rety);
+    for (const INST& inst : defn.code) {
+        if (inst.as<ENTER>() || inst.as<LEAVE>()) {
+            continue;
+        }
+        if (const RTN* rtn = inst.as<RTN>()) {
+            Symb src = rtn->src;
+            rename(src);
+            code.push_back(MOV {rslt,src});
+            continue;
+        }
+        INST copy = inst;
+        for (Symb* src : copy.srcs()) {
+            rename(*src);
+        }
+        for (Symb* dst : copy.dsts()) {
+            rename(*dst);
+        }
+        relabel(copy,lbls);
+        code.push_back(copy);
+    }
+    return rslt;
+}
+
+//
+// inline_into(defs,inline_ok,symt,code)
+//
+// Inline the calls made by `code` to the `def`s picked by `inline_ok`.
+//
+static void inline_into(const Defs& defs,
+                        const std::unordered_set<std::string>& inline_ok,
+                        SymT& symt, INST_vec& code) {
+    INST_vec inlined {};
+    INST_vec pending {};
+    Symb rslt {};
+    for (INST& inst : code) {
+        if (inst.as<ARG>()) {
+            pending.push_back(inst);
+            continue;
+        }
+        CLL* cll = inst.as<CLL>();
+        if (cll && inline_ok.count(cll->lbl.name()) > 0) {
+            std::vector<Symb> args(pending.size());
+            for (INST& p : pending) {
+                ARG* arg = p.as<ARG>();
+                args[arg->idx] = arg->src;
+            }
+            pending.clear();
+            rslt = expand(*defs.at(cll->lbl.name()),args,symt,inlined);
+            continue;
+        }
+        inlined.insert(inlined.end(),pending.begin(),pending.end());
+        pending.clear();
+        RTV* rtv = inst.as<RTV>();
+        if (rtv && !rslt.empty()) {
+            inlined.push_back(MOV {rtv->dst,rslt});
+        } else {
+            inlined.push_back(inst);
+        }
+        rslt = Symb {};
+    }
+    inlined.insert(inlined.end(),pending.begin(),pending.end());
+    code = inlined;
+}
+
+//
+// inline_calls(defs,main_symt,main_code)
+//
+std::unordered_set<std::string> inline_calls(Defs& defs, SymT& main_symt,
+                                             INST_vec& main_code) {
+
+    // Count the calls to each `def` and find those that can reach a
+    // call to themselves.
+    //
+    std::unordered_map<std::string,int> calls {};
+    for (std::string lbl : callees(main_code)) {
+        calls[lbl]++;
+    }
+    for (std::pair<Name,Defn_ptr> dfpr : defs) {
+        for (std::string lbl : callees(dfpr.second->code)) {
+            calls[lbl]++;
+        }
+    }
+    std::unordered_set<std::string> recursive {};
+    for (std::pair<Name,Defn_ptr> dfpr : defs) {
+        std::unordered_set<std::string> seen {};
+        std::vector<std::string> work = callees(dfpr.second->code);
+        while (!work.empty()) {
+            std::string lbl = work.back();
+            work.pop_back();
+            if (lbl == dfpr.first) {
+                recursive.insert(lbl);
+                break;
+            }
+            if (defs.count(lbl) > 0 && seen.insert(lbl).second) {
+                for (std::string c : callees(defs.at(lbl)->code)) {
+                    work.push_back(c);
+                }
+            }
+        }
+    }
+
+    // Inline into each `def`, after inlining into the `def`s it calls.
+    //
+    std::unordered_set<std::string> inline_ok {};
+    std::unordered_set<std::string> visited {};
+    std::function<void(std::string)> visit = [&](std::string name) {
+        if (defs.count(name) == 0 || !visited.insert(name).second) {
+            return;
+        }
+        Defn_ptr defn = defs.at(name);
+        for (std::string lbl : callees(defn->code)) {
+            visit(lbl);
+        }
+        inline_into(defs,inline_ok,defn->symt,defn->code);
+        int size = size_of(defn->code);
+        if (recursive.count(name) == 0
+            && (size <= INLINE_SIZE
+                || (calls[name] == 1 && size <= INLINE_ONCE_SIZE))) {
+            inline_ok.insert(name);
+        }
+    };
+    for (std::pair<Name,Defn_ptr> dfpr : defs) {
+        visit(dfpr.first);
+    }
+    inline_into(defs,inline_ok,main_symt,main_code);
+
+    // Find the `def`s that are still called.
+    //
+    std::unordered_set<std::string> called {};
+    std::vector<std::string> work = callees(main_code);
+    while (!work.empty()) {
+        std::string lbl = work.back();
+        work.pop_back();
+        if (defs.count(lbl) > 0 && called.insert(lbl).second) {
+            for (std::string c : callees(defs.at(lbl)->code)) {
+                work.push_back(c);
+            }
+        }
+    }
+    return called;
+}
@@ -1,13 +1,15 @@
 #include "dwislpy-ast.hh"
 #include "dwislpy-inst.hh"
+#include "dwislpy-cfg.hh"
+#include "dwislpy-jobs.hh"
 
 //
 // dwislpy-inst.cc
 //
 // This gives the `trans` and the `trans_cndn` methods for all the
 // supported AST nodes. These methods convert the AST into a sequence
-// of IR instructions which are subclasses of class INST as defined in
-// `dwislpy-inst.hh`.
+// of IR instructions, each an INST holding one of the pseudo-
+// instructions defined in `dwislpy-inst.hh`.
 //
 
 //
@@ -15,52 +17,78 @@
 // the string constants needed for the translation. They are set
 // by `Prgm::trans`.
 //
-std::string EOLN_STRG_LBL; // Label for '\n'
-std::string TRUE_STRG_LBL; // Label for 'True'
-std::string FLSE_STRG_LBL; // Label for 'False'
-std::string NONE_STRG_LBL; // Label for 'None'
-std::string INPT_BUFF_LBL; // Label for the 80-character `input` buffer.
+Labl EOLN_STRG_LBL; // Label for '\n'
+Labl TRUE_LINE_LBL; // Label for 'True\n'
+Labl FLSE_LINE_LBL; // Label for 'False\n'
+Labl NONE_LINE_LBL; // Label for 'None\n'
+Labl INPT_BUFF_LBL; // Label for the 80-character `input` buffer.
 
 //
-// Prgm::trans(void)
+// Prgm::trans(jobs)
 //
 // Translate each of the definitions and the main script of the program
-// into their intermediate representation,
+// into their intermediate representation, on up to `jobs` threads.
+// Each makes its own labels, prefixed by its name, and adds its string
+// constants to the pool, labelled by their contents, so what one gets
+// doesn't depend on how the others were run.
 //
-void Prgm::trans(void) {
-    
-    // Make the global symbol table shared by all the program's IR.
+void Prgm::trans(int jobs) {
+
+    // Make the global symbol table shared by all the program's IR,
+    // along with the pool of string constants it keeps for them all.
     //
     glbl_symt_ptr = SymT_ptr { new SymT {} };
+    glbl_symt_ptr->set_pool(StrgPool_ptr { new StrgPool {} });
+    main_symt.set_pool(glbl_symt_ptr->get_pool());
 
-    // Create labels for the global string constants needed.
+    // Create labels for the global string constants needed. The input
+    // buffer is kept out of the pool, so no constant shares its bytes.
     //
     EOLN_STRG_LBL = glbl_symt_ptr->add_strg("\n"); 
-    TRUE_STRG_LBL = glbl_symt_ptr->add_strg("True"); 
-    FLSE_STRG_LBL = glbl_symt_ptr->add_strg("False"); 
-    NONE_STRG_LBL = glbl_symt_ptr->add_strg("None"); 
-    INPT_BUFF_LBL = glbl_symt_ptr->add_strg("12345678901234567890123456789012345678901234567890123456789012345678901234567890"); 
+    TRUE_LINE_LBL = glbl_symt_ptr->add_strg("True\n"); 
+    FLSE_LINE_LBL = glbl_symt_ptr->add_strg("False\n"); 
+    NONE_LINE_LBL = glbl_symt_ptr->add_strg("None\n"); 
+    INPT_BUFF_LBL = glbl_symt_ptr->add_buff("12345678901234567890123456789012345678901234567890123456789012345678901234567890"); 
 
-    // Translate each definition into IR.
+    // Translate each definition into IR, alongside the main script.
     // 
+    std::vector<Defn_ptr> defns {};
     for (std::pair<Name,Defn_ptr> dfpr : defs) {
         Defn_ptr defn = dfpr.second;
-        defn->symt.set_parent(glbl_symt_ptr); // Set parent to global table.
-        defn->trans();
+        defn->symt.set_labl_prefix("L_" + dfpr.first + "_");
+        defn->symt.set_pool(glbl_symt_ptr->get_pool());
+        defns.push_back(defn);
     }
-    
-    // Translate the main script into IR labelled as `main`
+    main_symt.set_labl_prefix("L_main_");
+    run_jobs(defns.size() + 1, jobs, [&](int i) {
+        if (i == 0) {
+            trans_main();
+        } else {
+            defns[i-1]->trans();
+        }
+    });
+
+    // Now that every string constant is in, relabel any whose hashes
+    // collide, so their labels don't depend on the threads.
     //
+    glbl_symt_ptr->get_pool()->settle();
+}
+
+//
+// Prgm::trans_main(void)
+//
+// Translate the main script into IR labelled as `main`.
+//
+void Prgm::trans_main(void) {
     main_code = INST_vec {};
-    main_symt.set_parent(glbl_symt_ptr);
-    std::string def_lbl = main_symt.add_labl("main");
-    std::string ext_lbl = main_symt.add_labl("main_done");
+    Labl def_lbl = main_symt.add_labl("main");
+    Labl ext_lbl = main_symt.add_labl("main_done");
     //
-    main_code.push_back(INST_ptr { new LBL {def_lbl} });
-    main_code.push_back(INST_ptr { new ENTER {} });
+    main_code.push_back(LBL {def_lbl});
+    main_code.push_back(ENTER {});
     main->trans(ext_lbl,main_symt,main_code); // Note: ext_lbl won't get used.
-    main_code.push_back(INST_ptr { new LBL {ext_lbl} });
-    main_code.push_back(INST_ptr { new LEAVE {} });
+    main_code.push_back(LBL {ext_lbl});
+    main_code.push_back(LEAVE {});
 }
 
 //
@@ -71,14 +99,34 @@ void Prgm::trans(void) {
 // can jump to its code to exit.
 //
 void Defn::trans(void) {
-    std::string def_lbl = symt.add_labl(name);
-    std::string ext_lbl = symt.add_labl(name+"_done");
+    Labl def_lbl = symt.add_labl(name);
+    Labl ext_lbl = symt.add_labl(name+"_done");
     //
-    code.push_back(INST_ptr { new LBL {def_lbl} });
-    code.push_back(INST_ptr { new ENTER {} });
+    code.push_back(LBL {def_lbl});
+    code.push_back(ENTER {});
     body->trans(ext_lbl,symt,code);
-    code.push_back(INST_ptr { new LBL {ext_lbl} });
-    code.push_back(INST_ptr { new LEAVE {} }); 
+    code.push_back(LBL {ext_lbl});
+    code.push_back(LEAVE {}); 
+}
+
+//
+// Prgm::dump_cfg(os)
+//
+// Translate the program into IR and output the control-flow graph of
+// the main script and of each definition. See `dwislpy-cfg.hh`.
+//
+void Prgm::dump_cfg(std::ostream& os) {
+    trans();
+    CFG main_cfg {main_code};
+    main_cfg.dominate();
+    os << "main:" << std::endl;
+    main_cfg.dump(os);
+    for (std::pair<Name,Defn_ptr> dfpr : defs) {
+        CFG defn_cfg {dfpr.second->code};
+        defn_cfg.dominate();
+        os << std::endl << dfpr.first << ":" << std::endl;
+        defn_cfg.dump(os);
+    }
 }
 
 //
@@ -90,7 +138,7 @@ void Defn::trans(void) {
 // The translation modifies `symt` and places new references to
 // IR instructions into `code`.
 //
-void Blck::trans(std::string exit, SymT& symt, INST_vec& code) {
+void Blck::trans(Labl exit, SymT& symt, INST_vec& code) {
     for (Stmt_ptr stmt: stmts) {
         stmt->trans(exit,symt,code);
     }
@@ -107,132 +155,157 @@ void Blck::trans(std::string exit, SymT& symt, INST_vec& code) {
 // IR instructions into `code`.
 //
 
-void Ntro::trans([[maybe_unused]]std::string exit,
+void Ntro::trans([[maybe_unused]]Labl exit,
                  SymT& symt, INST_vec& code) {
-    expn->trans(name,symt,code);
+    expn->trans(symt.get_symb(name),symt,code);
 }
 
-void Asgn::trans([[maybe_unused]]std::string exit,
+void Asgn::trans([[maybe_unused]]Labl exit,
                  SymT& symt, INST_vec& code) {
-    expn->trans(name,symt,code);
+    expn->trans(symt.get_symb(name),symt,code);
 }
 
-void PlEq::trans([[maybe_unused]]std::string exit,
+void PlEq::trans([[maybe_unused]]Labl exit,
                  SymT& symt, INST_vec& code) {
-    std::string srce1 = symt.add_temp(expn->type);
-    code.push_back(INST_ptr {new MOV {srce1,name}});
-    std::string srce2 = symt.add_temp(expn->type);
+    Symb var = symt.get_symb(name);
+    Symb srce1 = symt.add_temp(expn->type);
+    code.push_back(MOV {srce1,var});
+    Symb srce2 = symt.add_temp(expn->type);
     expn->trans(srce2,symt,code); 
-    code.push_back(INST_ptr {new ADD {name,srce1,srce2}});
+    code.push_back(ADD {var,srce1,srce2});
 }
 
-void MnEq::trans([[maybe_unused]]std::string exit,
+void MnEq::trans([[maybe_unused]]Labl exit,
                  SymT& symt, INST_vec& code) {
-    std::string srce1 = symt.add_temp(expn->type);
-    code.push_back(INST_ptr {new MOV {srce1,name}});
-    std::string srce2 = symt.add_temp(expn->type);
+    Symb var = symt.get_symb(name);
+    Symb srce1 = symt.add_temp(expn->type);
+    code.push_back(MOV {srce1,var});
+    Symb srce2 = symt.add_temp(expn->type);
     expn->trans(srce2,symt,code);
-    code.push_back(INST_ptr {new SUB {name,srce1,srce2}});
+    code.push_back(SUB {var,srce1,srce2});
 }
 
-void FRtn::trans(std::string exit, SymT& symt, INST_vec& code) {
-    std::string temp = symt.add_temp(expn->type);
+void FRtn::trans(Labl exit, SymT& symt, INST_vec& code) {
+    Symb temp = symt.add_temp(expn->type);
     expn->trans(temp,symt,code);
-    code.push_back(INST_ptr {new RTN {temp}});
-    code.push_back(INST_ptr {new JMP {exit}});
+    code.push_back(RTN {temp});
+    code.push_back(JMP {exit});
 }
 
-void IfEl::trans(std::string exit, SymT& symt, INST_vec& code) {
-    std::string then_lbl = symt.add_labl();
-    std::string else_lbl = symt.add_labl();
-    std::string done_lbl = symt.add_labl();
+void IfEl::trans(Labl exit, SymT& symt, INST_vec& code) {
+    Labl then_lbl = symt.add_labl();
+    Labl else_lbl = symt.add_labl();
+    Labl done_lbl = symt.add_labl();
     cndn->trans_cndn(then_lbl,else_lbl,symt,code);
-    code.push_back(INST_ptr {new LBL {then_lbl}});
+    code.push_back(LBL {then_lbl});
     then_blck->trans(exit,symt,code);
-    code.push_back(INST_ptr {new JMP {done_lbl}});
-    code.push_back(INST_ptr {new LBL {else_lbl}});
+    code.push_back(JMP {done_lbl});
+    code.push_back(LBL {else_lbl});
     else_blck->trans(exit,symt,code);
-    code.push_back(INST_ptr {new LBL {done_lbl}});      
+    code.push_back(LBL {done_lbl});      
 }
 
-void Whle::trans(std::string exit, SymT& symt, INST_vec& code) {
-    std::string loop_lbl = symt.add_labl();
-    std::string true_lbl = symt.add_labl();
-    std::string done_lbl = symt.add_labl();
-    code.push_back(INST_ptr {new LBL {loop_lbl}});
+void Whle::trans(Labl exit, SymT& symt, INST_vec& code) {
+    Labl loop_lbl = symt.add_labl();
+    Labl true_lbl = symt.add_labl();
+    Labl done_lbl = symt.add_labl();
+    code.push_back(LBL {loop_lbl});
     // if condition is true, jump to true_label and evaluate block
     // else, jump to done_label
     cndn->trans_cndn(true_lbl,done_lbl,symt,code);
-    code.push_back(INST_ptr {new LBL {true_lbl}});
+    code.push_back(LBL {true_lbl});
     blck->trans(exit,symt,code);
-    code.push_back(INST_ptr {new JMP {loop_lbl}});
-    code.push_back(INST_ptr {new LBL {done_lbl}}); 
+    code.push_back(JMP {loop_lbl});
+    code.push_back(LBL {done_lbl}); 
 }
 
-void PRtn::trans(std::string exit, SymT& symt, INST_vec& code) {
-    std::string temp = symt.add_temp(NoneTy {});
-    code.push_back(INST_ptr {new SET {temp,0}});
-    code.push_back(INST_ptr {new RTN {temp}});
-    code.push_back(INST_ptr {new JMP {exit}});
+void PRtn::trans(Labl exit, SymT& symt, INST_vec& code) {
+    Symb temp = symt.add_temp(NoneTy {});
+    code.push_back(SET {temp,0});
+    code.push_back(RTN {temp});
+    code.push_back(JMP {exit});
 }
 
-void Pass::trans([[maybe_unused]]std::string exit,
+void Pass::trans([[maybe_unused]]Labl exit,
                  [[maybe_unused]]SymT& symt, INST_vec& code) {
-    code.push_back(INST_ptr {new NOP {}});
+    code.push_back(NOP {});
 }
 
-void PCll::trans([[maybe_unused]]std::string exit,
+void PCll::trans([[maybe_unused]]Labl exit,
                  [[maybe_unused]]SymT& symt, INST_vec& code) {
-    int i = 0;
+    // Evaluate all the inputs before setting any args, since evaluating
+    // one might itself make a call that sets them.
+    std::vector<Symb> srces {};
     for (auto param : params) {
-        std::string srce = symt.add_temp(param->type);
+        Symb srce = symt.add_temp(param->type);
         param->trans(srce,symt,code);
-        code.push_back(INST_ptr {new ARG {i, srce}});
-        i++;
+        srces.push_back(srce);
+    }
+    for (unsigned int i = 0; i < srces.size(); i++) {
+        code.push_back(ARG {(int)i, srces[i]});
     }
     // Call f
-    code.push_back(INST_ptr {new CLL {name}});
+    code.push_back(CLL {Labl::of(name)});
     // ignore return value of None
 }
 
-void Prnt::trans([[maybe_unused]]std::string exit,
+//
+// Prnt::trans(exit,symt,code)
+//
+// Each print outputs its line with as few system calls as it can. A
+// literal's line is known as it's translated, and so becomes a string
+// constant of its own, output by a single PTS. A bool or None picks
+// one of the lines held by the global symbol table. Only an int or a
+// string that's computed needs its newline output after it.
+//
+void Prnt::trans([[maybe_unused]]Labl exit,
                  SymT& symt, INST_vec& code) {
+    Ltrl_ptr ltrl = std::dynamic_pointer_cast<Ltrl>(expn);
+    if (ltrl) {
+        Symb temp = symt.add_temp(StrTy {});
+        Labl line_lbl = symt.add_strg(to_string(ltrl->valu) + "\n");
+        code.push_back(STL {temp,line_lbl});
+        code.push_back(PTS {temp});
+        return;
+    }
     if (std::holds_alternative<IntTy>(expn->type)) {
-        std::string temp = symt.add_temp(IntTy {});
+        Symb temp = symt.add_temp(IntTy {});
         expn->trans(temp,symt,code);
-        code.push_back(INST_ptr {new PTI {temp}});
+        code.push_back(PTI {temp});
     }
     if (std::holds_alternative<StrTy>(expn->type)) {
-        std::string temp = symt.add_temp(StrTy {});
+        Symb temp = symt.add_temp(StrTy {});
         expn->trans(temp,symt,code);
-        code.push_back(INST_ptr {new PTS {temp}});
+        code.push_back(PTS {temp});
     }
     if (std::holds_alternative<BoolTy>(expn->type)) {
-        std::string true_lbl = symt.add_labl();
-        std::string flse_lbl = symt.add_labl();
-        std::string done_lbl = symt.add_labl();
-        std::string temp = symt.add_temp(BoolTy {});
+        Labl true_lbl = symt.add_labl();
+        Labl flse_lbl = symt.add_labl();
+        Labl done_lbl = symt.add_labl();
+        Symb temp = symt.add_temp(BoolTy {});
         //
         expn->trans_cndn(true_lbl,flse_lbl,symt,code);
-        code.push_back(INST_ptr {new LBL {true_lbl}});
-        code.push_back(INST_ptr {new STL {temp,TRUE_STRG_LBL}});
-        code.push_back(INST_ptr {new JMP {done_lbl}});
-        code.push_back(INST_ptr {new LBL {flse_lbl}});
-        code.push_back(INST_ptr {new STL {temp,FLSE_STRG_LBL}});
-        code.push_back(INST_ptr {new LBL {done_lbl}});
-        code.push_back(INST_ptr {new PTS {temp}});        
+        code.push_back(LBL {true_lbl});
+        code.push_back(STL {temp,TRUE_LINE_LBL});
+        code.push_back(JMP {done_lbl});
+        code.push_back(LBL {flse_lbl});
+        code.push_back(STL {temp,FLSE_LINE_LBL});
+        code.push_back(LBL {done_lbl});
+        code.push_back(PTS {temp});        
+        return;
     }
     if (std::holds_alternative<NoneTy>(expn->type)) {
-        std::string dumm = symt.add_temp(NoneTy {});
-        std::string temp = symt.add_temp(StrTy {});
+        Symb dumm = symt.add_temp(NoneTy {});
+        Symb temp = symt.add_temp(StrTy {});
         //
         expn->trans(dumm,symt,code);
-        code.push_back(INST_ptr {new STL {temp,NONE_STRG_LBL}});
-        code.push_back(INST_ptr {new PTS {temp}});        
+        code.push_back(STL {temp,NONE_LINE_LBL});
+        code.push_back(PTS {temp});        
+        return;
     }
-    std::string eoln = symt.add_temp(StrTy {});
-    code.push_back(INST_ptr {new STL {eoln,EOLN_STRG_LBL}});
-    code.push_back(INST_ptr {new PTS {eoln}});        
+    Symb eoln = symt.add_temp(StrTy {});
+    code.push_back(STL {eoln,EOLN_STRG_LBL});
+    code.push_back(PTS {eoln});        
 }
 
 // * * * * * 
@@ -254,58 +327,58 @@ void Prnt::trans([[maybe_unused]]std::string exit,
 // and jumps to `else_lbl` when the expression is `False`.
 //
 
-void Plus::trans(std::string dest, SymT& symt, INST_vec& code) {
+void Plus::trans(Symb dest, SymT& symt, INST_vec& code) {
     if (std::holds_alternative<IntTy>(type)) {
-        std::string srce1 = symt.add_temp(left->type);
-        std::string srce2 = symt.add_temp(rght->type);
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
         left->trans(srce1,symt,code);
         rght->trans(srce2,symt,code);
-        code.push_back(INST_ptr {new ADD {dest,srce1,srce2}});
+        code.push_back(ADD {dest,srce1,srce2});
     }
 }
 
-void Mnus::trans(std::string dest, SymT& symt, INST_vec& code) {
+void Mnus::trans(Symb dest, SymT& symt, INST_vec& code) {
     if (std::holds_alternative<IntTy>(type)) {
-        std::string srce1 = symt.add_temp(left->type);
-        std::string srce2 = symt.add_temp(rght->type);
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
         left->trans(srce1,symt,code);
         rght->trans(srce2,symt,code);
-        code.push_back(INST_ptr {new SUB {dest,srce1,srce2}});
+        code.push_back(SUB {dest,srce1,srce2});
     }
 }
 
-void Tmes::trans(std::string dest, SymT& symt, INST_vec& code) {
+void Tmes::trans(Symb dest, SymT& symt, INST_vec& code) {
     if (std::holds_alternative<IntTy>(type)) {
-        std::string srce1 = symt.add_temp(left->type);
-        std::string srce2 = symt.add_temp(rght->type);
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
         left->trans(srce1,symt,code);
         rght->trans(srce2,symt,code);
-        code.push_back(INST_ptr {new MUL {dest,srce1,srce2}});
+        code.push_back(MUL {dest,srce1,srce2});
     }
 }
 
-void IDiv::trans(std::string dest, SymT& symt, INST_vec& code) {
+void IDiv::trans(Symb dest, SymT& symt, INST_vec& code) {
     if (std::holds_alternative<IntTy>(type)) {
-        std::string srce1 = symt.add_temp(left->type);
-        std::string srce2 = symt.add_temp(rght->type);
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
         left->trans(srce1,symt,code);
         rght->trans(srce2,symt,code);
-        code.push_back(INST_ptr {new DIV {dest,srce1,srce2}});
+        code.push_back(DIV {dest,srce1,srce2});
     }
 }
 
-void IMod::trans(std::string dest, SymT& symt, INST_vec& code) {
+void IMod::trans(Symb dest, SymT& symt, INST_vec& code) {
     if (std::holds_alternative<IntTy>(type)) {
-        std::string srce1 = symt.add_temp(left->type);
-        std::string srce2 = symt.add_temp(rght->type);
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
         left->trans(srce1,symt,code);
         rght->trans(srce2,symt,code);
-        code.push_back(INST_ptr {new MOD {dest,srce1,srce2}});
+        code.push_back(MOD {dest,srce1,srce2});
     }
 }
 
-void Expn::trans_cndn([[maybe_unused]]std::string then_lbl,
-                      [[maybe_unused]]std::string else_lbl,
+void Expn::trans_cndn([[maybe_unused]]Labl then_lbl,
+                      [[maybe_unused]]Labl else_lbl,
                       [[maybe_unused]]SymT& symt,
                       [[maybe_unused]]INST_vec& code) {
     
@@ -315,234 +388,443 @@ void Expn::trans_cndn([[maybe_unused]]std::string then_lbl,
 }
 
 // Used as a condition in a while or an if
-void Less::trans_cndn(std::string then_lbl, std::string else_lbl,
+void Less::trans_cndn(Labl then_lbl, Labl else_lbl,
                       SymT& symt, INST_vec& code) {
     if (std::holds_alternative<IntTy>(left->type)
         && std::holds_alternative<IntTy>(rght->type)) {
-        std::string srce1 = symt.add_temp(left->type);
-        std::string srce2 = symt.add_temp(rght->type);
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
         left->trans(srce1,symt,code);
         rght->trans(srce2,symt,code);
-        code.push_back(INST_ptr {new BCN {"lt",
+        code.push_back(BCN {Cndn::LT,
                                           srce1,srce2,
-                                          then_lbl,else_lbl}});
+                                          then_lbl,else_lbl});
     }
 }
 
 // Computes an actual bool value rather than jumping to a place in code
-void Less::trans(std::string dest, SymT& symt, INST_vec& code) {
-    std::string true_lbl = symt.add_labl();
-    std::string flse_lbl = symt.add_labl();
-    std::string done_lbl = symt.add_labl();
-    trans_cndn(true_lbl,flse_lbl,symt,code);
-    code.push_back(INST_ptr {new LBL {true_lbl}});
-    code.push_back(INST_ptr {new SET {dest,1}});
-    code.push_back(INST_ptr {new JMP {done_lbl}});
-    code.push_back(INST_ptr {new LBL {flse_lbl}});
-    code.push_back(INST_ptr {new SET {dest,0}});
-    code.push_back(INST_ptr {new LBL {done_lbl}});
+void Less::trans(Symb dest, SymT& symt, INST_vec& code) {
+    if (std::holds_alternative<IntTy>(left->type)
+        && std::holds_alternative<IntTy>(rght->type)) {
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
+        left->trans(srce1,symt,code);
+        rght->trans(srce2,symt,code);
+        code.push_back(SLT {dest,srce1,srce2});
+    }
 }
 
-void LsEq::trans_cndn(std::string then_lbl, std::string else_lbl,
+void LsEq::trans_cndn(Labl then_lbl, Labl else_lbl,
                       SymT& symt, INST_vec& code) {
     if (std::holds_alternative<IntTy>(left->type)
         && std::holds_alternative<IntTy>(rght->type)) {
-        std::string srce1 = symt.add_temp(left->type);
-        std::string srce2 = symt.add_temp(rght->type);
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
         left->trans(srce1,symt,code);
         rght->trans(srce2,symt,code);
-        code.push_back(INST_ptr {new BCN {"le",
+        code.push_back(BCN {Cndn::LE,
                                           srce1,srce2,
-                                          then_lbl,else_lbl}});
+                                          then_lbl,else_lbl});
     }
 }
 
-void LsEq::trans(std::string dest, SymT& symt, INST_vec& code) {
-    std::string true_lbl = symt.add_labl();
-    std::string flse_lbl = symt.add_labl();
-    std::string done_lbl = symt.add_labl();
-    trans_cndn(true_lbl,flse_lbl,symt,code);
-    code.push_back(INST_ptr {new LBL {true_lbl}});
-    code.push_back(INST_ptr {new SET {dest,1}});
-    code.push_back(INST_ptr {new JMP {done_lbl}});
-    code.push_back(INST_ptr {new LBL {flse_lbl}});
-    code.push_back(INST_ptr {new SET {dest,0}});
-    code.push_back(INST_ptr {new LBL {done_lbl}});
+// Computes an actual bool value rather than jumping to a place in code
+void LsEq::trans(Symb dest, SymT& symt, INST_vec& code) {
+    if (std::holds_alternative<IntTy>(left->type)
+        && std::holds_alternative<IntTy>(rght->type)) {
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
+        left->trans(srce1,symt,code);
+        rght->trans(srce2,symt,code);
+        code.push_back(SLE {dest,srce1,srce2});
+    }
 }
 
-void Equl::trans_cndn(std::string then_lbl, std::string else_lbl,
+void Equl::trans_cndn(Labl then_lbl, Labl else_lbl,
                       SymT& symt, INST_vec& code) {
     if (std::holds_alternative<IntTy>(left->type)
         && std::holds_alternative<IntTy>(rght->type)) {
-        std::string srce1 = symt.add_temp(left->type);
-        std::string srce2 = symt.add_temp(rght->type);
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
         left->trans(srce1,symt,code);
         rght->trans(srce2,symt,code);
-        code.push_back(INST_ptr {new BCN {"eq",
+        code.push_back(BCN {Cndn::EQ,
                                           srce1,srce2,
-                                          then_lbl,else_lbl}});
+                                          then_lbl,else_lbl});
     }
 }
 
-void Equl::trans(std::string dest, SymT& symt, INST_vec& code) {
-    std::string true_lbl = symt.add_labl();
-    std::string flse_lbl = symt.add_labl();
-    std::string done_lbl = symt.add_labl();
-    trans_cndn(true_lbl,flse_lbl,symt,code);
-    code.push_back(INST_ptr {new LBL {true_lbl}});
-    code.push_back(INST_ptr {new SET {dest,1}});
-    code.push_back(INST_ptr {new JMP {done_lbl}});
-    code.push_back(INST_ptr {new LBL {flse_lbl}});
-    code.push_back(INST_ptr {new SET {dest,0}});
-    code.push_back(INST_ptr {new LBL {done_lbl}});
+// Computes an actual bool value rather than jumping to a place in code
+void Equl::trans(Symb dest, SymT& symt, INST_vec& code) {
+    if (std::holds_alternative<IntTy>(left->type)
+        && std::holds_alternative<IntTy>(rght->type)) {
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
+        left->trans(srce1,symt,code);
+        rght->trans(srce2,symt,code);
+        code.push_back(SEQ {dest,srce1,srce2});
+    }
 }
 
-void And::trans_cndn(std::string then_lbl, std::string else_lbl,
+void And::trans_cndn(Labl then_lbl, Labl else_lbl,
                      SymT& symt, INST_vec& code) {
-    std::string cont_lbl = symt.add_labl();
+    Labl cont_lbl = symt.add_labl();
     // If left condition is false, jump to else_lbl
     left->trans_cndn(cont_lbl,else_lbl,symt,code);
-    code.push_back(INST_ptr {new LBL {cont_lbl}});    
+    code.push_back(LBL {cont_lbl});    
     rght->trans_cndn(then_lbl,else_lbl,symt,code);
 }
 
-void And::trans(std::string dest, SymT& symt, INST_vec& code) {
-    std::string true_lbl = symt.add_labl();
-    std::string flse_lbl = symt.add_labl();
-    std::string done_lbl = symt.add_labl();
+// Computes both sides and combines them when skipping the right side
+// makes no difference, otherwise branches as for a condition.
+void And::trans(Symb dest, SymT& symt, INST_vec& code) {
+    if (rght->pure()) {
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
+        left->trans(srce1,symt,code);
+        rght->trans(srce2,symt,code);
+        code.push_back(AND {dest,srce1,srce2});
+        return;
+    }
+    Labl true_lbl = symt.add_labl();
+    Labl flse_lbl = symt.add_labl();
+    Labl done_lbl = symt.add_labl();
     trans_cndn(true_lbl,flse_lbl,symt,code);
-    code.push_back(INST_ptr {new LBL {true_lbl}});
-    code.push_back(INST_ptr {new SET {dest,1}});
-    code.push_back(INST_ptr {new JMP {done_lbl}});
-    code.push_back(INST_ptr {new LBL {flse_lbl}});
-    code.push_back(INST_ptr {new SET {dest,0}});
-    code.push_back(INST_ptr {new LBL {done_lbl}});
+    code.push_back(LBL {true_lbl});
+    code.push_back(SET {dest,1});
+    code.push_back(JMP {done_lbl});
+    code.push_back(LBL {flse_lbl});
+    code.push_back(SET {dest,0});
+    code.push_back(LBL {done_lbl});
 }
 
-void Or::trans_cndn(std::string then_lbl, std::string else_lbl,
+void Or::trans_cndn(Labl then_lbl, Labl else_lbl,
                      SymT& symt, INST_vec& code) {
-    std::string cont_lbl = symt.add_labl();
+    Labl cont_lbl = symt.add_labl();
     // If left condition is false, check right condition
     // If left condition is true, jump to then_lbl (we're done)
     left->trans_cndn(then_lbl,cont_lbl,symt,code);
-    code.push_back(INST_ptr {new LBL {cont_lbl}});    
+    code.push_back(LBL {cont_lbl});    
     rght->trans_cndn(then_lbl,else_lbl,symt,code);
 }
 
-void Or::trans(std::string dest, SymT& symt, INST_vec& code) {
-    std::string true_lbl = symt.add_labl();
-    std::string flse_lbl = symt.add_labl();
-    std::string done_lbl = symt.add_labl();
+// Computes both sides and combines them when skipping the right side
+// makes no difference, otherwise branches as for a condition.
+void Or::trans(Symb dest, SymT& symt, INST_vec& code) {
+    if (rght->pure()) {
+        Symb srce1 = symt.add_temp(left->type);
+        Symb srce2 = symt.add_temp(rght->type);
+        left->trans(srce1,symt,code);
+        rght->trans(srce2,symt,code);
+        code.push_back(OR {dest,srce1,srce2});
+        return;
+    }
+    Labl true_lbl = symt.add_labl();
+    Labl flse_lbl = symt.add_labl();
+    Labl done_lbl = symt.add_labl();
     trans_cndn(true_lbl,flse_lbl,symt,code);
-    code.push_back(INST_ptr {new LBL {true_lbl}});
-    code.push_back(INST_ptr {new SET {dest,1}});
-    code.push_back(INST_ptr {new JMP {done_lbl}});
-    code.push_back(INST_ptr {new LBL {flse_lbl}});
-    code.push_back(INST_ptr {new SET {dest,0}});
-    code.push_back(INST_ptr {new LBL {done_lbl}});
+    code.push_back(LBL {true_lbl});
+    code.push_back(SET {dest,1});
+    code.push_back(JMP {done_lbl});
+    code.push_back(LBL {flse_lbl});
+    code.push_back(SET {dest,0});
+    code.push_back(LBL {done_lbl});
 }
 
-void Not::trans_cndn(std::string then_lbl, std::string else_lbl,
+void Not::trans_cndn(Labl then_lbl, Labl else_lbl,
                      SymT& symt, INST_vec& code) {
     expn->trans_cndn(else_lbl,then_lbl,symt,code);
 }
 
-void Not::trans(std::string dest, SymT& symt, INST_vec& code) {
-    std::string true_lbl = symt.add_labl();
-    std::string flse_lbl = symt.add_labl();
-    std::string done_lbl = symt.add_labl();
-    trans_cndn(true_lbl,flse_lbl,symt,code);
-    code.push_back(INST_ptr {new LBL {true_lbl}});
-    code.push_back(INST_ptr {new SET {dest,1}});
-    code.push_back(INST_ptr {new JMP {done_lbl}});
-    code.push_back(INST_ptr {new LBL {flse_lbl}});
-    code.push_back(INST_ptr {new SET {dest,0}});
-    code.push_back(INST_ptr {new LBL {done_lbl}});
+void Not::trans(Symb dest, SymT& symt, INST_vec& code) {
+    Symb srce = symt.add_temp(expn->type);
+    expn->trans(srce,symt,code);
+    code.push_back(NOT {dest,srce});
+}
+
+//
+// Expn::pure()
+//
+// Whether an expression can be evaluated without any effect and without
+// failing. Division can fail, `+` and `-` trap on overflow, and calls
+// and input have effects.
+//
+bool Expn::pure(void) const {
+    return false;
+}
+bool Tmes::pure(void) const {
+    return left->pure() && rght->pure();
+}
+bool Less::pure(void) const {
+    return left->pure() && rght->pure();
+}
+bool LsEq::pure(void) const {
+    return left->pure() && rght->pure();
+}
+bool Equl::pure(void) const {
+    return left->pure() && rght->pure();
+}
+bool And::pure(void) const {
+    return left->pure() && rght->pure();
+}
+bool Or::pure(void) const {
+    return left->pure() && rght->pure();
+}
+bool Not::pure(void) const {
+    return expn->pure();
+}
+bool Ltrl::pure(void) const {
+    return true;
+}
+bool Lkup::pure(void) const {
+    return true;
 }
 
-void Ltrl::trans(std::string dest, SymT& symt, INST_vec& code) {
+void Ltrl::trans(Symb dest, SymT& symt, INST_vec& code) {
     if (std::holds_alternative<int>(valu)) {
         int ival = std::get<int>(valu);
-        code.push_back(INST_ptr {new SET {dest,ival}});
+        code.push_back(SET {dest,ival});
     }
     if (std::holds_alternative<std::string>(valu)) {
         std::string sval = std::get<std::string>(valu);
-        std::string strg_lbl = symt.add_strg(sval);
-        code.push_back(INST_ptr {new STL {dest,strg_lbl}});
+        Labl strg_lbl = symt.add_strg(sval);
+        code.push_back(STL {dest,strg_lbl});
     }
     if (std::holds_alternative<bool>(valu)) {
         bool bval = std::get<bool>(valu);
         if (bval) {
-            code.push_back(INST_ptr {new SET {dest,1}});
+            code.push_back(SET {dest,1});
         } else {
-            code.push_back(INST_ptr {new SET {dest,0}});
+            code.push_back(SET {dest,0});
         }
     }
     if (std::holds_alternative<none>(valu)) {
-        code.push_back(INST_ptr {new SET {dest,0}});
+        code.push_back(SET {dest,0});
     }
 }
 
-void Ltrl::trans_cndn(std::string then_lbl, std::string else_lbl,
+void Ltrl::trans_cndn(Labl then_lbl, Labl else_lbl,
                       [[maybe_unused]]SymT& symt, INST_vec& code) { 
     bool bval = std::get<bool>(valu);
     if (bval) {
-        code.push_back(INST_ptr {new JMP {then_lbl}});
+        code.push_back(JMP {then_lbl});
     } else {
-        code.push_back(INST_ptr {new JMP {else_lbl}});
+        code.push_back(JMP {else_lbl});
     }
 }
 
-void Lkup::trans(std::string dest, [[maybe_unused]]SymT& symt,
-                 INST_vec& code) {
-    code.push_back(INST_ptr {new MOV {dest,name}});
+void Lkup::trans(Symb dest, SymT& symt, INST_vec& code) {
+    code.push_back(MOV {dest,symt.get_symb(name)});
 }
 
-void Lkup::trans_cndn(std::string then_lbl, std::string else_lbl,
-                      [[maybe_unused]]SymT& symt, INST_vec& code) { 
-    code.push_back(INST_ptr {new BCZ {"gtz",name,then_lbl,else_lbl}});
+void Lkup::trans_cndn(Labl then_lbl, Labl else_lbl,
+                      SymT& symt, INST_vec& code) { 
+    code.push_back(BCZ {Cndn::GTZ,symt.get_symb(name),then_lbl,else_lbl});
 }
 
-void Inpt::trans(std::string dest, SymT& symt, INST_vec& code) {
-    std::string strg = symt.add_temp(StrTy {});
+void Inpt::trans(Symb dest, SymT& symt, INST_vec& code) {
+    Symb strg = symt.add_temp(StrTy {});
     expn->trans(strg,symt,code);
-    code.push_back(INST_ptr {new PTS {strg}});
-    code.push_back(INST_ptr {new GTI {dest}});
+    code.push_back(PTS {strg});
+    code.push_back(GTI {dest});
 }
 
-void IntC::trans([[maybe_unused]]std::string dest,
+void IntC::trans([[maybe_unused]]Symb dest,
                  [[maybe_unused]]SymT& symt, INST_vec& code) {
     // 
 }
 
-void StrC::trans([[maybe_unused]]std::string dest,
+void StrC::trans([[maybe_unused]]Symb dest,
                  [[maybe_unused]]SymT& symt, INST_vec& code) {
     // 
 }
 
 // Generate code that evaluates inputs and set args 0, 1, ... to their results
-void FCll::trans([[maybe_unused]]std::string dest,
+void FCll::trans([[maybe_unused]]Symb dest,
                  [[maybe_unused]]SymT& symt, INST_vec& code) {
-    int i = 0;
+    // Evaluate all the inputs before setting any args, since evaluating
+    // one might itself make a call that sets them.
+    std::vector<Symb> srces {};
     for (auto param : params) {
-        std::string srce = symt.add_temp(param->type);
+        Symb srce = symt.add_temp(param->type);
         param->trans(srce,symt,code);
-        code.push_back(INST_ptr {new ARG {i, srce}});
-        i++;
+        srces.push_back(srce);
+    }
+    for (unsigned int i = 0; i < srces.size(); i++) {
+        code.push_back(ARG {(int)i, srces[i]});
     }
     // Call f, get value returned by f, and place it into x
-    code.push_back(INST_ptr {new CLL {name}});
-    code.push_back(INST_ptr {new RTV {dest}});
+    code.push_back(CLL {Labl::of(name)});
+    code.push_back(RTV {dest});
 }
 
 // Functions may return a bool which can be used as conditions within while and if
-void FCll::trans_cndn(std::string then_lbl, std::string else_lbl,
+void FCll::trans_cndn(Labl then_lbl, Labl else_lbl,
                       [[maybe_unused]]SymT& symt, INST_vec& code) { 
     // Generate code that evaluates f
-    std::string srce = symt.add_temp(type);
+    Symb srce = symt.add_temp(type);
     trans(srce,symt,code);
     // If f evaluates to false, branch to else block
-    code.push_back(INST_ptr {new BCZ {"eqz",
+    code.push_back(BCZ {Cndn::EQZ,
                                         srce,
-                                        else_lbl,then_lbl}});
-}
\ No newline at end of file
+                                        else_lbl,then_lbl});
+}
+// * * * * *
+//
+// INST::dump(os)
+//
+// Output each pseudo-instruction in the form given in the comments
+// of `dwislpy-inst.hh`.
+//
+
+void SET::dump(std::ostream& os) const {
+    os << "SET " << dst << "," << val;
+}
+void STL::dump(std::ostream& os) const {
+    os << "STL " << dst << "," << lbl;
+}
+void MOV::dump(std::ostream& os) const {
+    os << "MOV " << dst << "," << src;
+}
+void ADD::dump(std::ostream& os) const {
+    os << "ADD " << dst << "," << src1 << "," << src2;
+}
+void SUB::dump(std::ostream& os) const {
+    os << "SUB " << dst << "," << src1 << "," << src2;
+}
+void MUL::dump(std::ostream& os) const {
+    os << "MUL " << dst << "," << src1 << "," << src2;
+}
+void DIV::dump(std::ostream& os) const {
+    os << "DIV " << dst << "," << src1 << "," << src2;
+}
+void MOD::dump(std::ostream& os) const {
+    os << "MOD " << dst << "," << src1 << "," << src2;
+}
+void ADDI::dump(std::ostream& os) const {
+    os << "ADDI " << dst << "," << src << "," << val;
+}
+void ADDIU::dump(std::ostream& os) const {
+    os << "ADDIU " << dst << "," << src << "," << val;
+}
+void SLTI::dump(std::ostream& os) const {
+    os << "SLTI " << dst << "," << src << "," << val;
+}
+void MULP::dump(std::ostream& os) const {
+    os << "MULP " << dst << "," << src << "," << val;
+}
+void DIVP::dump(std::ostream& os) const {
+    os << "DIVP " << dst << "," << src << "," << val;
+}
+void MODP::dump(std::ostream& os) const {
+    os << "MODP " << dst << "," << src << "," << val;
+}
+void SLT::dump(std::ostream& os) const {
+    os << "SLT " << dst << "," << src1 << "," << src2;
+}
+void SLE::dump(std::ostream& os) const {
+    os << "SLE " << dst << "," << src1 << "," << src2;
+}
+void SEQ::dump(std::ostream& os) const {
+    os << "SEQ " << dst << "," << src1 << "," << src2;
+}
+void AND::dump(std::ostream& os) const {
+    os << "AND " << dst << "," << src1 << "," << src2;
+}
+void OR::dump(std::ostream& os) const {
+    os << "OR " << dst << "," << src1 << "," << src2;
+}
+void NOT::dump(std::ostream& os) const {
+    os << "NOT " << dst << "," << src;
+}
+void NOP::dump(std::ostream& os) const {
+    os << "NOP";
+}
+void LBL::dump(std::ostream& os) const {
+    os << "LBL " << lbl;
+}
+void BCN::dump(std::ostream& os) const {
+    os << "BCN " << cndn_name(cndn) << "," << src1 << "," << src2
+       << "," << lblt << "," << lblf;
+}
+void BCZ::dump(std::ostream& os) const {
+    os << "BCZ " << cndn_name(cndn) << "," << src << "," << lblt << "," << lblf;
+}
+void JMP::dump(std::ostream& os) const {
+    os << "JMP " << lbl;
+}
+void ENTER::dump(std::ostream& os) const {
+    os << "ENTER";
+}
+void RTN::dump(std::ostream& os) const {
+    os << "RTN " << src;
+}
+void LEAVE::dump(std::ostream& os) const {
+    os << "LEAVE";
+}
+void ARG::dump(std::ostream& os) const {
+    os << "ARG " << idx << "," << src;
+}
+void RTV::dump(std::ostream& os) const {
+    os << "RTV " << dst;
+}
+void CLL::dump(std::ostream& os) const {
+    os << "CLL " << lbl;
+}
+void TCLL::dump(std::ostream& os) const {
+    os << "TCLL " << lbl;
+}
+void GTI::dump(std::ostream& os) const {
+    os << "GTI " << dst;
+}
+void PTI::dump(std::ostream& os) const {
+    os << "PTI " << src;
+}
+void PTS::dump(std::ostream& os) const {
+    os << "PTS " << src;
+}
+void CMT::dump(std::ostream& os) const {
+    os << "CMT " << msg;
+}
+
+//
+// INST::dump(os), and the other methods of INST that call those of the
+// op it holds (see `INST::visit` in `dwislpy-inst.hh`).
+//
+void INST::dump(std::ostream& os) const {
+    visit(*this, [&](const auto& op) { op.dump(os); });
+}
+void INST::toMIPS(AsmOut& os, const SymT& symt) const {
+    visit(*this, [&](const auto& op) { op.toMIPS(os,symt); });
+}
+void INST::toX86(AsmOut& os, const SymT& symt) const {
+    visit(*this, [&](const auto& op) { op.toX86(os,symt); });
+}
+void INST::toLLVM(LLVMOut& out, const SymT& symt) const {
+    visit(*this, [&](const auto& op) { op.toLLVM(out,symt); });
+}
+void INST::toIntp(IntpOut& out, const SymT& symt) const {
+    visit(*this, [&](const auto& op) { op.toIntp(out,symt); });
+}
+void INST::toSPIM(SpimOut& out, const SymT& symt) const {
+    visit(*this, [&](const auto& op) { op.toSPIM(out,symt); });
+}
+
+//
+// cndn_name(cn) and invert(cn)
+//
+static const std::string CNDN_NAMES[] {
+    "lt", "le", "gt", "ge", "eq", "ne",
+    "ltz", "lez", "gtz", "gez", "eqz", "nez"
+};
+static const Cndn INVERSES[] {
+    Cndn::GE, Cndn::GT, Cndn::LE, Cndn::LT, Cndn::NE, Cndn::EQ,
+    Cndn::GEZ, Cndn::GTZ, Cndn::LEZ, Cndn::LTZ, Cndn::NEZ, Cndn::EQZ
+};
+
+const std::string& cndn_name(Cndn cn) {
+    return CNDN_NAMES[(int)cn];
+}
+Cndn invert(Cndn cn) {
+    return INVERSES[(int)cn];
+}
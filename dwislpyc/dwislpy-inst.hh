@@ -13,12 +13,105 @@
 #include <vector>
 #include <utility>
 #include <string>
-#include <memory>
+#include <new>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
 #include "dwislpy-check.hh"
+#include "dwislpy-emit.hh"
 
 class INST;
-typedef std::shared_ptr<INST> INST_ptr;
-typedef std::vector<INST_ptr> INST_vec;
+class LLVMOut;  // See dwislpy-llvm.hh.
+class IntpOut;  // See dwislpy-intp.hh.
+class SpimOut;  // See dwislpy-spim.hh.
+typedef std::vector<INST> INST_vec;
+
+//
+// Labels are written to the assembly by name.
+//
+inline AsmOut& operator<<(AsmOut& os, Labl lbl) {
+    return os << lbl.name();
+}
+
+//
+// class Opnds
+//
+// The operands given by `INST::srcs` and `INST::dsts`. No instruction
+// has more than a few, so they're held in place rather than in a
+// `std::vector`, which would cost a heap allocation on every call.
+// The analyses ask for them many times per instruction.
+//
+class Opnds {
+private:
+    static const int MAX_OPNDS = 3;
+    Symb* opnds[MAX_OPNDS];
+    int count;
+public:
+    Opnds(void) : count {0} { }
+    Opnds(std::initializer_list<Symb*> os) : count {0} {
+        for (Symb* o : os) {
+            opnds[count++] = o;
+        }
+    }
+    int size(void) const { return count; }
+    bool empty(void) const { return count == 0; }
+    Symb* operator[](int i) const { return opnds[i]; }
+    Symb* const* begin(void) const { return opnds; }
+    Symb* const* end(void) const { return opnds + count; }
+};
+
+//
+// class Jmps
+//
+// The labels given by `INST::jmps`, held in place like `Opnds`.
+//
+class Jmps {
+private:
+    static const int MAX_JMPS = 2;
+    Labl lbls[MAX_JMPS];
+    int count;
+public:
+    Jmps(void) : count {0} { }
+    Jmps(std::initializer_list<Labl> ls) : count {0} {
+        for (Labl l : ls) {
+            lbls[count++] = l;
+        }
+    }
+    int size(void) const { return count; }
+    bool empty(void) const { return count == 0; }
+    Labl operator[](int i) const { return lbls[i]; }
+    const Labl* begin(void) const { return lbls; }
+    const Labl* end(void) const { return lbls + count; }
+};
+
+//
+// The opcode of each kind of pseudo-instruction, which tags it within
+// an INST.
+//
+enum Opcode {
+    OP_SET, OP_STL, OP_MOV, OP_ADD, OP_SUB, OP_MUL, OP_DIV, OP_MOD, OP_NOP,
+    OP_ADDI, OP_ADDIU, OP_SLTI, OP_MULP, OP_DIVP, OP_MODP,
+    OP_SLT, OP_SLE, OP_SEQ, OP_AND, OP_OR, OP_NOT,
+    OP_LBL, OP_BCN, OP_BCZ, OP_JMP,
+    OP_ENTER, OP_RTN, OP_LEAVE,
+    OP_ARG, OP_RTV, OP_CLL, OP_TCLL,
+    OP_GTI, OP_PTI, OP_PTS, OP_CMT
+};
+
+//
+// The conditions of the branches BCN and BCZ.
+//
+// * cndn_name(cn) - its name, e.g. "lt" or "gez", which is also the
+//                   suffix of the MIPS branch that tests it.
+// * invert(cn)    - the condition that holds when `cn` doesn't.
+//
+// It's scoped so that a condition can't be output as a number by
+// mistake.
+//
+enum class Cndn { LT, LE, GT, GE, EQ, NE, LTZ, LEZ, GTZ, GEZ, EQZ, NEZ };
+
+const std::string& cndn_name(Cndn cn);
+Cndn invert(Cndn cn);
 
 //
 //
@@ -34,8 +127,10 @@ typedef std::vector<INST_ptr> INST_vec;
 // Pseudo-instructions are, for the most part, very nearly the same as
 // MIPS machine instructions except, rather than operating on MIPS
 // registers, the can operate on arbirary "temporary" variables. And
-// so their work isn't directly tied to a specific processor.  Below
-// this class definition are derived subclasses for the variety of
+// so their work isn't directly tied to a specific processor. These
+// variables are named by their symbols (see `Symb` in
+// `dwislpy-check.hh`), and labels by their interned IDs (see `Labl`).
+// Below this class definition are the classes for the variety of
 // pseudo-instructions, like ADD, SET, BLT, JMP, etc. that directly
 // correspond to machine instructions. Others like ENTER, LEAVE, RTN,
 // ARG, CLL, RTV are used for managing calls amongst the components of
@@ -46,30 +141,80 @@ typedef std::vector<INST_ptr> INST_vec;
 // and others that will require system calls (for input/output) or for
 // working with strings.
 //
-// Note that the constructors of INST subclasses do little work other
+// Note that the constructors of these classes do little work other
 // than fill in the struct's info from the parameters.
 //
+// An INST is a tagged union of them: its `code` says which one it
+// holds. It holds it in place, takes no more room than the largest of
+// them (a few words), and is copied like a plain struct. An `INST_vec`
+// is then one contiguous array of instructions, rather than an array
+// of pointers to instructions each allocated on its own, and so the
+// passes, which build new code and drop the old all the time, make one
+// allocation per array rather than one per instruction. Code is copied
+// by value, so a copy can be rewritten without changing the original
+// (see `dwislpy-inln.cc`).
+//
+// * INST {op}  - an instruction holding `op`, e.g. `INST {JMP {lbl}}`.
+//                An op converts to an INST where one is expected, as
+//                in `code.push_back(JMP {lbl})`.
+// * as<T>()    - the `T` held, if the instruction holds a `T`, else
+//                `nullptr`. This is how the passes look inside one,
+//                e.g. `if (BCN* bcn = inst.as<BCN>()) ...`.
+//
 // Methods of INST:
 // ----------------
 //
 // * toMIPS - This converts the pseudo-instruction into a sequence of
-//            MIPS instructions, outputting them to the give output
-//            stream. This is performed in PASS 3 of compilation.
+//            MIPS instructions, outputting them to the given assembly
+//            writer (see `dwislpy-emit.hh`). This is performed in PASS 3
+//            of compilation.
+//
+// * toX86  - The same, but for x86-64 (see `dwislpy-x86.hh`).
+//
+// * toLLVM - The same, but for LLVM IR (see `dwislpy-llvm.hh`).
+//
+// * toIntp - This lowers the pseudo-instruction into the ops run by
+//            the IR interpreter (see `dwislpy-intp.hh`).
+//
+// * toSPIM - This lowers the pseudo-instruction into the MIPS32
+//            machine instructions loaded into SPIM by `dwislpyc --run`
+//            (see `dwislpy-spim.hh`). They're those `toMIPS` outputs.
 //
-// This method takes a SymT object which contains information for
+// * dump   - This outputs the pseudo-instruction in a readable form,
+//            e.g. `ADD temp_3,x,temp_2`. It is used for inspecting
+//            the IR, as with `dwislpyc --dump-cfg`.
+//
+// The `toMIPS` method takes a SymT object which contains information for
 // assembling each function component of the program, namely the stack
-// frame locations of each variable and temporary. It also tracks
-// whole-program information like string constants.
+// frame locations of each variable and temporary, and the register
+// given to it (if any) by the allocator. It also tracks whole-program
+// information like string constants.
+//
+// The remaining methods let analyses of the IR (e.g. liveness, see
+// `dwislpy-live.hh`) inspect a pseudo-instruction's operands and
+// its effect on control flow without knowing its opcode:
+//
+// * srcs - the temporaries/variables the instruction reads.
+// * dsts - the temporaries/variables the instruction writes.
+// * jmps - the labels the instruction might jump to.
+// * fall - whether execution can continue at the next instruction.
+//
+// The first two give pointers to the operand symbols so that a pass
+// can rename operands in place. Their `const` versions are for the
+// analyses, which only read them.
+//
+// Each method of INST calls the one of the op it holds. The classes
+// of the ops inherit from `Oper` the methods that few of them need.
 //
 
-class INST {
+class Oper {
 public:
-  virtual void toMIPS(std::ostream& os, const SymT& assm) const = 0;
+    Opnds srcs(void) { return {}; }
+    Opnds dsts(void) { return {}; }
+    Jmps jmps(void) const { return {}; }
+    bool fall(void) const { return true; }
 };
 
-typedef std::shared_ptr<INST> INST_ptr;
-typedef std::vector<INST_ptr> INST_vec;
-
 //
 // Basic pseudo-instructions.
 //
@@ -79,141 +224,465 @@ typedef std::vector<INST_ptr> INST_vec;
 //   ADD d,s1,s2 - sums two temporaries into another.
 //   NOP         - does nothing; "no operation"
 //
-class SET : public INST {
+class SET : public Oper {
 public:
-    std::string dst;
+    static const Opcode CODE = OP_SET;
+    Symb dst;
     int val;
-    SET(std::string d, int v) : dst {d}, val {v} { }
-    virtual ~SET(void) = default;
-    void toMIPS(std::ostream& os, const SymT& assm) const;
+    SET(Symb d, int v) : dst {d}, val {v} { }
+    void toMIPS(AsmOut& os, const SymT& assm) const;
+    void toX86(AsmOut& os, const SymT& assm) const;
+    void toLLVM(LLVMOut& out, const SymT& assm) const;
+    void toIntp(IntpOut& out, const SymT& assm) const;
+    void toSPIM(SpimOut& out, const SymT& assm) const;
+    void dump(std::ostream& os) const;
+    Opnds dsts(void) { return {&dst}; }
 };
 
-class STL : public INST {
+class STL : public Oper {
 public:
-    std::string dst;
-    std::string lbl;
-    STL(std::string d, std::string l) : dst {d}, lbl {l} { }
-    virtual ~STL(void) = default;
-    void toMIPS(std::ostream& os, const SymT& assm) const;
+    static const Opcode CODE = OP_STL;
+    Symb dst;
+    Labl lbl;
+    STL(Symb d, Labl l) : dst {d}, lbl {l} { }
+    void toMIPS(AsmOut& os, const SymT& assm) const;
+    void toX86(AsmOut& os, const SymT& assm) const;
+    void toLLVM(LLVMOut& out, const SymT& assm) const;
+    void toIntp(IntpOut& out, const SymT& assm) const;
+    void toSPIM(SpimOut& out, const SymT& assm) const;
+    void dump(std::ostream& os) const;
+    Opnds dsts(void) { return {&dst}; }
 };
 
-class MOV : public INST {
+class MOV : public Oper {
 public:
-    std::string dst;
-    std::string src;
-    MOV(std::string d, std::string s) : dst {d}, src {s} {}
-    virtual ~MOV(void) = default;
-    void toMIPS(std::ostream& os, const SymT& assm) const;
+    static const Opcode CODE = OP_MOV;
+    Symb dst;
+    Symb src;
+    MOV(Symb d, Symb s) : dst {d}, src {s} {}
+    void toMIPS(AsmOut& os, const SymT& assm) const;
+    void toX86(AsmOut& os, const SymT& assm) const;
+    void toLLVM(LLVMOut& out, const SymT& assm) const;
+    void toIntp(IntpOut& out, const SymT& assm) const;
+    void toSPIM(SpimOut& out, const SymT& assm) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
+    Opnds dsts(void) { return {&dst}; }
 };
 
-class ADD : public INST {
+class ADD : public Oper {
 public:
-    std::string dst;
-    std::string src1;
-    std::string src2;
-    ADD(std::string d, std::string s1, std::string s2) : dst {d}, src1 {s1}, src2 {s2} {}
-    virtual ~ADD(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_ADD;
+    Symb dst;
+    Symb src1;
+    Symb src2;
+    ADD(Symb d, Symb s1, Symb s2) : dst {d}, src1 {s1}, src2 {s2} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src1,&src2}; }
+    Opnds dsts(void) { return {&dst}; }
 };
 
-class SUB : public INST {
+class SUB : public Oper {
 public:
-    std::string dst;
-    std::string src1;
-    std::string src2;
-    SUB(std::string d, std::string s1, std::string s2) : dst {d}, src1 {s1}, src2 {s2} {}
-    virtual ~SUB(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_SUB;
+    Symb dst;
+    Symb src1;
+    Symb src2;
+    SUB(Symb d, Symb s1, Symb s2) : dst {d}, src1 {s1}, src2 {s2} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src1,&src2}; }
+    Opnds dsts(void) { return {&dst}; }
 };
 
-class MUL : public INST {
+class MUL : public Oper {
 public:
-    std::string dst;
-    std::string src1;
-    std::string src2;
-    MUL(std::string d, std::string s1, std::string s2) : dst {d}, src1 {s1}, src2 {s2} {}
-    virtual ~MUL(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_MUL;
+    Symb dst;
+    Symb src1;
+    Symb src2;
+    MUL(Symb d, Symb s1, Symb s2) : dst {d}, src1 {s1}, src2 {s2} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src1,&src2}; }
+    Opnds dsts(void) { return {&dst}; }
 };
 
-class DIV : public INST {
+class DIV : public Oper {
 public:
-    std::string dst;
-    std::string src1;
-    std::string src2;
-    DIV(std::string d, std::string s1, std::string s2) : dst {d}, src1 {s1}, src2 {s2} {}
-    virtual ~DIV(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_DIV;
+    Symb dst;
+    Symb src1;
+    Symb src2;
+    DIV(Symb d, Symb s1, Symb s2) : dst {d}, src1 {s1}, src2 {s2} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src1,&src2}; }
+    Opnds dsts(void) { return {&dst}; }
 };
 
-class MOD : public INST {
+class MOD : public Oper {
 public:
-    std::string dst;
-    std::string src1;
-    std::string src2;
-    MOD(std::string d, std::string s1, std::string s2) : dst {d}, src1 {s1}, src2 {s2} {}
-    virtual ~MOD(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_MOD;
+    Symb dst;
+    Symb src1;
+    Symb src2;
+    MOD(Symb d, Symb s1, Symb s2) : dst {d}, src1 {s1}, src2 {s2} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src1,&src2}; }
+    Opnds dsts(void) { return {&dst}; }
 };
 
-class NOP : public INST {
+class NOP : public Oper {
 public:
+    static const Opcode CODE = OP_NOP;
     NOP(void) { } 
-    virtual ~NOP(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
 };
 
 
+//
+// Pseudo-instructions with an immediate operand. These are chosen by
+// the lowering pass (see `dwislpy-lowr.cc`) when an operand of one of
+// the instructions above is a known constant.
+//
+//   ADDI d,s,v  - sums a temporary and a 16-bit value.
+//   ADDIU d,s,v - the same, but wraps around on overflow instead of
+//                 trapping like ADDI. Only the compiler's own values
+//                 (see `dwislpy-loop.cc`) are summed with it.
+//   SLTI d,s,v  - sets d to whether s < v, for a 16-bit value v.
+//   MULP d,s,k  - multiplies by 2^k.
+//   DIVP d,s,k  - divides by 2^k, truncating towards zero like DIV.
+//   MODP d,s,k  - remainder of dividing by 2^k, taking the sign of s
+//                 like MOD.
+//
+class ADDI : public Oper {
+public:
+    static const Opcode CODE = OP_ADDI;
+    Symb dst;
+    Symb src;
+    int val;
+    ADDI(Symb d, Symb s, int v) : dst {d}, src {s}, val {v} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
+    Opnds dsts(void) { return {&dst}; }
+};
+
+class ADDIU : public Oper {
+public:
+    static const Opcode CODE = OP_ADDIU;
+    Symb dst;
+    Symb src;
+    int val;
+    ADDIU(Symb d, Symb s, int v) : dst {d}, src {s}, val {v} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
+    Opnds dsts(void) { return {&dst}; }
+};
+
+class SLTI : public Oper {
+public:
+    static const Opcode CODE = OP_SLTI;
+    Symb dst;
+    Symb src;
+    int val;
+    SLTI(Symb d, Symb s, int v) : dst {d}, src {s}, val {v} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
+    Opnds dsts(void) { return {&dst}; }
+};
+
+class MULP : public Oper {
+public:
+    static const Opcode CODE = OP_MULP;
+    Symb dst;
+    Symb src;
+    int val;
+    MULP(Symb d, Symb s, int v) : dst {d}, src {s}, val {v} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
+    Opnds dsts(void) { return {&dst}; }
+};
+
+class DIVP : public Oper {
+public:
+    static const Opcode CODE = OP_DIVP;
+    Symb dst;
+    Symb src;
+    int val;
+    DIVP(Symb d, Symb s, int v) : dst {d}, src {s}, val {v} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
+    Opnds dsts(void) { return {&dst}; }
+};
+
+class MODP : public Oper {
+public:
+    static const Opcode CODE = OP_MODP;
+    Symb dst;
+    Symb src;
+    int val;
+    MODP(Symb d, Symb s, int v) : dst {d}, src {s}, val {v} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
+    Opnds dsts(void) { return {&dst}; }
+};
+
+//
+// Pseudo-instructions that compute a bool (0 or 1) without branching.
+//
+//   SLT d,s1,s2 - sets d to whether s1 < s2.
+//   SLE d,s1,s2 - sets d to whether s1 <= s2.
+//   SEQ d,s1,s2 - sets d to whether s1 == s2.
+//   AND d,s1,s2 - sets d to the conjunction of two bools.
+//   OR  d,s1,s2 - sets d to the disjunction of two bools.
+//   NOT d,s     - sets d to the negation of a bool.
+//
+class SLT : public Oper {
+public:
+    static const Opcode CODE = OP_SLT;
+    Symb dst;
+    Symb src1;
+    Symb src2;
+    SLT(Symb d, Symb s1, Symb s2) : dst {d}, src1 {s1}, src2 {s2} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src1,&src2}; }
+    Opnds dsts(void) { return {&dst}; }
+};
+
+class SLE : public Oper {
+public:
+    static const Opcode CODE = OP_SLE;
+    Symb dst;
+    Symb src1;
+    Symb src2;
+    SLE(Symb d, Symb s1, Symb s2) : dst {d}, src1 {s1}, src2 {s2} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src1,&src2}; }
+    Opnds dsts(void) { return {&dst}; }
+};
+
+class SEQ : public Oper {
+public:
+    static const Opcode CODE = OP_SEQ;
+    Symb dst;
+    Symb src1;
+    Symb src2;
+    SEQ(Symb d, Symb s1, Symb s2) : dst {d}, src1 {s1}, src2 {s2} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src1,&src2}; }
+    Opnds dsts(void) { return {&dst}; }
+};
+
+class AND : public Oper {
+public:
+    static const Opcode CODE = OP_AND;
+    Symb dst;
+    Symb src1;
+    Symb src2;
+    AND(Symb d, Symb s1, Symb s2) : dst {d}, src1 {s1}, src2 {s2} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src1,&src2}; }
+    Opnds dsts(void) { return {&dst}; }
+};
+
+class OR : public Oper {
+public:
+    static const Opcode CODE = OP_OR;
+    Symb dst;
+    Symb src1;
+    Symb src2;
+    OR(Symb d, Symb s1, Symb s2) : dst {d}, src1 {s1}, src2 {s2} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src1,&src2}; }
+    Opnds dsts(void) { return {&dst}; }
+};
+
+class NOT : public Oper {
+public:
+    static const Opcode CODE = OP_NOT;
+    Symb dst;
+    Symb src;
+    NOT(Symb d, Symb s) : dst {d}, src {s} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
+    Opnds dsts(void) { return {&dst}; }
+};
+
 //
 // Pseudo-instructions for jumping around within the code.
 //
 //   LBL l              - labels a series of pseudo-instructions
 //   JMP l              - jump unconditionally
 //   BCN cn,s1,s2,lt,lf - branch according to a condition
-//                        cn is "lt", "eq", "le"
+//                        cn is LT, EQ, LE, GT, GE, NE
 //   BCZ cn,s,lt,lf - branch according to a comparison against 0
-//                        cn is "ltz", "eqz", "lez"
+//                        cn is LTZ, EQZ, LEZ, GTZ, GEZ, NEZ
+//
+// A BCN or BCZ whose `lf` is empty falls through to the next instruction
+// when its condition is false. Block layout (see `dwislpy-layo.cc`)
+// produces these for branches placed just before their `lf` code.
 //
-class LBL : public INST {
+class LBL : public Oper {
 public:
-    std::string lbl;
-    LBL(std::string l) : lbl {l} {}
-    virtual ~LBL(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_LBL;
+    Labl lbl;
+    LBL(Labl l) : lbl {l} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
 };
 
-class BCN : public INST {
+class BCN : public Oper {
 public:
-    std::string cndn; // One of "lt", "eq", "le"
-    std::string src1;
-    std::string src2;
-    std::string lblt;
-    std::string lblf;
-    BCN(std::string cn, std::string  s1, std::string s2,
-        std::string lt, std::string lf) :
+    static const Opcode CODE = OP_BCN;
+    Cndn cndn; // e.g. LT, EQ, LE
+    Symb src1;
+    Symb src2;
+    Labl lblt;
+    Labl lblf;
+    BCN(Cndn cn, Symb s1, Symb s2, Labl lt, Labl lf) :
         cndn {cn}, src1 {s1}, src2 {s2}, lblt {lt}, lblf {lf} {}
-    virtual ~BCN(void) = default;
-    virtual void toMIPS(std::ostream& os, const SymT& symt) const;
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src1,&src2}; }
+    Jmps jmps(void) const {
+        if (lblf.empty()) return {lblt};
+        return {lblt,lblf};
+    }
+    bool fall(void) const { return lblf.empty(); }
 };
 
-class BCZ : public INST {
+class BCZ : public Oper {
 public:
-    std::string cndn; // One of "ltz", "eqz", "lez"
-    std::string src;
-    std::string lblt;
-    std::string lblf;
-    BCZ(std::string cn, std::string  s, std::string lt, std::string lf) :
+    static const Opcode CODE = OP_BCZ;
+    Cndn cndn; // e.g. LTZ, EQZ, LEZ
+    Symb src;
+    Labl lblt;
+    Labl lblf;
+    BCZ(Cndn cn, Symb s, Labl lt, Labl lf) :
         cndn {cn}, src {s}, lblt {lt}, lblf {lf} {}
-    virtual ~BCZ(void) = default;
-    virtual void toMIPS(std::ostream& os, const SymT& symt) const;
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
+    Jmps jmps(void) const {
+        if (lblf.empty()) return {lblt};
+        return {lblt,lblf};
+    }
+    bool fall(void) const { return lblf.empty(); }
 };
 
-class JMP : public INST {
+class JMP : public Oper {
 public:
-    std::string lbl;
-    JMP(std::string l) : lbl {l} {}
-    virtual ~JMP(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_JMP;
+    Labl lbl;
+    JMP(Labl l) : lbl {l} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Jmps jmps(void) const { return {lbl}; }
+    bool fall(void) const { return false; }
 };
 
 //
@@ -224,26 +693,43 @@ public:
 // LEAVE - takes down frame; returns
 // 
 //
-class ENTER : public INST {
+class ENTER : public Oper {
 public:
+    static const Opcode CODE = OP_ENTER;
     ENTER(void) {}
-    virtual ~ENTER(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
 };
 
-class RTN : public INST {
+class RTN : public Oper {
 public:
-    std::string src;
-    RTN(std::string s) : src {s} {}
-    virtual ~RTN(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_RTN;
+    Symb src;
+    RTN(Symb s) : src {s} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
 };
 
-class LEAVE : public INST {
+class LEAVE : public Oper {
 public:
+    static const Opcode CODE = OP_LEAVE;
     LEAVE(void) {}
-    virtual ~LEAVE(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    bool fall(void) const { return false; }
 };
 
 //
@@ -252,31 +738,65 @@ public:
 // ARG i,s - sets the i-th argument for a call
 // CLL l   - calls the labelled function code
 // RTV d   - gets the returned value
+// TCLL l  - takes down the frame, like LEAVE, then jumps to the
+//           labelled function code, which returns to this function's
+//           caller. Used for calls in tail position.
 // 
 //
-class ARG : public INST {
+class ARG : public Oper {
 public:
+    static const Opcode CODE = OP_ARG;
     int idx;
-    std::string src;
-    ARG(int i, std::string s) : idx {i}, src {s} {}
-    virtual ~ARG(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    Symb src;
+    ARG(int i, Symb s) : idx {i}, src {s} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
+};
+
+class RTV : public Oper {
+public:
+    static const Opcode CODE = OP_RTV;
+    Symb dst;
+    RTV(Symb d) : dst {d} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds dsts(void) { return {&dst}; }
 };
 
-class RTV : public INST {
+class CLL : public Oper {
 public:
-    std::string dst;
-    RTV(std::string d) : dst {d} {}
-    virtual ~RTV(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_CLL;
+    Labl lbl;
+    CLL(Labl l) : lbl {l} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
 };
 
-class CLL : public INST {
+class TCLL : public Oper {
 public:
-    std::string lbl;
-    CLL(std::string l) : lbl {l} {}
-    virtual ~CLL(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_TCLL;
+    Labl lbl;
+    TCLL(Labl l) : lbl {l} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    bool fall(void) const { return false; }
 };
 
 //
@@ -287,42 +807,178 @@ public:
 // PTS s - Outputs a string sitting at an address s.
 //
 //
-class GTI : public INST {
+class GTI : public Oper {
 public:
-    std::string dst;
-    GTI(std::string dest) : dst {dest} {} 
-    virtual ~GTI(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_GTI;
+    Symb dst;
+    GTI(Symb dest) : dst {dest} {} 
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds dsts(void) { return {&dst}; }
 };
 
-class PTI : public INST {
+class PTI : public Oper {
 public:
-    std::string src;
-    PTI(std::string s) : src {s} { } 
-    virtual ~PTI(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_PTI;
+    Symb src;
+    PTI(Symb s) : src {s} { } 
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
 };
 
-class PTS : public INST {
+class PTS : public Oper {
 public:
-    std::string src;
-    PTS(std::string srce) : src {srce} { } 
-    virtual ~PTS(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_PTS;
+    Symb src;
+    PTS(Symb srce) : src {srce} { } 
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void) { return {&src}; }
 };
 
 
 //
-// Pseudo-instructions for commenting the generated code.
+// Pseudo-instructions for commenting the generated code. The text of
+// a comment is interned like a label.
 //
-class CMT : public INST {
+class CMT : public Oper {
 public:
-    std::string msg;
-    CMT(std::string m) : msg {m} {}
-    virtual ~CMT(void) = default;
-    void toMIPS(std::ostream& os, const SymT& symt) const;
+    static const Opcode CODE = OP_CMT;
+    Labl msg;
+    CMT(Labl m) : msg {m} {}
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
 };
 
 
-#endif
+class INST {
+public:
+    Opcode code;
+    template <class T, class = decltype(T::CODE)>
+    INST(const T& op) : code {T::CODE} {
+        ::new (static_cast<void*>(&body)) T {op};
+    }
+    template <class T>
+    T* as(void) {
+        if (code != T::CODE) return nullptr;
+        return std::launder(reinterpret_cast<T*>(&body));
+    }
+    template <class T>
+    const T* as(void) const {
+        if (code != T::CODE) return nullptr;
+        return std::launder(reinterpret_cast<const T*>(&body));
+    }
+    void toMIPS(AsmOut& os, const SymT& symt) const;
+    void toX86(AsmOut& os, const SymT& symt) const;
+    void toLLVM(LLVMOut& out, const SymT& symt) const;
+    void toIntp(IntpOut& out, const SymT& symt) const;
+    void toSPIM(SpimOut& out, const SymT& symt) const;
+    void dump(std::ostream& os) const;
+    Opnds srcs(void);
+    Opnds dsts(void);
+    Opnds srcs(void) const { return const_cast<INST*>(this)->srcs(); }
+    Opnds dsts(void) const { return const_cast<INST*>(this)->dsts(); }
+    Jmps jmps(void) const;
+    bool fall(void) const;
+private:
+    union Body {
+        Body(void) { }
+        SET set_; STL stl_; MOV mov_; ADD add_; SUB sub_; MUL mul_;
+        DIV div_; MOD mod_; NOP nop_;
+        ADDI addi_; ADDIU addiu_; SLTI slti_; MULP mulp_; DIVP divp_;
+        MODP modp_;
+        SLT slt_; SLE sle_; SEQ seq_; AND and_; OR or_; NOT not_;
+        LBL lbl_; BCN bcn_; BCZ bcz_; JMP jmp_;
+        ENTER enter_; RTN rtn_; LEAVE leave_;
+        ARG arg_; RTV rtv_; CLL cll_; TCLL tcll_;
+        GTI gti_; PTI pti_; PTS pts_; CMT cmt_;
+    } body;
+    template <class I, class F>
+    static auto visit(I& inst, F f);
+};
 
+static_assert(std::is_trivially_copyable<INST>::value,
+              "INST is copied as plain bytes.");
+
+//
+// INST::visit(inst,f)
+//
+// Call `f` on the op held by `inst`.
+//
+template <class I, class F>
+auto INST::visit(I& inst, F f) {
+    switch (inst.code) {
+    case OP_SET:   return f(*inst.template as<SET>());
+    case OP_STL:   return f(*inst.template as<STL>());
+    case OP_MOV:   return f(*inst.template as<MOV>());
+    case OP_ADD:   return f(*inst.template as<ADD>());
+    case OP_SUB:   return f(*inst.template as<SUB>());
+    case OP_MUL:   return f(*inst.template as<MUL>());
+    case OP_DIV:   return f(*inst.template as<DIV>());
+    case OP_MOD:   return f(*inst.template as<MOD>());
+    case OP_NOP:   return f(*inst.template as<NOP>());
+    case OP_ADDI:  return f(*inst.template as<ADDI>());
+    case OP_ADDIU: return f(*inst.template as<ADDIU>());
+    case OP_SLTI:  return f(*inst.template as<SLTI>());
+    case OP_MULP:  return f(*inst.template as<MULP>());
+    case OP_DIVP:  return f(*inst.template as<DIVP>());
+    case OP_MODP:  return f(*inst.template as<MODP>());
+    case OP_SLT:   return f(*inst.template as<SLT>());
+    case OP_SLE:   return f(*inst.template as<SLE>());
+    case OP_SEQ:   return f(*inst.template as<SEQ>());
+    case OP_AND:   return f(*inst.template as<AND>());
+    case OP_OR:    return f(*inst.template as<OR>());
+    case OP_NOT:   return f(*inst.template as<NOT>());
+    case OP_LBL:   return f(*inst.template as<LBL>());
+    case OP_BCN:   return f(*inst.template as<BCN>());
+    case OP_BCZ:   return f(*inst.template as<BCZ>());
+    case OP_JMP:   return f(*inst.template as<JMP>());
+    case OP_ENTER: return f(*inst.template as<ENTER>());
+    case OP_RTN:   return f(*inst.template as<RTN>());
+    case OP_LEAVE: return f(*inst.template as<LEAVE>());
+    case OP_ARG:   return f(*inst.template as<ARG>());
+    case OP_RTV:   return f(*inst.template as<RTV>());
+    case OP_CLL:   return f(*inst.template as<CLL>());
+    case OP_TCLL:  return f(*inst.template as<TCLL>());
+    case OP_GTI:   return f(*inst.template as<GTI>());
+    case OP_PTI:   return f(*inst.template as<PTI>());
+    case OP_PTS:   return f(*inst.template as<PTS>());
+    case OP_CMT:   break;
+    }
+    return f(*inst.template as<CMT>());
+}
+
+inline Opnds INST::srcs(void) {
+    return visit(*this, [](auto& op) { return op.srcs(); });
+}
+
+inline Opnds INST::dsts(void) {
+    return visit(*this, [](auto& op) { return op.dsts(); });
+}
+
+inline Jmps INST::jmps(void) const {
+    return visit(*this, [](const auto& op) { return op.jmps(); });
+}
+
+inline bool INST::fall(void) const {
+    return visit(*this, [](const auto& op) { return op.fall(); });
+}
+
+#endif
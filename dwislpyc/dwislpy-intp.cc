@@ -0,0 +1,674 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include "dwislpy-inst.hh"
+#include "dwislpy-ast.hh"
+#include "dwislpy-check.hh"
+#include "dwislpy-util.hh"
+#include "dwislpy-jobs.hh"
+#include "dwislpy-pass.hh"
+#include "dwislpy-intp.hh"
+
+//
+// dwislpy-intp.cc
+//
+// This gives the code for running a program's IR directly. At the top
+// level, it defines
+//
+//     Prgm::interpret
+//
+// which relies on `lower_defn_intp` to lower the IR of every `def` and
+// of the `main` script, and then on `run_intp` to run them. See
+// `dwislpy-intp.hh` for how the lowered code is laid out.
+//
+
+// lower_defn_intp(out,symt,code,passes)
+//
+// Lower `code` into the ops of `out`. This optimizes `code` with
+// `passes` as `compile_defn` does, gives the formals the first slots,
+// and then converts each IR instruction (using `toIntp`). The jumps
+// amongst the ops are resolved once all of them have been made.
+//
+void lower_defn_intp(IntpOut& out, SymT& symt, INST_vec& code,
+                     PassManager& passes) {
+
+    // Optimize the IR (see `dwislpy-pass.hh`).
+    passes.run(symt,code);
+
+    for (unsigned int i = 0; i < symt.get_frmls_size(); i++) {
+        out.slot(symt.get_frml_symb(i));
+    }
+    for (const INST& inst : code) {
+        inst.toIntp(out,symt);
+    }
+    for (std::pair<int,Labl> jump : out.jumps) {
+        out.ops[jump.first].val = out.labels.at(jump.second);
+    }
+    for (std::pair<int,Labl> next : out.nexts) {
+        out.ops[next.first].next = out.labels.at(next.second);
+    }
+}
+
+// add_strings(table,strgs,symt)
+//
+// Add the characters of the string constants kept by `symt` to `table`,
+// and their numbers to `strgs` under their labels.
+//
+static void add_strings(std::vector<const char*>& table,
+                        std::unordered_map<std::string,Word>& strgs,
+                        const SymT& symt) {
+    for (const std::pair<const Name,std::string>& lbl_strg : symt.strings) {
+        strgs[lbl_strg.first] = STRG_BASE + table.size();
+        table.push_back(lbl_strg.second.c_str());
+    }
+}
+
+// add_pool(table,strgs,pool)
+//
+// The same, for the string constants of `pool`.
+//
+static void add_pool(std::vector<const char*>& table,
+                     std::unordered_map<std::string,Word>& strgs,
+                     const StrgPool& pool) {
+    for (const std::pair<const std::string,std::string>& strg_lbl : pool.labels) {
+        strgs[strg_lbl.second] = STRG_BASE + table.size();
+        table.push_back(strg_lbl.first.c_str());
+    }
+}
+
+// Prgm::interpret(passes)
+//
+// Run the program's IR, optimized by `passes`. Like `Prgm::compile`,
+// this translates the program and runs the whole-program passes, and
+// then optimizes and lowers each `def` and the `main` script on as many
+// threads as `passes` says. The ops of each are put end to end, the
+// jumps amongst them moved along with them, and the calls and string
+// constants resolved. Then they're run from `main`.
+//
+void Prgm::interpret(PassManager& passes) {
+
+    // Translate the AST to IR, then run the whole-program passes.
+    //
+    trans(passes.get_jobs());
+    std::unordered_set<std::string> called = passes.run(defs,main_symt,main_code);
+
+    // Lower `main` and each `def` that's still called, each into its
+    // own ops.
+    //
+    std::vector<Defn_ptr> defns {};
+    for (std::pair<Name,Defn_ptr> dfpr : defs) {
+        if (called.count(dfpr.first) > 0) {
+            defns.push_back(dfpr.second);
+        } // Otherwise every call to it was inlined.
+    }
+    std::vector<std::unique_ptr<IntpOut>> outs {};
+    for (unsigned int i = 0; i <= defns.size(); i++) {
+        outs.push_back(std::unique_ptr<IntpOut> {new IntpOut {}});
+    }
+    run_jobs(outs.size(), passes.get_jobs(), [&](int i) {
+        if (i == 0) {
+            lower_defn_intp(*outs[i],main_symt,main_code,passes);
+        } else {
+            Defn_ptr defn = defns[i-1];
+            lower_defn_intp(*outs[i],defn->symt,defn->code,passes);
+        }
+    });
+
+    // Put the ops end to end, noting where each function starts, its
+    // number of slots, and its number of formals.
+    //
+    struct Func { int entry; int slots; int frmls; };
+    std::unordered_map<std::string,Func> funcs {};
+    std::vector<IntpOp> ops {};
+    for (unsigned int i = 0; i < outs.size(); i++) {
+        IntpOut& out = *outs[i];
+        int base = ops.size();
+        for (IntpOp op : out.ops) {
+            if (op.code >= I_BLT && op.code <= I_JMP) {
+                op.val += base;
+            }
+            if (op.code >= I_BLT && op.code <= I_BGEZ) {
+                op.next += base;
+            }
+            ops.push_back(op);
+        }
+        Name name = i == 0 ? "main" : defns[i-1]->name;
+        SymT& symt = i == 0 ? main_symt : defns[i-1]->symt;
+        funcs[name] = Func {base + out.labels.at(Labl::of(name)), (int)out.slots.size(),
+                            (int)symt.get_frmls_size()};
+    }
+
+    // Resolve the calls and the string constants.
+    //
+    std::vector<const char*> table {};
+    std::unordered_map<std::string,Word> strgs {};
+    add_pool(table,strgs,*glbl_symt_ptr->get_pool());
+    add_strings(table,strgs,*glbl_symt_ptr);
+    add_strings(table,strgs,main_symt);
+    for (std::pair<Name,Defn_ptr> dfpr : defs) {
+        add_strings(table,strgs,dfpr.second->symt);
+    }
+    int base = 0;
+    for (std::unique_ptr<IntpOut>& out : outs) {
+        for (std::pair<int,Labl> call : out->calls) {
+            const std::string& name = call.second.name();
+            if (funcs.count(name) == 0) {
+                throw DwislpyError {Locn {"dwislpyc"},
+                                    "Call to unknown function " + name + "."};
+            }
+            Func func = funcs.at(name);
+            IntpOp& op = ops[base + call.first];
+            op.val = func.entry;
+            op.next = func.slots;
+            op.src1 = func.frmls;
+        }
+        for (std::pair<int,Labl> strg : out->strgs) {
+            ops[base + strg.first].val = strgs.at(strg.second.name());
+        }
+        base += out->ops.size();
+    }
+
+    Func main_func = funcs.at("main");
+    run_intp(ops,table,main_func.entry,main_func.slots);
+}
+
+//
+// run_intp(ops,strgs,entry,slots)
+//
+// Run the ops starting at the one at `entry`, in a frame with `slots`
+// slots, until that frame is left. String values are numbers into
+// `strgs`.
+//
+// Each op is handled by a case of the `switch` below, which works on
+// the slots of the frame at `fp`. The frame of the function that's
+// called next starts at `sp`, just past it. The caller's place and
+// frame are kept in `frames` during a call, and the value returned is
+// held in `rv`.
+//
+// The stack is allocated up front, and its pages are only touched as
+// it's used. There's always room past `sp` for the arguments of any
+// call, so ARG needn't check.
+//
+static const long STACK_WORDS = 1L << 24;
+
+static int32_t num(Word w) {
+    return (int32_t)w;
+}
+
+static Word wrap(uint32_t u) {
+    return (int32_t)u;
+}
+
+static void run_error(std::string msg) {
+    std::fflush(stdout);
+    throw DwislpyError {Locn {"dwislpyc"}, "Run-time error: " + msg};
+}
+
+static Word trap(Word w) {
+    if (w != (int32_t)w) {
+        run_error("arithmetic overflow.");
+    }
+    return w;
+}
+
+void run_intp(const std::vector<IntpOp>& ops,
+              const std::vector<const char*>& strgs, int entry, int slots) {
+
+    struct Frame { const IntpOp* pc; Word* fp; };
+    std::vector<Frame> frames {};
+
+    int room = 0;
+    for (const IntpOp& op : ops) {
+        if (op.code == I_ARG && op.dst >= room) {
+            room = op.dst + 1;
+        }
+    }
+    std::unique_ptr<Word,void(*)(void*)> stack {
+        (Word*)std::calloc(STACK_WORDS,sizeof(Word)), std::free
+    };
+    if (!stack) {
+        run_error("no room for the stack.");
+    }
+    Word* limit = stack.get() + STACK_WORDS - room;
+
+    const IntpOp* code = ops.data();
+    const IntpOp* pc = code + entry;
+    Word* fp = stack.get();
+    Word* sp = fp + slots;
+    Word rv = 0;
+    if (sp > limit) {
+        run_error("stack overflow.");
+    }
+
+    for (;;) {
+        const IntpOp& op = *pc;
+        switch (op.code) {
+        case I_SET:
+            fp[op.dst] = op.val;
+            pc++;
+            break;
+        case I_MOV:
+            fp[op.dst] = fp[op.src1];
+            pc++;
+            break;
+        case I_ADD:
+            fp[op.dst] = trap((Word)num(fp[op.src1]) + num(fp[op.src2]));
+            pc++;
+            break;
+        case I_SUB:
+            fp[op.dst] = trap((Word)num(fp[op.src1]) - num(fp[op.src2]));
+            pc++;
+            break;
+        case I_MUL:
+            fp[op.dst] = wrap((uint32_t)num(fp[op.src1]) * (uint32_t)num(fp[op.src2]));
+            pc++;
+            break;
+        case I_DIV: {
+            int32_t d = num(fp[op.src2]);
+            if (d == 0) {
+                run_error("division by 0.");
+            }
+            fp[op.dst] = d == -1 ? wrap(0u - (uint32_t)num(fp[op.src1]))
+                                 : num(fp[op.src1]) / d;
+            pc++;
+            break;
+        }
+        case I_MOD: {
+            int32_t d = num(fp[op.src2]);
+            if (d == 0) {
+                run_error("division by 0.");
+            }
+            fp[op.dst] = d == -1 ? 0 : num(fp[op.src1]) % d;
+            pc++;
+            break;
+        }
+        case I_ADDI:
+            fp[op.dst] = trap((Word)num(fp[op.src1]) + op.val);
+            pc++;
+            break;
+        case I_ADDIU:
+            fp[op.dst] = wrap((uint32_t)num(fp[op.src1]) + (uint32_t)op.val);
+            pc++;
+            break;
+        case I_SLTI:
+            fp[op.dst] = num(fp[op.src1]) < op.val;
+            pc++;
+            break;
+        case I_MULP:
+            fp[op.dst] = wrap((uint32_t)num(fp[op.src1]) << op.val);
+            pc++;
+            break;
+        case I_DIVP:
+            fp[op.dst] = (Word)num(fp[op.src1]) / ((Word)1 << op.val);
+            pc++;
+            break;
+        case I_MODP:
+            fp[op.dst] = (Word)num(fp[op.src1]) % ((Word)1 << op.val);
+            pc++;
+            break;
+        case I_SLT:
+            fp[op.dst] = num(fp[op.src1]) < num(fp[op.src2]);
+            pc++;
+            break;
+        case I_SLE:
+            fp[op.dst] = num(fp[op.src1]) <= num(fp[op.src2]);
+            pc++;
+            break;
+        case I_SEQ:
+            fp[op.dst] = fp[op.src1] == fp[op.src2];
+            pc++;
+            break;
+        case I_AND:
+            fp[op.dst] = fp[op.src1] & fp[op.src2];
+            pc++;
+            break;
+        case I_OR:
+            fp[op.dst] = fp[op.src1] | fp[op.src2];
+            pc++;
+            break;
+        case I_NOT:
+            fp[op.dst] = fp[op.src1] ^ 1;
+            pc++;
+            break;
+        case I_BLT:
+            pc = code + (num(fp[op.src1]) < num(fp[op.src2]) ? op.val : op.next);
+            break;
+        case I_BLE:
+            pc = code + (num(fp[op.src1]) <= num(fp[op.src2]) ? op.val : op.next);
+            break;
+        case I_BEQ:
+            pc = code + (fp[op.src1] == fp[op.src2] ? op.val : op.next);
+            break;
+        case I_BNE:
+            pc = code + (fp[op.src1] != fp[op.src2] ? op.val : op.next);
+            break;
+        case I_BGT:
+            pc = code + (num(fp[op.src1]) > num(fp[op.src2]) ? op.val : op.next);
+            break;
+        case I_BGE:
+            pc = code + (num(fp[op.src1]) >= num(fp[op.src2]) ? op.val : op.next);
+            break;
+        case I_BLTZ:
+            pc = code + (num(fp[op.src1]) < 0 ? op.val : op.next);
+            break;
+        case I_BLEZ:
+            pc = code + (num(fp[op.src1]) <= 0 ? op.val : op.next);
+            break;
+        case I_BEQZ:
+            pc = code + (fp[op.src1] == 0 ? op.val : op.next);
+            break;
+        case I_BNEZ:
+            pc = code + (fp[op.src1] != 0 ? op.val : op.next);
+            break;
+        case I_BGTZ:
+            pc = code + (num(fp[op.src1]) > 0 ? op.val : op.next);
+            break;
+        case I_BGEZ:
+            pc = code + (num(fp[op.src1]) >= 0 ? op.val : op.next);
+            break;
+        case I_JMP:
+            pc = code + op.val;
+            break;
+        case I_ARG:
+            sp[op.dst] = fp[op.src1];
+            pc++;
+            break;
+        case I_CLL:
+            frames.push_back(Frame {pc + 1, fp});
+            fp = sp;
+            sp = fp + op.next;
+            if (sp > limit) {
+                run_error("stack overflow.");
+            }
+            pc = code + op.val;
+            break;
+        case I_TCLL:
+            // Move the arguments down into this frame, and reuse it.
+            for (int i = 0; i < op.src1; i++) {
+                fp[i] = sp[i];
+            }
+            sp = fp + op.next;
+            if (sp > limit) {
+                run_error("stack overflow.");
+            }
+            pc = code + op.val;
+            break;
+        case I_RTV:
+            fp[op.dst] = rv;
+            pc++;
+            break;
+        case I_RTN:
+            rv = fp[op.src1];
+            pc++;
+            break;
+        case I_LEAVE:
+            if (frames.empty()) {
+                std::fflush(stdout);
+                return;
+            }
+            sp = fp;
+            fp = frames.back().fp;
+            pc = frames.back().pc;
+            frames.pop_back();
+            break;
+        case I_GTI: {
+            char line[256];
+            std::fflush(stdout);
+            if (std::fgets(line, sizeof(line), stdin) == nullptr) {
+                fp[op.dst] = 0;
+            } else {
+                fp[op.dst] = (int32_t)std::strtol(line, nullptr, 10);
+            }
+            pc++;
+            break;
+        }
+        case I_PTI:
+            std::printf("%d", num(fp[op.src1]));
+            pc++;
+            break;
+        case I_PTS: {
+            Word s = fp[op.src1] - STRG_BASE;
+            if (s < 0 || s >= (Word)strgs.size()) {
+                run_error("bad string address.");
+            }
+            std::fputs(strgs[s], stdout);
+            pc++;
+            break;
+        }
+        }
+    }
+}
+
+//
+// INST::toIntp(out,symt)
+//
+// Method for lowering a pseudo-instruction into the ops of the
+// interpreter, as `INST::toMIPS` does into MIPS32 code. Most become a
+// single op. Jumps, calls, and string constants are noted in `out` so
+// that they can be resolved later.
+//
+// We define this method for each subclass of INST.
+//
+
+//
+// binary(out,code,dst,src1,src2)
+//
+// Shared by the instructions with three slots.
+//
+static void binary(IntpOut& out, IntpCode code,
+                   Symb dst, Symb src1, Symb src2) {
+    IntpOp op {code};
+    op.dst = out.slot(dst);
+    op.src1 = out.slot(src1);
+    op.src2 = out.slot(src2);
+    out.emit(op);
+}
+//
+// unary(out,code,dst,src,val)
+//
+// Shared by the instructions with two slots and maybe an immediate.
+//
+static void unary(IntpOut& out, IntpCode code,
+                  Symb dst, Symb src, int val = 0) {
+    IntpOp op {code};
+    op.dst = out.slot(dst);
+    op.src1 = out.slot(src);
+    op.val = val;
+    out.emit(op);
+}
+//
+void ENTER::toIntp([[maybe_unused]] IntpOut& out,
+                   [[maybe_unused]] const SymT& symt) const {
+    // The arguments were placed in the formals' slots by the ARGs.
+}
+//
+void LEAVE::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.emit(IntpOp {I_LEAVE});
+}
+//
+void TCLL::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.calls.push_back({out.emit(IntpOp {I_TCLL}),lbl});
+}
+//
+void SET::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    IntpOp op {I_SET};
+    op.dst = out.slot(dst);
+    op.val = val;
+    out.emit(op);
+}
+//
+void STL::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    IntpOp op {I_SET};
+    op.dst = out.slot(dst);
+    out.strgs.push_back({out.emit(op),lbl});
+}
+//
+void MOV::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    unary(out,I_MOV,dst,src);
+}
+//
+void RTV::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    IntpOp op {I_RTV};
+    op.dst = out.slot(dst);
+    out.emit(op);
+}
+//
+void GTI::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    IntpOp op {I_GTI};
+    op.dst = out.slot(dst);
+    out.emit(op);
+}
+//
+void NOP::toIntp([[maybe_unused]] IntpOut& out,
+                 [[maybe_unused]] const SymT& symt) const {
+}
+//
+void PTI::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    IntpOp op {I_PTI};
+    op.src1 = out.slot(src);
+    out.emit(op);
+}
+//
+void PTS::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    IntpOp op {I_PTS};
+    op.src1 = out.slot(src);
+    out.emit(op);
+}
+//
+void ADD::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    binary(out,I_ADD,dst,src1,src2);
+}
+//
+void SUB::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    binary(out,I_SUB,dst,src1,src2);
+}
+//
+void MUL::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    binary(out,I_MUL,dst,src1,src2);
+}
+//
+void DIV::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    binary(out,I_DIV,dst,src1,src2);
+}
+//
+void MOD::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    binary(out,I_MOD,dst,src1,src2);
+}
+//
+// ADDI wraps around on overflow here, the same as ADDIU.
+//
+void ADDI::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    unary(out,I_ADDI,dst,src,val);
+}
+//
+void ADDIU::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    unary(out,I_ADDIU,dst,src,val);
+}
+//
+void SLTI::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    unary(out,I_SLTI,dst,src,val);
+}
+//
+void MULP::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    unary(out,I_MULP,dst,src,val);
+}
+//
+void DIVP::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    unary(out,I_DIVP,dst,src,val);
+}
+//
+void MODP::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    unary(out,I_MODP,dst,src,val);
+}
+//
+void SLT::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    binary(out,I_SLT,dst,src1,src2);
+}
+//
+void SLE::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    binary(out,I_SLE,dst,src1,src2);
+}
+//
+void SEQ::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    binary(out,I_SEQ,dst,src1,src2);
+}
+//
+void AND::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    binary(out,I_AND,dst,src1,src2);
+}
+//
+void OR::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    binary(out,I_OR,dst,src1,src2);
+}
+//
+void NOT::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    unary(out,I_NOT,dst,src);
+}
+//
+void RTN::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    IntpOp op {I_RTN};
+    op.src1 = out.slot(src);
+    out.emit(op);
+}
+//
+// branch(out,op,lblt,lblf)
+//
+// Emits the branch `op` to `lblt`, or else to `lblf`. If `lblf` is
+// empty the branch falls through to the next op.
+//
+static void branch(IntpOut& out, IntpOp op, Labl lblt, Labl lblf) {
+    int at = out.emit(op);
+    out.jump(at,lblt);
+    if (lblf.empty()) {
+        out.ops[at].next = at + 1;
+    } else {
+        out.jump(at,lblf,true);
+    }
+}
+//
+void BCN::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    static const IntpCode codes[] { // In the order of `Cndn`.
+        I_BLT, I_BLE, I_BGT, I_BGE, I_BEQ, I_BNE
+    };
+    IntpOp op {codes[(int)cndn]};
+    op.src1 = out.slot(src1);
+    op.src2 = out.slot(src2);
+    branch(out,op,lblt,lblf);
+}
+//
+void BCZ::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    static const IntpCode codes[] { // In the order of `Cndn`.
+        I_BLTZ, I_BLEZ, I_BGTZ, I_BGEZ, I_BEQZ, I_BNEZ
+    };
+    IntpOp op {codes[(int)cndn - (int)Cndn::LTZ]};
+    op.src1 = out.slot(src);
+    branch(out,op,lblt,lblf);
+}
+//
+void JMP::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.jump(out.emit(IntpOp {I_JMP}),lbl);
+}
+//
+void CLL::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.calls.push_back({out.emit(IntpOp {I_CLL}),lbl});
+}
+//
+void LBL::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.labels[lbl] = out.ops.size();
+}
+//
+void CMT::toIntp([[maybe_unused]] IntpOut& out,
+                 [[maybe_unused]] const SymT& symt) const {
+}
+//
+void ARG::toIntp(IntpOut& out, [[maybe_unused]] const SymT& symt) const {
+    IntpOp op {I_ARG};
+    op.dst = idx;
+    op.src1 = out.slot(src);
+    out.emit(op);
+}
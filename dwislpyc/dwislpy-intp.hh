@@ -0,0 +1,162 @@
+#ifndef _DWISLPY_INTP_HH
+#define _DWISLPY_INTP_HH
+
+//
+// dwislpy-intp.hh
+//
+// The IR interpreter, used by `dwislpyc --run-ir`. It runs the IR of
+// the program, once it's been optimized, directly, rather than going
+// through MIPS32 code and SPIM or walking the AST as `Prgm::run` does.
+// No registers are allocated, and no code is generated, and so what it
+// runs is just what the passes made. The same program run with `-O0`
+// and with the passes being tested should give the same output.
+//
+// Each function's IR is first lowered, with `INST::toIntp`, into an
+// array of `IntpOp`s. Each variable and temporary gets a slot in the
+// function's frame, numbered from 0 with the formals first, and the
+// operands of each op are the numbers of these slots. Labels are
+// resolved to the positions of the ops they label once the function
+// has been lowered. The names of called functions, and the labels of
+// string constants, are resolved once every function has been lowered
+// and their arrays put end to end. LBL, ENTER, NOP, and CMT leave no
+// op behind.
+//
+// The ops are then run by `run_intp` in a single loop. A frame is a
+// run of 64-bit words on a stack of them. Integers are 32 bits wide,
+// as on MIPS32, where `add`, `sub`, and `addi` trap when they overflow
+// and `addiu`, `mul`, and the shifts wrap around. ADD, SUB, and ADDI
+// do the former, and ADDIU, MUL, and MULP the latter. The characters
+// of the string constants, which are those held by the `SymT`s and the
+// string pool, are put in a table, and a string is its place in that
+// table offset by `STRG_BASE`. Arithmetic on strings, which the IR
+// allows for `+=`, can't then give the address of anything in the
+// host. Like SPIM's data segment, `STRG_BASE` is low enough that
+// adding two strings doesn't overflow. ARG places its value straight
+// into the slot of the formal in the frame of the function about to be
+// called, which sits just past that of the caller. PTI, PTS, and GTI
+// are done with the C library's I/O, as `dwislpy-rt.c` does them.
+//
+// Dividing by 0, an ADD, SUB, or ADDI that overflows, running out of
+// stack, or printing a string that isn't in the table ends the run
+// with an error. SPIM similarly reports an arithmetic overflow for the
+// second of these, and a bad address for the last.
+//
+// * lower_defn_intp(out,symt,code,passes) - like `compile_defn`, this
+//                                           optimizes `code` and then
+//                                           lowers it into `out`.
+// * run_intp(ops,strgs,entry,slots)       - runs `ops` from `entry`,
+//                                           in a frame of `slots`,
+//                                           with the table of strings
+//                                           `strgs`.
+//
+// class IntpOp
+//
+// An op of the interpreter. Which of its fields are used depends on
+// its `code`:
+//
+// * dst, src1, src2 - the slots of its operands. For ARG, `dst` is
+//                     instead the number of the argument, and for a
+//                     call `src1` is the number of formals of the
+//                     function called.
+// * val  - an integer value, a string's number, the position of the
+//          op jumped to, or the position of the first op of the
+//          function called.
+// * next - the op run after a branch that isn't taken. For a call it
+//          instead gives the number of slots of the function called.
+//
+// class IntpOut
+//
+// The writer of one function's ops, passed to `INST::toIntp`:
+//
+// * ops    - the ops so far.
+// * slots  - the number of each variable's slot, in the order they
+//            first appear.
+// * labels - the position of each label.
+// * jumps  - the ops whose `val` is still to be set to the position of
+//            a label.
+// * nexts  - the same, but for their `next`.
+// * calls  - the ops whose `val` and `next` are still to be set for the
+//            function they call.
+// * strgs  - the ops whose `val` is still to be set to the number of a
+//            string constant.
+//
+// * slot(nm)          - the slot of `nm`, giving it one if it has none.
+// * emit(op)          - adds an op, giving its position.
+// * jump(op,lbl,next) - notes that op `op` jumps to `lbl`, in its
+//                       `next` if `next` is set.
+//
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include <cstdint>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-pass.hh"
+
+typedef int64_t Word;
+
+const Word STRG_BASE = (Word)1 << 28;
+
+enum IntpCode {
+    I_SET, I_MOV, I_ADD, I_SUB, I_MUL, I_DIV, I_MOD,
+    I_ADDI, I_ADDIU, I_SLTI, I_MULP, I_DIVP, I_MODP,
+    I_SLT, I_SLE, I_SEQ, I_AND, I_OR, I_NOT,
+    I_BLT, I_BLE, I_BEQ, I_BNE, I_BGT, I_BGE,
+    I_BLTZ, I_BLEZ, I_BEQZ, I_BNEZ, I_BGTZ, I_BGEZ,
+    I_JMP, I_ARG, I_CLL, I_RTV, I_RTN, I_LEAVE, I_TCLL,
+    I_GTI, I_PTI, I_PTS
+};
+
+class IntpOp {
+public:
+    IntpCode code;
+    int dst;
+    int src1;
+    int src2;
+    int next;
+    Word val;
+    IntpOp(IntpCode c) :
+        code {c}, dst {0}, src1 {0}, src2 {0}, next {0}, val {0} { }
+};
+
+class IntpOut {
+public:
+    std::vector<IntpOp> ops;
+    std::unordered_map<Symb,int> slots;
+    std::unordered_map<Labl,int> labels;
+    std::vector<std::pair<int,Labl>> jumps;
+    std::vector<std::pair<int,Labl>> nexts;
+    std::vector<std::pair<int,Labl>> calls;
+    std::vector<std::pair<int,Labl>> strgs;
+    IntpOut(void) :
+        ops {}, slots {}, labels {}, jumps {}, nexts {}, calls {}, strgs {} { }
+    int slot(Symb nm) {
+        auto known = slots.find(nm);
+        if (known != slots.end()) {
+            return known->second;
+        }
+        int n = slots.size();
+        slots[nm] = n;
+        return n;
+    }
+    int emit(IntpOp op) {
+        ops.push_back(op);
+        return ops.size() - 1;
+    }
+    void jump(int op, Labl lbl, bool next = false) {
+        if (next) {
+            nexts.push_back({op,lbl});
+        } else {
+            jumps.push_back({op,lbl});
+        }
+    }
+};
+
+void lower_defn_intp(IntpOut& out, SymT& symt, INST_vec& code,
+                     PassManager& passes);
+void run_intp(const std::vector<IntpOp>& ops,
+              const std::vector<const char*>& strgs, int entry, int slots);
+
+#endif
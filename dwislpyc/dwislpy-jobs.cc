@@ -0,0 +1,51 @@
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include "dwislpy-jobs.hh"
+
+//
+// dwislpy-jobs.cc
+//
+// Runs jobs on several threads. See `dwislpy-jobs.hh`.
+//
+
+void run_jobs(int count, int threads, const std::function<void(int)>& job) {
+    if (threads > count) {
+        threads = count;
+    }
+    std::vector<std::exception_ptr> errors(count);
+    std::atomic<int> next {0};
+    auto work = [&]() {
+        for (int i = next++; i < count; i = next++) {
+            try {
+                job(i);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        }
+    };
+    if (threads <= 1) {
+        work();
+    } else {
+        std::vector<std::thread> pool {};
+        for (int t = 1; t < threads; t++) {
+            pool.push_back(std::thread {work});
+        }
+        work();
+        for (std::thread& thread : pool) {
+            thread.join();
+        }
+    }
+    for (std::exception_ptr error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+int default_jobs(void) {
+    int cores = std::thread::hardware_concurrency();
+    return cores > 0 ? cores : 1;
+}
@@ -0,0 +1,29 @@
+#ifndef _DWISLPY_JOBS_HH
+#define _DWISLPY_JOBS_HH
+
+//
+// dwislpy-jobs.hh
+//
+// Runs independent jobs, such as compiling each of a program's `def`s,
+// on several threads.
+//
+// * run_jobs(count,threads,job) - calls `job(i)` for each `i` from 0 up
+//   to `count`, spread over at most `threads` threads. Each thread
+//   takes the next `i` that hasn't been taken, so the jobs finish in no
+//   particular order. A job should put what it makes in a place of its
+//   own, for the caller to gather in order once `run_jobs` returns.
+//   If any jobs throw, the exception of the lowest-numbered one is
+//   thrown again once all the others have finished.
+//
+// * default_jobs() - the number of threads to use if not told, which
+//   is the number of cores.
+//
+// With one thread, the jobs are run in order on the calling thread.
+//
+
+#include <functional>
+
+void run_jobs(int count, int threads, const std::function<void(int)>& job);
+int default_jobs(void);
+
+#endif
@@ -0,0 +1,253 @@
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-cfg.hh"
+#include "dwislpy-opt.hh"
+
+//
+// dwislpy-layo.cc
+//
+// Block layout over the IR.
+//
+// The translation leaves each BCN and BCZ followed by a `j` to its false
+// label, even though that label usually comes right after it, and
+// leaves JMPs to the very next label, e.g. at the end of each `then`
+// block whose `else` was empty. This pass orders the blocks so that
+// each falls into one of its successors where it can, then cleans up
+// the jumps that ordering made unnecessary:
+//
+// * NOPs are dropped, and jumps to a block that holds nothing but a JMP
+//   are sent straight to that JMP's target instead.
+//
+// * The blocks are laid out in chains. After placing a block, the next
+//   one placed is the block it falls through to, or for a branch the
+//   target that originally followed it (else the other target), or for
+//   a JMP its target if nothing else jumps there. When no successor is
+//   left, the chain ends and the earliest unplaced block starts another.
+//
+// * Loops are rotated. A `while` loop is translated with its test at
+//   the top and a JMP back to it at the bottom, so each iteration takes
+//   a branch and a jump. When a loop's header ends by branching either
+//   into the loop or out of it, the header is held back until a block
+//   that jumps back to it has been placed, and is placed after that
+//   block instead. The loop is then entered by a jump to its test, the
+//   body falls into the test, and the test branches back to the body,
+//   so each iteration only takes the one branch.
+//
+// * A JMP to the label that follows it is dropped. A branch whose false
+//   label follows it falls through instead, and a branch whose true
+//   label follows it has its condition inverted and then falls through.
+//
+// * Labels that nothing jumps to are dropped, except the function's own.
+//
+
+//
+// thread(cfg)
+//
+// Retarget jumps to blocks that just jump elsewhere.
+//
+static void thread(CFG& cfg) {
+    auto target = [&cfg](Labl lbl) {
+        std::unordered_set<Labl> seen {};
+        while (seen.insert(lbl).second) {
+            const BBlk& blk = cfg.blocks[cfg.block_of(lbl)];
+            const JMP* jmp = blk.code.back().as<JMP>();
+            if (jmp == nullptr || blk.lbls().size()+1 != blk.code.size()) {
+                break;
+            }
+            lbl = jmp->lbl;
+        }
+        return lbl;
+    };
+    for (BBlk& blk : cfg.blocks) {
+        if (blk.code.empty()) {
+            continue;
+        }
+        INST& inst = blk.code.back();
+        if (JMP* jmp = inst.as<JMP>()) {
+            jmp->lbl = target(jmp->lbl);
+        } else if (BCN* bcn = inst.as<BCN>()) {
+            bcn->lblt = target(bcn->lblt);
+            if (!bcn->lblf.empty()) bcn->lblf = target(bcn->lblf);
+        } else if (BCZ* bcz = inst.as<BCZ>()) {
+            bcz->lblt = target(bcz->lblt);
+            if (!bcz->lblf.empty()) bcz->lblf = target(bcz->lblf);
+        }
+    }
+    cfg.link();
+}
+
+//
+// rotations(cfg)
+//
+// For each block that heads a loop and ends by branching either into
+// the loop or out of it, the block that it branches into; else -1.
+//
+static std::vector<int> rotations(CFG& cfg) {
+    cfg.dominate();
+    std::vector<int> into(cfg.blocks.size(),-1);
+    for (unsigned int b = 1; b < cfg.blocks.size(); b++) {
+        const BBlk& blk = cfg.blocks[b];
+        if (blk.code.empty() || blk.next >= 0) {
+            continue;
+        }
+        const INST& inst = blk.code.back();
+        if (!inst.as<BCN>() && !inst.as<BCZ>()) {
+            continue;
+        }
+        std::vector<bool> body = cfg.loop(b);
+        std::vector<int> ins {};
+        std::vector<int> outs {};
+        for (Labl lbl : inst.jmps()) {
+            int t = cfg.block_of(lbl);
+            if (body[t]) {
+                ins.push_back(t);
+            } else {
+                outs.push_back(t);
+            }
+        }
+        if (ins.size() == 1 && outs.size() == 1 && ins[0] != (int)b) {
+            into[b] = ins[0];
+        }
+    }
+    return into;
+}
+
+//
+// chain(cfg)
+//
+// The order in which to lay out the blocks of `cfg`.
+//
+static std::vector<int> chain(CFG& cfg) {
+    int size = cfg.blocks.size();
+    std::vector<int> into = rotations(cfg);
+    std::vector<bool> placed(size,false);
+    std::vector<bool> held(size,false);
+    std::vector<int> order {};
+    int b = 0;
+    int rest = 0;
+    while (b >= 0) {
+        if (into[b] >= 0 && !held[b] && !placed[into[b]]) {
+            held[b] = true;
+            b = into[b];
+            continue;
+        }
+        placed[b] = true;
+        order.push_back(b);
+        const BBlk& blk = cfg.blocks[b];
+        std::vector<int> prefs {};
+        if (blk.next >= 0) {
+            prefs.push_back(blk.next);
+        } else if (!blk.code.empty()) {
+            const INST& inst = blk.code.back();
+            if (const JMP* jmp = inst.as<JMP>()) {
+                int t = cfg.block_of(jmp->lbl);
+                if (cfg.blocks[t].preds.size() == 1 || held[t]) {
+                    prefs.push_back(t);
+                }
+            } else {
+                for (Labl lbl : inst.jmps()) {
+                    int t = cfg.block_of(lbl);
+                    if (t == b+1) {
+                        prefs.insert(prefs.begin(),t);
+                    } else {
+                        prefs.push_back(t);
+                    }
+                }
+            }
+        }
+        b = -1;
+        for (int p : prefs) {
+            if (!placed[p]) {
+                b = p;
+                break;
+            }
+        }
+        while (b < 0 && rest < size) {
+            if (!placed[rest] && !held[rest]) {
+                b = rest;
+            }
+            rest++;
+        }
+        for (int h = 0; b < 0 && h < size; h++) {
+            if (held[h] && !placed[h]) {
+                b = h;
+            }
+        }
+    }
+    return order;
+}
+
+//
+// layout_blocks(symt,code)
+//
+void layout_blocks(SymT& symt, INST_vec& code) {
+    INST_vec kept {};
+    for (INST& inst : code) {
+        if (!inst.as<NOP>()) {
+            kept.push_back(inst);
+        }
+    }
+    CFG cfg {kept};
+    thread(cfg);
+    cfg.prune();
+    cfg.reorder(chain(cfg));
+    INST_vec linear = cfg.linearize(symt);
+
+    // Remove the jumps to the code that follows. The labels that
+    // follow each position are gathered by scanning backwards.
+    //
+    INST_vec reversed {};
+    std::unordered_set<Labl> next {};
+    for (auto i = linear.rbegin(); i != linear.rend(); i++) {
+        INST& inst = *i;
+        if (LBL* lbl = inst.as<LBL>()) {
+            next.insert(lbl->lbl);
+            reversed.push_back(inst);
+            continue;
+        }
+        if (JMP* jmp = inst.as<JMP>()) {
+            if (next.count(jmp->lbl) > 0) {
+                continue;
+            }
+        } else if (BCN* bcn = inst.as<BCN>()) {
+            if (next.count(bcn->lblt) > 0 && !bcn->lblf.empty()) {
+                bcn->cndn = invert(bcn->cndn);
+                bcn->lblt = bcn->lblf;
+                bcn->lblf = Labl {};
+            } else if (next.count(bcn->lblf) > 0) {
+                bcn->lblf = Labl {};
+            }
+        } else if (BCZ* bcz = inst.as<BCZ>()) {
+            if (next.count(bcz->lblt) > 0 && !bcz->lblf.empty()) {
+                bcz->cndn = invert(bcz->cndn);
+                bcz->lblt = bcz->lblf;
+                bcz->lblf = Labl {};
+            } else if (next.count(bcz->lblf) > 0) {
+                bcz->lblf = Labl {};
+            }
+        }
+        next.clear();
+        reversed.push_back(inst);
+    }
+
+    // Remove the labels that are no longer jumped to.
+    //
+    std::unordered_set<Labl> used {};
+    for (const INST& inst : reversed) {
+        for (Labl lbl : inst.jmps()) {
+            used.insert(lbl);
+        }
+    }
+    code.clear();
+    for (auto i = reversed.rbegin(); i != reversed.rend(); i++) {
+        const LBL* lbl = i->as<LBL>();
+        if (lbl && !code.empty() && used.count(lbl->lbl) == 0) {
+            continue;
+        }
+        code.push_back(*i);
+    }
+}
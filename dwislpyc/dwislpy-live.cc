@@ -0,0 +1,196 @@
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include "dwislpy-inst.hh"
+#include "dwislpy-cfg.hh"
+#include "dwislpy-live.hh"
+
+//
+// dwislpy-live.cc
+//
+// Computes the live ranges of the variables of some IR code. See the
+// header for a description of the positions that get recorded.
+//
+// The analysis works one variable at a time. Starting at each read of
+// the variable, it walks backwards through the code, following the
+// predecessors of each instruction (as given by the code's CFG, see
+// `dwislpy-cfg.hh`), marking every position it passes
+// until it reaches a write of that variable. The work is proportional
+// to the total size of the live ranges rather than to the number of
+// instructions times the number of variables.
+//
+
+//
+// Live::Live(code)
+//
+// Analyze the liveness of the variables of `code`.
+//
+Live::Live(const INST_vec& code) {
+    int size = code.size();
+
+    // Find the position of each call, tail call, and system call.
+    //
+    for (int i = 0; i < size; i++) {
+        if (code[i].as<CLL>()) {
+            calls.push_back(i);
+        }
+        if (code[i].as<TCLL>()) {
+            tails.push_back(i);
+        }
+        if (code[i].as<PTI>() || code[i].as<PTS>()) {
+            syscalls.push_back(i);
+        }
+    }
+
+    // Determine the predecessors of each instruction from the code's
+    // control-flow graph. The first instruction of a block follows the
+    // last instruction of each of its predecessor blocks, and every
+    // other instruction just follows the one before it.
+    //
+    CFG cfg {code};
+    std::vector<int> start {};
+    std::vector<int> last {};
+    int posn = 0;
+    for (const BBlk& blk : cfg.blocks) {
+        start.push_back(posn);
+        posn += blk.code.size();
+        last.push_back(posn-1);
+    }
+    std::vector<std::vector<int>> preds(size);
+    for (unsigned int b = 0; b < cfg.blocks.size(); b++) {
+        const BBlk& blk = cfg.blocks[b];
+        if (blk.code.empty()) {
+            continue;
+        }
+        for (int p : blk.preds) {
+            preds[start[b]].push_back(last[p]);
+        }
+        for (int i = start[b]+1; i <= last[b]; i++) {
+            preds[i].push_back(i-1);
+        }
+    }
+
+    // Find where each variable is read and written.
+    //
+    std::unordered_map<Symb,std::vector<int>> reads {};
+    std::unordered_map<Symb,std::vector<int>> writes {};
+    for (int i = 0; i < size; i++) {
+        const INST& inst = code[i];
+        for (Symb* src : inst.srcs()) {
+            if (reads.count(*src) == 0 && writes.count(*src) == 0) {
+                names.push_back(*src);
+            }
+            reads[*src].push_back(i);
+        }
+        for (Symb* dst : inst.dsts()) {
+            if (reads.count(*dst) == 0 && writes.count(*dst) == 0) {
+                names.push_back(*dst);
+            }
+            writes[*dst].push_back(i);
+        }
+    }
+
+    // Walk backwards from the reads of each variable. The two arrays
+    // are stamped with the variable's index rather than cleared.
+    //
+    std::vector<int> seen(size,-1);
+    std::vector<int> written(size,-1);
+    for (unsigned int id = 0; id < names.size(); id++) {
+        Symb name = names[id];
+        std::vector<int> marks = writes[name];
+        for (int w : marks) {
+            written[w] = id;
+        }
+        std::vector<int> work = reads[name];
+        while (!work.empty()) {
+            int i = work.back();
+            work.pop_back();
+            if (seen[i] == (int)id) {
+                continue;
+            }
+            seen[i] = id;
+            marks.push_back(i);
+            for (int p : preds[i]) {
+                if (written[p] != (int)id && seen[p] != (int)id) {
+                    work.push_back(p);
+                }
+            }
+        }
+
+        // Gather the marked positions into ranges.
+        //
+        std::sort(marks.begin(),marks.end());
+        Range_vec& rngs = live_ranges[name];
+        for (int m : marks) {
+            if (!rngs.empty() && rngs.back().to + 1 >= m) {
+                rngs.back().to = std::max(rngs.back().to, m);
+            } else {
+                rngs.push_back(Range {m,m});
+            }
+        }
+    }
+}
+
+const Range_vec& Live::ranges(Symb nm) const {
+    return live_ranges.at(nm);
+}
+
+Range Live::hull(Symb nm) const {
+    const Range_vec& rngs = ranges(nm);
+    return Range {rngs.front().from, rngs.back().to};
+}
+
+//
+// Live::crosses_call(nm)
+//
+// A call is only marked in the ranges of `nm` if `nm` is live just
+// after it, since CLL neither reads nor writes any variable.
+//
+bool Live::crosses_call(Symb nm) const {
+    for (Range r : ranges(nm)) {
+        auto c = std::lower_bound(calls.begin(),calls.end(),r.from);
+        if (c != calls.end() && *c <= r.to) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//
+// Live::crosses_syscall(nm)
+//
+// Unlike CLL, these read a variable, and so `nm` being marked at one of
+// them only means its value is needed afterwards if its range goes on.
+//
+bool Live::crosses_syscall(Symb nm) const {
+    for (Range r : ranges(nm)) {
+        auto c = std::lower_bound(syscalls.begin(),syscalls.end(),r.from);
+        if (c != syscalls.end() && *c < r.to) {
+            return true;
+        }
+    }
+    return false;
+}
+
+//
+// Live::overlap(nm1,nm2)
+//
+// Merge-walk the two sorted range lists looking for a common position.
+//
+bool Live::overlap(Symb nm1, Symb nm2) const {
+    const Range_vec& rngs1 = ranges(nm1);
+    const Range_vec& rngs2 = ranges(nm2);
+    unsigned int i = 0;
+    unsigned int j = 0;
+    while (i < rngs1.size() && j < rngs2.size()) {
+        if (rngs1[i].to < rngs2[j].from) {
+            i++;
+        } else if (rngs2[j].to < rngs1[i].from) {
+            j++;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
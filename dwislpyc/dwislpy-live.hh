@@ -0,0 +1,76 @@
+#ifndef _DWISLPY_LIVE_HH
+#define _DWISLPY_LIVE_HH
+
+//
+// dwislpy-live.hh
+//
+// Liveness analysis of the IR code of a `def` or of the `main` script.
+//
+// A variable or temporary is *live* at an instruction if the value it
+// holds there might still be read later. The analysis numbers the
+// instructions of an `INST_vec` by their position, and records for
+// each variable the positions where it is live, along with the
+// positions where it is written. These are kept as a sorted list of
+// disjoint position ranges, one list per variable.
+//
+// The register allocator (see `dwislpy-regs.hh`) uses these to decide
+// which variables can share a register.
+//
+// Positions are recorded as follows: a variable is marked at position
+// `i` if it is written by instruction `i`, or if its value is needed
+// by instruction `i` or by some instruction after it along a path
+// with no intervening write. A variable that is never read is still
+// marked at each of its writes so that those writes are accounted for.
+//
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "dwislpy-inst.hh"
+
+//
+// class Range - the span of instruction positions from..to (inclusive).
+//
+class Range {
+public:
+    int from;
+    int to;
+    Range(int f, int t) : from {f}, to {t} { }
+};
+
+typedef std::vector<Range> Range_vec;
+
+//
+// class Live - the liveness information for some IR code.
+//
+// * names - every variable read or written by the code, in the order
+//           of their first appearance.
+// * calls - the positions of the code's CLL instructions.
+// * tails - the positions of the code's TCLL instructions.
+// * syscalls - the positions of the code's PTI and PTS instructions,
+//           which pass their value to the system call in $a0.
+//
+// * ranges(nm)       - the sorted, disjoint position ranges of `nm`.
+// * hull(nm)         - the one range spanning all the ranges of `nm`.
+// * crosses_call(nm) - whether the value of `nm` is needed after some
+//                      CLL made while `nm` is live.
+// * crosses_syscall(nm) - the same, but for PTI and PTS.
+// * overlap(nm1,nm2) - whether `nm1` and `nm2` are ever live together.
+//
+class Live {
+public:
+    std::vector<Symb> names;
+    std::vector<int> calls;
+    std::vector<int> tails;
+    std::vector<int> syscalls;
+    Live(const INST_vec& code);
+    const Range_vec& ranges(Symb nm) const;
+    Range hull(Symb nm) const;
+    bool crosses_call(Symb nm) const;
+    bool crosses_syscall(Symb nm) const;
+    bool overlap(Symb nm1, Symb nm2) const;
+private:
+    std::unordered_map<Symb,Range_vec> live_ranges;
+};
+
+#endif
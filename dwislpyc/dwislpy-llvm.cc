@@ -0,0 +1,478 @@
+#include <string>
+#include "dwislpy-emit.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-check.hh"
+#include "dwislpy-pass.hh"
+#include "dwislpy-llvm.hh"
+
+//
+// dwislpy-llvm.cc
+//
+// This gives the code for compiling the IR into LLVM IR, the
+// counterpart of `dwislpy-mips.cc`. See `dwislpy-llvm.hh` for how the
+// IR's variables and functions are represented.
+//
+
+//
+// function_name(lbl)
+//
+// The LLVM name of the function labelled `lbl`.
+//
+static std::string function_name(Labl lbl) {
+    if (lbl.name() == "main") {
+        return "@main";
+    }
+    return "@dwislpy." + lbl.name();
+}
+
+// compile_defn_llvm(os,symt,code,passes)
+//
+// Generate LLVM IR into `os`. This optimizes `code` with `passes` as
+// `compile_defn` does, and then gives each of its variables an `alloca`
+// before converting each IR instruction (using `toLLVM`). The first
+// instruction is the LBL naming the function, which becomes the head of
+// its definition.
+//
+void compile_defn_llvm(AsmOut& os, SymT& symt, INST_vec& code,
+                       PassManager& passes) {
+
+    // Optimize the IR (see `dwislpy-pass.hh`).
+    passes.run(symt,code);
+
+    LBL* name = code[0].as<LBL>();
+    LLVMOut out {os, name->lbl.name() == "main"};
+    if (out.main) {
+        os << "define i32 @main() {" << '\n';
+    } else {
+        os << "define i64 " << function_name(name->lbl) << "(";
+        for (int i = 0; i < (int)symt.get_frmls_size(); i++) {
+            os << (i > 0 ? ", " : "") << "i64 %a." << i;
+        }
+        os << ") {" << '\n';
+    }
+
+    // Give each variable a slot.
+    auto add_slot = [&out](Symb nm) {
+        if (out.slots.count(nm) == 0) {
+            int n = out.slots.size();
+            out.slots[nm] = n;
+        }
+    };
+    for (unsigned int i = 0; i < symt.get_frmls_size(); i++) {
+        add_slot(symt.get_frml_symb(i));
+    }
+    for (INST& inst : code) {
+        for (Symb* src : inst.srcs()) {
+            add_slot(*src);
+        }
+        for (Symb* dst : inst.dsts()) {
+            add_slot(*dst);
+        }
+    }
+    os << "\t%ret.val = alloca i64" << '\n';
+    for (int n = 0; n < (int)out.slots.size(); n++) {
+        os << "\t%s." << n << " = alloca i64" << '\n';
+    }
+
+    for (unsigned int i = 1; i < code.size(); i++) {
+        code[i].toLLVM(out,symt);
+    }
+    if (!out.ended) {
+        os << "\tunreachable" << '\n';
+    }
+    os << "}" << '\n';
+}
+
+//
+// output_string_llvm(os,data)
+//
+// Outputs the characters of a string constant as the array `lbl.str`,
+// where `lbl` is the first of its labels, and then a pointer under each
+// label to the characters at its offset.
+//
+void output_string_llvm(AsmOut& os, const StrgData& data) {
+    static const char* digits = "0123456789ABCDEF";
+    std::string strg = data.strg;
+    std::string array = data.lbls[0].second + ".str";
+    std::string type = "[" + std::to_string(strg.size() + 1) + " x i8]";
+    os << "@" << array << " = private unnamed_addr constant "
+       << type << " c\"";
+    for (unsigned char c : strg) {
+        if (c >= ' ' && c <= '~' && c != '"' && c != '\\') {
+            os << (char)c;
+        } else {
+            os << "\\" << digits[c >> 4] << digits[c & 0xf];
+        }
+    }
+    os << "\\00\"" << '\n';
+    for (std::pair<unsigned int,std::string> off_lbl : data.lbls) {
+        os << "@" << off_lbl.second << " = private unnamed_addr constant i8* "
+           << "getelementptr inbounds (" << type << ", " << type << "* @"
+           << array << ", i64 0, i64 " << std::to_string(off_lbl.first) << ")" << '\n';
+    }
+}
+
+//
+// output_runtime_llvm(os)
+//
+// Declares the routines of `dwislpy-rt.c`.
+//
+void output_runtime_llvm(AsmOut& os) {
+    os << "declare void @dwislpy_print_int(i32)" << '\n';
+    os << "declare void @dwislpy_print_str(i8*)" << '\n';
+    os << "declare i32 @dwislpy_read_int()" << '\n';
+}
+
+//
+// INST::toLLVM(out,symt)
+//
+// Method for generating LLVM IR that performs the work of a
+// pseudo-instruction, just as `INST::toMIPS` does for MIPS32. Each
+// reads its sources from their slots with the helpers below, which
+// give the name of the SSA value loaded, and writes its result back.
+//
+// We define this method for each subclass of INST.
+//
+
+//
+// load_word(out,nm)
+//
+// Loads the 64 bits of `nm`.
+//
+static std::string load_word(LLVMOut& out, Symb nm) {
+    std::string v = out.value();
+    out.os << "\t" << v << " = load i64, i64* " << out.slot(nm) << '\n';
+    return v;
+}
+
+//
+// load_int(out,nm)
+//
+// Loads the integer value of `nm`.
+//
+static std::string load_int(LLVMOut& out, Symb nm) {
+    std::string w = load_word(out,nm);
+    std::string v = out.value();
+    out.os << "\t" << v << " = trunc i64 " << w << " to i32" << '\n';
+    return v;
+}
+
+//
+// store_word(out,nm,w)
+//
+// Stores the 64-bit value `w` to `nm`.
+//
+static void store_word(LLVMOut& out, Symb nm, std::string w) {
+    out.os << "\t" << "store i64 " << w << ", i64* " << out.slot(nm) << '\n';
+}
+
+//
+// store_int(out,nm,v)
+//
+// Stores the integer value `v` to `nm`.
+//
+static void store_int(LLVMOut& out, Symb nm, std::string v) {
+    std::string w = out.value();
+    out.os << "\t" << w << " = sext i32 " << v << " to i64" << '\n';
+    store_word(out,nm,w);
+}
+
+//
+// call(out,lbl,tail)
+//
+// Calls the function labelled `lbl` with the values given by the ARGs
+// before it, giving the value it returns.
+//
+static std::string call(LLVMOut& out, Labl lbl, bool tail) {
+    std::string r = out.value();
+    out.os << "\t" << r << " = " << (tail ? "tail " : "") << "call i64 "
+           << function_name(lbl) << "(";
+    for (unsigned int i = 0; i < out.args.size(); i++) {
+        out.os << (i > 0 ? ", " : "") << "i64 " << out.args[i];
+    }
+    out.os << ")" << '\n';
+    out.args.clear();
+    return r;
+}
+
+void ENTER::toLLVM(LLVMOut& out, const SymT& symt) const {
+    out.start();
+    for (unsigned int i = 0; i < symt.get_frmls_size(); i++) {
+        store_word(out,symt.get_frml_symb(i),"%a." + std::to_string(i));
+    }
+}
+//
+// leave(out,rslt)
+//
+// Returns `rslt`, or 0 from `main`.
+//
+static void leave(LLVMOut& out, std::string rslt) {
+    if (out.main) {
+        out.os << "\t" << "ret i32 0" << '\n';
+    } else {
+        out.os << "\t" << "ret i64 " << rslt << '\n';
+    }
+    out.end();
+}
+//
+void LEAVE::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    std::string r = out.value();
+    out.os << "\t" << r << " = load i64, i64* %ret.val" << '\n';
+    leave(out,r);
+}
+//
+void TCLL::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    leave(out,call(out,lbl,true));
+}
+//
+void SET::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    store_word(out,dst,std::to_string(val));
+}
+//
+void STL::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    std::string p = out.value();
+    std::string w = out.value();
+    out.os << "\t" << p << " = load i8*, i8** @" << lbl << '\n';
+    out.os << "\t" << w << " = ptrtoint i8* " << p << " to i64" << '\n';
+    store_word(out,dst,w);
+}
+//
+void MOV::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    store_word(out,dst,load_word(out,src));
+}
+//
+void RTV::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    store_word(out,dst,out.result);
+}
+//
+void GTI::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    std::string v = out.value();
+    out.os << "\t" << v << " = call i32 @dwislpy_read_int()" << '\n';
+    store_int(out,dst,v);
+}
+//
+void NOP::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+}
+//
+void PTI::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    std::string v = load_int(out,src);
+    out.os << "\t" << "call void @dwislpy_print_int(i32 " << v << ")" << '\n';
+}
+//
+void PTS::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    std::string w = load_word(out,src);
+    std::string p = out.value();
+    out.os << "\t" << p << " = inttoptr i64 " << w << " to i8*" << '\n';
+    out.os << "\t" << "call void @dwislpy_print_str(i8* " << p << ")" << '\n';
+}
+//
+// binary(out,op,dst,v1,v2)
+//
+// Shared by the arithmetic instructions, `op` being an LLVM binary
+// operation on two integers.
+//
+static void binary(LLVMOut& out, std::string op,
+                   Symb dst, std::string v1, std::string v2) {
+    std::string v = out.value();
+    out.os << "\t" << v << " = " << op << " i32 " << v1 << ", " << v2 << '\n';
+    store_int(out,dst,v);
+}
+//
+// compare(out,cc,dst,v1,v2)
+//
+// Shared by the comparisons, `cc` being an LLVM `icmp` condition.
+//
+static void compare(LLVMOut& out, std::string cc,
+                    Symb dst, std::string v1, std::string v2) {
+    std::string c = out.value();
+    std::string v = out.value();
+    out.os << "\t" << c << " = icmp " << cc << " i32 " << v1 << ", " << v2 << '\n';
+    out.os << "\t" << v << " = zext i1 " << c << " to i32" << '\n';
+    store_int(out,dst,v);
+}
+//
+void ADD::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"add",dst,load_int(out,src1),load_int(out,src2));
+}
+//
+void SUB::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"sub",dst,load_int(out,src1),load_int(out,src2));
+}
+//
+void MUL::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"mul",dst,load_int(out,src1),load_int(out,src2));
+}
+//
+void DIV::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"sdiv",dst,load_int(out,src1),load_int(out,src2));
+}
+//
+void MOD::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"srem",dst,load_int(out,src1),load_int(out,src2));
+}
+//
+void ADDI::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"add",dst,load_int(out,src),std::to_string(val));
+}
+//
+void ADDIU::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"add",dst,load_int(out,src),std::to_string(val));
+}
+//
+void SLTI::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    compare(out,"slt",dst,load_int(out,src),std::to_string(val));
+}
+//
+// LLVM finds its own way to multiply and divide by powers of two, and
+// so MULP, DIVP, and MODP are given to it as they were before lowering.
+//
+void MULP::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"shl",dst,load_int(out,src),std::to_string(val));
+}
+//
+void DIVP::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"sdiv",dst,load_int(out,src),std::to_string(1 << val));
+}
+//
+void MODP::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"srem",dst,load_int(out,src),std::to_string(1 << val));
+}
+//
+void SLT::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    compare(out,"slt",dst,load_int(out,src1),load_int(out,src2));
+}
+//
+void SLE::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    compare(out,"sle",dst,load_int(out,src1),load_int(out,src2));
+}
+//
+void SEQ::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    compare(out,"eq",dst,load_int(out,src1),load_int(out,src2));
+}
+//
+void AND::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"and",dst,load_int(out,src1),load_int(out,src2));
+}
+//
+void OR::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"or",dst,load_int(out,src1),load_int(out,src2));
+}
+//
+void NOT::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    binary(out,"xor",dst,load_int(out,src),"1");
+}
+//
+void RTN::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    std::string w = load_word(out,src);
+    out.os << "\t" << "store i64 " << w << ", i64* %ret.val" << '\n';
+}
+//
+// branch(out,c,lblt,lblf)
+//
+// Branches on the `i1` value `c` to `lblt`, or else to `lblf`. If
+// `lblf` is empty the code falls through to a new block.
+//
+static void branch(LLVMOut& out, std::string c, Labl lblt, Labl lblf) {
+    std::string fall = lblf.empty() ? out.block() : lblf.name();
+    out.os << "\t" << "br i1 " << c << ", label %" << lblt
+           << ", label %" << fall << '\n';
+    if (lblf.empty()) {
+        out.os << fall << ":" << '\n';
+    } else {
+        out.end();
+    }
+}
+//
+// icmp_cc(cn)
+//
+// The LLVM `icmp` condition of the IR branch condition `cn`, such
+// as "sle" for BCN's "le" or BCZ's "lez".
+//
+static std::string icmp_cc(Cndn cn) {
+    std::string cndn = cndn_name(cn);
+    if (cndn.back() == 'z') {
+        cndn.pop_back();
+    }
+    if (cndn == "eq" || cndn == "ne") {
+        return cndn;
+    }
+    return "s" + cndn;          // slt, sle, sgt, sge
+}
+//
+void BCN::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    std::string v1 = load_int(out,src1);
+    std::string v2 = load_int(out,src2);
+    std::string c = out.value();
+    out.os << "\t" << c << " = icmp " << icmp_cc(cndn) << " i32 "
+           << v1 << ", " << v2 << '\n';
+    branch(out,c,lblt,lblf);
+}
+//
+void BCZ::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    std::string v = load_int(out,src);
+    std::string c = out.value();
+    out.os << "\t" << c << " = icmp " << icmp_cc(cndn) << " i32 "
+           << v << ", 0" << '\n';
+    branch(out,c,lblt,lblf);
+}
+//
+void JMP::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    out.os << "\t" << "br label %" << lbl << '\n';
+    out.end();
+}
+//
+void CLL::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    out.result = call(out,lbl,false);
+}
+//
+void LBL::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    if (!out.ended) {
+        out.os << "\t" << "br label %" << lbl << '\n';
+    }
+    out.os << lbl << ":" << '\n';
+    out.ended = false;
+}
+//
+void CMT::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.os << "\t\t\t\t;" << msg << '\n';
+}
+//
+void ARG::toLLVM(LLVMOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.start();
+    if ((int)out.args.size() <= idx) {
+        out.args.resize(idx + 1);
+    }
+    out.args[idx] = load_word(out,src);
+}
@@ -0,0 +1,104 @@
+#ifndef _DWISLPY_LLVM_HH
+#define _DWISLPY_LLVM_HH
+
+//
+// dwislpy-llvm.hh
+//
+// The LLVM IR backend, used by `dwislpyc --target=llvm`. It lowers the
+// same IR as the MIPS32 backend to the text form of LLVM IR, written to
+// `foo.ll`, so that LLVM's optimizer and code generator can take it
+// from there. The I/O is done by the C runtime in `dwislpy-rt.c`:
+//
+//     clang -O2 foo.ll dwislpy-rt.c -o foo
+//
+// The IR is written with typed pointers (`i8*`), as LLVM 14 expects.
+//
+// Each variable and temporary gets an `alloca` of 64 bits, much as it
+// would get a frame slot, and each instruction loads its sources from
+// these and stores its result to them. LLVM's `mem2reg` pass turns
+// them into SSA values, and so no registers are allocated here.
+// Integers are 32 bits wide, and are sign-extended into their slots.
+// Strings are kept as the addresses of their characters.
+//
+// Each `def` becomes a function named `dwislpy.` followed by its name,
+// so as not to clash with anything in the C library, that takes and
+// returns `i64`s. The main script becomes `main`. Each string constant
+// becomes an array of characters, along with a constant pointer to it
+// under its label, so that the code using a string needn't know its
+// length.
+//
+// * compile_defn_llvm(os,symt,code,passes) - like `compile_defn`.
+// * output_string_llvm(os,data)            - outputs a string constant.
+// * output_runtime_llvm(os)                - declares the runtime.
+//
+// class LLVMOut
+//
+// The writer of one function's LLVM IR, passed to `INST::toLLVM`. On
+// top of `os`, it keeps what the instructions need to know of those
+// before them:
+//
+// * main   - whether this is the main script.
+// * slots  - the number of each variable's `alloca`, in the order they
+//            first appear, so the output doesn't depend on the symbols
+//            that happened to be given out while compiling in parallel.
+// * values - the number of SSA values made so far.
+// * ended  - whether the last instruction ended a basic block.
+// * args   - the values given by ARGs to the next call.
+// * result - the value given by the last call.
+//
+// * slot(nm)   - the name of the `alloca` of `nm`.
+// * value()    - a new SSA value name.
+// * block()    - a new basic block label.
+// * start()    - starts an instruction, opening a block if the last
+//                one was ended. The code after an unconditional jump
+//                can only be reached through its labels, so any that
+//                isn't labelled goes in a block of its own.
+// * end()      - marks the block as ended.
+//
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-emit.hh"
+#include "dwislpy-pass.hh"
+
+class LLVMOut {
+public:
+    AsmOut& os;
+    bool main;
+    std::unordered_map<Symb,int> slots;
+    int values;
+    bool ended;
+    std::vector<std::string> args;
+    std::string result;
+    LLVMOut(AsmOut& o, bool m) :
+        os {o}, main {m}, slots {}, values {0}, ended {false}, args {},
+        result {} { }
+    std::string slot(Symb nm) const {
+        return "%s." + std::to_string(slots.at(nm));
+    }
+    std::string value(void) {
+        return "%v." + std::to_string(values++);
+    }
+    std::string block(void) {
+        return "bb." + std::to_string(values++);
+    }
+    void start(void) {
+        if (ended) {
+            os << block() << ":" << '\n';
+            ended = false;
+        }
+    }
+    void end(void) {
+        ended = true;
+    }
+};
+
+void compile_defn_llvm(AsmOut& os, SymT& symt, INST_vec& code,
+                       PassManager& passes);
+void output_string_llvm(AsmOut& os, const StrgData& data);
+void output_runtime_llvm(AsmOut& os);
+
+#endif
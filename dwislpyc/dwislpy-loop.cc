@@ -0,0 +1,537 @@
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-cfg.hh"
+#include "dwislpy-opt.hh"
+
+//
+// dwislpy-loop.cc
+//
+// Loop-invariant code motion and strength reduction over the IR.
+//
+// A `while` loop is translated with its whole condition and body after
+// its label, so everything in them is recomputed on every iteration,
+// even values like the `n * k` of `while i < n * k` that can't change.
+// This pass finds the natural loops of the code's CFG (see Aho, Lam,
+// Sethi, and Ullman, "Compilers", 2nd ed., section 9.6). Each has a
+// header block that dominates the rest of it, and that the rest jumps
+// back to. Loops are handled innermost first, and for each:
+//
+// * A preheader block is made to sit just before the header. The
+//   entries into the loop from outside now pass through it, but the
+//   jumps back from inside the loop skip it.
+//
+// * Invariant instructions are moved into the preheader. An instruction
+//   is invariant if its sources are only written outside the loop (or
+//   by instructions already moved), and it's the only instruction in
+//   the loop that writes its destination. Moving it also requires that
+//   the destination not be live on entry to the header, and, if it's
+//   live after the loop, that the instruction run on every way out of
+//   it. Only instructions that can't trap are moved, since they might
+//   never have run in the loop: not ADD, SUB, or ADDI (which trap on
+//   overflow) nor DIV or MOD (which trap on division by zero). SETs
+//   and STLs of constants are only moved while the loop seems to have
+//   registers to spare to hold them, since they are cheap to redo.
+//
+// * Products of a basic induction variable and a constant are strength
+//   reduced. A basic induction variable `i` is one only written in the
+//   loop by `ADDI i,i,k` instructions. For each `MUL d,i,c` or `MULP`
+//   of such an `i`, a new temporary `s` gets `i*c` in the preheader,
+//   and `ADDIU s,s,k*c` after each `ADDI i,i,k`. The product becomes
+//   `MOV d,s`. When `i` is set to a constant just before the loop, as
+//   a counter usually is, `s` is instead set to the folded product. This uses ADDIU since the product wrapped around rather
+//   than trapping when it overflowed.
+//
+
+typedef std::unordered_set<Symb> Name_set;
+
+//
+// can_hoist(inst)
+//
+// Whether `inst` computes a value without side effects or traps.
+//
+static bool can_hoist(const INST& inst) {
+    return inst.as<SET>() || inst.as<STL>()
+        || inst.as<MOV>() || inst.as<MUL>()
+        || inst.as<SLT>() || inst.as<SLE>()
+        || inst.as<SEQ>() || inst.as<AND>()
+        || inst.as<OR>() || inst.as<NOT>()
+        || inst.as<ADDIU>() || inst.as<SLTI>()
+        || inst.as<MULP>() || inst.as<DIVP>()
+        || inst.as<MODP>();
+}
+
+static bool fits_16(long long v) {
+    return -32768 <= v && v <= 32767;
+}
+
+//
+// live_in(cfg)
+//
+// The variables live on entry to each block of `cfg`.
+//
+static std::vector<Name_set> live_in(const CFG& cfg) {
+    std::vector<int> order = cfg.rpo();
+    std::vector<Name_set> live_in(cfg.blocks.size());
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto b = order.rbegin(); b != order.rend(); b++) {
+            Name_set live {};
+            for (int s : cfg.blocks[*b].succs) {
+                live.insert(live_in[s].begin(),live_in[s].end());
+            }
+            const INST_vec& code = cfg.blocks[*b].code;
+            for (auto inst = code.rbegin(); inst != code.rend(); inst++) {
+                for (Symb* dst : inst->dsts()) {
+                    live.erase(*dst);
+                }
+                for (Symb* src : inst->srcs()) {
+                    live.insert(*src);
+                }
+            }
+            if (live.size() != live_in[*b].size()) {
+                live_in[*b] = live;
+                changed = true;
+            }
+        }
+    }
+    return live_in;
+}
+
+//
+// retarget(inst,from,to)
+//
+// Redirect any jump by `inst` to label `from` to go to `to` instead.
+//
+static void retarget(INST& inst, Labl from, Labl to) {
+    auto redirect = [&](Labl& lbl) {
+        if (lbl == from) {
+            lbl = to;
+        }
+    };
+    if (JMP* jmp = inst.as<JMP>()) {
+        redirect(jmp->lbl);
+    } else if (BCN* bcn = inst.as<BCN>()) {
+        redirect(bcn->lblt);
+        redirect(bcn->lblf);
+    } else if (BCZ* bcz = inst.as<BCZ>()) {
+        redirect(bcz->lblt);
+        redirect(bcz->lblf);
+    }
+}
+
+//
+// hoist(symt,cfg,head,body,live)
+//
+// Remove the invariant instructions from the loop, giving them in an
+// order they can be run in.
+//
+static INST_vec hoist(SymT& symt, CFG& cfg, int head, const std::vector<bool>& body,
+                      const std::vector<Name_set>& live) {
+    int size = cfg.blocks.size();
+
+    // Count the writes to each variable within the loop, and find the
+    // blocks the loop can be left from and the variables live there.
+    //
+    std::unordered_map<Symb,int> writes {};
+    std::vector<int> exits {};
+    Name_set live_out {};
+    for (int b = 0; b < size; b++) {
+        if (!body[b]) {
+            continue;
+        }
+        for (INST& inst : cfg.blocks[b].code) {
+            for (Symb* dst : inst.dsts()) {
+                writes[*dst]++;
+            }
+        }
+        for (int s : cfg.blocks[b].succs) {
+            if (!body[s]) {
+                exits.push_back(b);
+                live_out.insert(live[s].begin(),live[s].end());
+            }
+        }
+    }
+
+    // SETs and STLs are left in the loop for now, since they are as
+    // cheap as a copy and moving them keeps their values in registers
+    // all through the loop. Instructions that read them are moved along
+    // with a copy of them that sets a fresh temporary.
+    //
+    INST_vec hoisted {};
+    Name_set invariant {};
+    std::unordered_map<Symb,INST> cheap {};
+    std::unordered_map<Symb,Symb> remat {};
+    std::vector<int> order = cfg.rpo();
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int b : order) {
+            if (!body[b]) {
+                continue;
+            }
+            bool on_all_exits = true;
+            for (int e : exits) {
+                if (!cfg.dominates(b,e)) {
+                    on_all_exits = false;
+                }
+            }
+            INST_vec kept {};
+            for (INST& inst : cfg.blocks[b].code) {
+                Opnds dsts = inst.dsts();
+                bool movable = can_hoist(inst) && dsts.size() == 1
+                    && invariant.count(*dsts[0]) == 0
+                    && writes[*dsts[0]] == 1
+                    && live[head].count(*dsts[0]) == 0
+                    && (on_all_exits || live_out.count(*dsts[0]) == 0);
+                for (Symb* src : inst.srcs()) {
+                    if (writes.count(*src) > 0 && invariant.count(*src) == 0) {
+                        movable = false;
+                    }
+                }
+                if (!movable) {
+                    kept.push_back(inst);
+                    continue;
+                }
+                invariant.insert(*dsts[0]);
+                changed = true;
+                if (inst.as<SET>() || inst.as<STL>()) {
+                    cheap.insert_or_assign(*dsts[0],inst);
+                    kept.push_back(inst);
+                    continue;
+                }
+                for (Symb* src : inst.srcs()) {
+                    if (cheap.count(*src) == 0) {
+                        continue;
+                    }
+                    if (remat.count(*src) == 0) {
+                        INST copy = cheap.at(*src);
+                        Symb* dst = copy.dsts()[0];
+                        *dst = symt.add_temp(symt.get_info(*src)->type);
+                        remat[*src] = *dst;
+                        hoisted.push_back(copy);
+                    }
+                    *src = remat[*src];
+                }
+                hoisted.push_back(inst);
+            }
+            cfg.blocks[b].code = kept;
+        }
+    }
+
+    // Move the SETs and STLs out as well while there look to be spare
+    // registers, going by the most variables live at once in the loop. The
+    // values moved out must survive any calls made in the loop, and so
+    // would then need one of the callee-saved registers.
+    //
+    int pressure = 0;
+    bool calls = false;
+    for (int b = 0; b < size; b++) {
+        if (!body[b]) {
+            continue;
+        }
+        Name_set here {};
+        for (int s : cfg.blocks[b].succs) {
+            here.insert(live[s].begin(),live[s].end());
+        }
+        const INST_vec& code = cfg.blocks[b].code;
+        for (auto inst = code.rbegin(); inst != code.rend(); inst++) {
+            for (Symb* dst : inst->dsts()) {
+                here.erase(*dst);
+            }
+            for (Symb* src : inst->srcs()) {
+                here.insert(*src);
+            }
+            pressure = std::max(pressure,(int)here.size());
+            if (inst->as<CLL>()) {
+                calls = true;
+            }
+        }
+    }
+    int spare = (calls ? 8 : 15) - pressure - (hoisted.size() - remat.size());
+    INST_vec consts {};
+    for (int b : order) {
+        if (!body[b]) {
+            continue;
+        }
+        INST_vec kept {};
+        for (INST& inst : cfg.blocks[b].code) {
+            Opnds dsts = inst.dsts();
+            if (spare > 0 && dsts.size() == 1 && cheap.count(*dsts[0]) > 0) {
+                consts.push_back(inst);
+                spare--;
+            } else {
+                kept.push_back(inst);
+            }
+        }
+        cfg.blocks[b].code = kept;
+    }
+    hoisted.insert(hoisted.begin(),consts.begin(),consts.end());
+    return hoisted;
+}
+
+//
+// initial(cfg,head,body,nm,val)
+//
+// Whether `nm` holds a known constant, set in `val`, on entry to the
+// loop with header `head`. That's so when the loop is only entered
+// from one block, and that block's last write of `nm` is a SET.
+//
+static bool initial(const CFG& cfg, int head, const std::vector<bool>& body,
+                    Symb nm, int& val) {
+    int entry = -1;
+    for (int p : cfg.blocks[head].preds) {
+        if (body[p]) {
+            continue;
+        }
+        if (entry >= 0) {
+            return false;
+        }
+        entry = p;
+    }
+    if (entry < 0) {
+        return false;
+    }
+    const INST_vec& code = cfg.blocks[entry].code;
+    for (auto inst = code.rbegin(); inst != code.rend(); inst++) {
+        for (Symb* dst : inst->dsts()) {
+            if (*dst != nm) {
+                continue;
+            }
+            const SET* set = inst->as<SET>();
+            if (set == nullptr) {
+                return false;
+            }
+            val = set->val;
+            return true;
+        }
+    }
+    return false;
+}
+
+//
+// reduce(symt,cfg,head,body,consts,pre)
+//
+// Strength reduce the products of induction variables by constants,
+// adding the initial values of the new temporaries to `pre`.
+//
+static void reduce(SymT& symt, CFG& cfg, int head,
+                   const std::vector<bool>& body,
+                   const std::unordered_map<Symb,int>& consts,
+                   INST_vec& pre) {
+    int size = cfg.blocks.size();
+
+    // Find the basic induction variables and their steps, ruling out
+    // the variables written any other way.
+    //
+    std::unordered_map<Symb,std::vector<int>> steps {};
+    Name_set written {};
+    for (int b = 0; b < size; b++) {
+        if (!body[b]) {
+            continue;
+        }
+        for (INST& inst : cfg.blocks[b].code) {
+            ADDI* addi = inst.as<ADDI>();
+            if (addi && addi->dst == addi->src) {
+                steps[addi->dst].push_back(addi->val);
+            } else {
+                for (Symb* dst : inst.dsts()) {
+                    written.insert(*dst);
+                }
+            }
+        }
+    }
+    for (Symb nm : written) {
+        steps.erase(nm);
+    }
+
+    // Replace each product of one by a constant, sharing the reduced
+    // temporary amongst the products of the same variable and constant.
+    //
+    std::unordered_map<Symb,std::vector<std::pair<int,Symb>>> reduced {};
+    for (int b = 0; b < size; b++) {
+        if (!body[b]) {
+            continue;
+        }
+        for (INST& inst : cfg.blocks[b].code) {
+            Symb iv {};
+            int by = 0;
+            Symb dst {};
+            if (MUL* mul = inst.as<MUL>()) {
+                Symb s1 = mul->src1;
+                Symb s2 = mul->src2;
+                if (steps.count(s1) == 0) {
+                    std::swap(s1,s2);
+                }
+                if (steps.count(s1) > 0 && consts.count(s2) > 0
+                    && written.count(s2) == 0) {
+                    iv = s1;
+                    by = consts.at(s2);
+                    dst = mul->dst;
+                }
+            } else if (MULP* mulp = inst.as<MULP>()) {
+                if (steps.count(mulp->src) > 0) {
+                    iv = mulp->src;
+                    by = 1 << mulp->val;
+                    dst = mulp->dst;
+                }
+            }
+            if (iv.empty() || dst == iv) {
+                continue;
+            }
+            bool fits = true;
+            for (int k : steps[iv]) {
+                fits = fits && fits_16((int)(unsigned int)((long long)k * by));
+            }
+            if (!fits) {
+                continue;
+            }
+            Symb tmp {};
+            for (std::pair<int,Symb> r : reduced[iv]) {
+                if (r.first == by) {
+                    tmp = r.second;
+                }
+            }
+            if (tmp.empty()) {
+                tmp = symt.add_temp(IntTy {});
+                int init = 0;
+                if (initial(cfg,head,body,iv,init)) {
+                    int v = (int)(unsigned int)((long long)init * by);
+                    pre.push_back(SET {tmp,v});
+                } else {
+                    Symb c = symt.add_temp(IntTy {});
+                    pre.push_back(SET {c,by});
+                    pre.push_back(MUL {tmp,iv,c});
+                }
+                reduced[iv].push_back({by,tmp});
+            }
+            inst = MOV {dst,tmp};
+        }
+    }
+
+    // Step the reduced temporaries along with their variables.
+    //
+    for (int b = 0; b < size; b++) {
+        if (!body[b]) {
+            continue;
+        }
+        INST_vec stepped {};
+        for (INST& inst : cfg.blocks[b].code) {
+            stepped.push_back(inst);
+            ADDI* addi = inst.as<ADDI>();
+            if (addi && reduced.count(addi->dst) > 0 && addi->dst == addi->src) {
+                for (std::pair<int,Symb> r : reduced[addi->dst]) {
+                    int k = (int)(unsigned int)((long long)addi->val * r.first);
+                    stepped.push_back(ADDIU {r.second,r.second,k});
+                }
+            }
+        }
+        cfg.blocks[b].code = stepped;
+    }
+}
+
+//
+// optimize_loop(symt,code,head_lbl)
+//
+// Optimize the loop headed by the block labelled `head_lbl`, if any.
+//
+static void optimize_loop(SymT& symt, INST_vec& code, Labl head_lbl) {
+    CFG cfg {code};
+    cfg.dominate();
+    int head = cfg.block_of(head_lbl);
+    std::vector<bool> body = cfg.loop(head);
+    if (head == 0 || !body[head]) {
+        return;
+    }
+    std::vector<Name_set> live = live_in(cfg);
+
+    // Values that are constant throughout the code.
+    //
+    std::unordered_map<Symb,int> consts {};
+    std::unordered_map<Symb,int> writes {};
+    for (const BBlk& blk : cfg.blocks) {
+        for (const INST& inst : blk.code) {
+            for (Symb* dst : inst.dsts()) {
+                writes[*dst]++;
+            }
+            if (const SET* set = inst.as<SET>()) {
+                consts[set->dst] = set->val;
+            }
+        }
+    }
+    for (auto w : writes) {
+        if (w.second > 1) {
+            consts.erase(w.first);
+        }
+    }
+
+    INST_vec pre = hoist(symt,cfg,head,body,live);
+    reduce(symt,cfg,head,body,consts,pre);
+    if (pre.empty()) {
+        return;
+    }
+
+    // Add the preheader, redirecting the entries into the loop to it.
+    //
+    Labl pre_lbl = symt.add_labl();
+    int pre_blk = cfg.blocks.size();
+    for (int p : cfg.blocks[head].preds) {
+        if (body[p]) {
+            continue;
+        }
+        BBlk& pred = cfg.blocks[p];
+        if (pred.next == head) {
+            pred.next = pre_blk;
+        }
+        if (!pred.code.empty()) {
+            retarget(pred.code.back(),head_lbl,pre_lbl);
+        }
+    }
+    cfg.blocks.push_back(BBlk {});
+    BBlk& preheader = cfg.blocks.back();
+    preheader.code.push_back(LBL {pre_lbl});
+    preheader.code.insert(preheader.code.end(),pre.begin(),pre.end());
+    preheader.next = head;
+    std::vector<int> order {};
+    for (int b = 0; b < pre_blk; b++) {
+        if (b == head) {
+            order.push_back(pre_blk);
+        }
+        order.push_back(b);
+    }
+    cfg.reorder(order);
+    code = cfg.linearize(symt);
+}
+
+//
+// optimize_loops(symt,code)
+//
+void optimize_loops(SymT& symt, INST_vec& code) {
+
+    // Find the loop headers, innermost loops first.
+    //
+    CFG cfg {code};
+    cfg.dominate();
+    std::vector<std::pair<int,Labl>> heads {};
+    for (unsigned int b = 0; b < cfg.blocks.size(); b++) {
+        std::vector<Labl> lbls = cfg.blocks[b].lbls();
+        std::vector<bool> body = cfg.loop(b);
+        if (lbls.empty() || !body[b]) {
+            continue;
+        }
+        heads.push_back({std::count(body.begin(),body.end(),true),lbls.front()});
+    }
+    std::stable_sort(heads.begin(),heads.end(),
+                     [](std::pair<int,Labl> h1, std::pair<int,Labl> h2) {
+        return h1.first < h2.first
+            || (h1.first == h2.first && h1.second.name() < h2.second.name());
+    });
+    for (std::pair<int,Labl> h : heads) {
+        optimize_loop(symt,code,h.second);
+    }
+}
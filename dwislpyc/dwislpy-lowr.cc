@@ -0,0 +1,123 @@
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <optional>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-cfg.hh"
+#include "dwislpy-opt.hh"
+
+//
+// dwislpy-lowr.cc
+//
+// Lowering of IR arithmetic to immediate and strength-reduced forms.
+//
+// Each constant operand is translated as its own SET into a temporary
+// that is then used by a register-register instruction. Within each
+// block, this pass tracks the temporaries set to known values and
+// rewrites the instructions that use them:
+//
+//     ADD d,s,c  or  ADD d,c,s  ->  ADDI d,s,c    (c fits in 16 bits)
+//     SUB d,s,c                 ->  ADDI d,s,-c
+//     SLT d,s,c                 ->  SLTI d,s,c
+//     MUL d,s,2^k or MUL d,2^k,s -> MULP d,s,k
+//     DIV d,s,2^k               ->  DIVP d,s,k
+//     MOD d,s,2^k               ->  MODP d,s,k
+//
+// along with the identities x+0, x-0, x*1, and x//1 becoming MOVs, and
+// x%1 becoming SET 0. The SETs left unread are then removed by
+// `remove_dead_code`.
+//
+
+typedef std::unordered_map<Symb,int> Cnst_map;
+
+static bool fits_16(long long v) {
+    return -32768 <= v && v <= 32767;
+}
+
+//
+// log_2(v)
+//
+// The k with 2^k == v, if there is one from 1 to 30.
+//
+static std::optional<int> log_2(std::optional<int> v) {
+    if (!v || *v < 2 || (*v & (*v - 1)) != 0) {
+        return std::nullopt;
+    }
+    int k = 0;
+    while ((1 << k) != *v) {
+        k++;
+    }
+    return k;
+}
+
+//
+// lower(inst,known)
+//
+// The lowered form of `inst`, or `inst` itself.
+//
+static INST lower(const INST& inst, const Cnst_map& known) {
+    Opnds srcs = inst.srcs();
+    Opnds dsts = inst.dsts();
+    if (srcs.size() != 2 || dsts.size() != 1) {
+        return inst;
+    }
+    Symb d = *dsts[0];
+    Symb s1 = *srcs[0];
+    Symb s2 = *srcs[1];
+    auto value_of = [&known](Symb nm) -> std::optional<int> {
+        auto kv = known.find(nm);
+        if (kv == known.end()) return std::nullopt;
+        return kv->second;
+    };
+    std::optional<int> v1 = value_of(s1);
+    std::optional<int> v2 = value_of(s2);
+
+    if (inst.as<ADD>()) {
+        if (v1 && !v2) {
+            std::swap(s1,s2);
+            std::swap(v1,v2);
+        }
+        if (v2 && *v2 == 0) return MOV {d,s1};
+        if (v2 && fits_16(*v2)) return ADDI {d,s1,*v2};
+    } else if (inst.as<SUB>()) {
+        if (v2 && *v2 == 0) return MOV {d,s1};
+        if (v2 && fits_16(-(long long)*v2)) return ADDI {d,s1,-*v2};
+    } else if (inst.as<SLT>()) {
+        if (v2 && fits_16(*v2)) return SLTI {d,s1,*v2};
+    } else if (inst.as<MUL>()) {
+        if (v1 && !v2) {
+            std::swap(s1,s2);
+            std::swap(v1,v2);
+        }
+        if (v2 && *v2 == 1) return MOV {d,s1};
+        if (std::optional<int> k = log_2(v2)) return MULP {d,s1,*k};
+    } else if (inst.as<DIV>()) {
+        if (v2 && *v2 == 1) return MOV {d,s1};
+        if (std::optional<int> k = log_2(v2)) return DIVP {d,s1,*k};
+    } else if (inst.as<MOD>()) {
+        if (v2 && *v2 == 1) return SET {d,0};
+        if (std::optional<int> k = log_2(v2)) return MODP {d,s1,*k};
+    }
+    return inst;
+}
+
+//
+// lower_arithmetic(symt,code)
+//
+void lower_arithmetic(SymT& symt, INST_vec& code) {
+    CFG cfg {code};
+    for (BBlk& blk : cfg.blocks) {
+        Cnst_map known {};
+        for (INST& inst : blk.code) {
+            inst = lower(inst,known);
+            for (Symb* dst : inst.dsts()) {
+                known.erase(*dst);
+            }
+            if (SET* set = inst.as<SET>()) {
+                known[set->dst] = set->val;
+            }
+        }
+    }
+    code = cfg.linearize(symt);
+}
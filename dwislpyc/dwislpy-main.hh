@@ -42,7 +42,14 @@ typedef std::shared_ptr<std::istream> istream_ptr;
  *   parse - runs the parser, building the AST
  *   set - sets the AST that results from a parse
  *   run - executes the parsed DwiDlpy program
+ *   compile - generates MIPS32, x86-64, or LLVM code, optimized by a given
+ *             pass manager, and reusing what it can from a given
+ *             cache (if any)
+ *   compile_and_run - compiles to MIPS32 and runs the code in SPIM
+ *   compile_image - compiles to MIPS32 and saves it as a SPIM image
+ *   interpret - runs the optimized IR in the IR interpreter
  *   dump - (pretty) prints the AST
+ *   dump_cfg - prints the control-flow graphs of the IR
  *
  * Note that the constructor attempts to create a stream attached to
  * the provided name of the DwiSlpy source file. However, the success
@@ -57,8 +64,12 @@ namespace DWISLPY {
         void parse(void);
         void run(void);
         void check(void);
-        void compile(void);
+        void compile(PassManager& passes, Cache* cache, Target target);
+        int compile_and_run(PassManager& passes);
+        void compile_image(PassManager& passes);
+        void interpret(PassManager& passes);
         void dump(bool pretty);
+        void dump_cfg(void);
         void set(Prgm_ptr prgm) { program = prgm; }
         std::string src_name;
     private:
@@ -1,15 +1,28 @@
 #include <iostream>
 #include <fstream>
+#include <vector>
+#include <memory>
+#include "dwislpy-emit.hh"
+#include "dwislpy-jobs.hh"
+#include "dwislpy-cach.hh"
 #include "dwislpy-inst.hh"
 #include "dwislpy-ast.hh"
 #include "dwislpy-check.hh"
 #include "dwislpy-util.hh"
+#include "dwislpy-opt.hh"
+#include "dwislpy-pass.hh"
+#include "dwislpy-live.hh"
+#include "dwislpy-regs.hh"
+#include "dwislpy-x86.hh"
+#include "dwislpy-llvm.hh"
+#include "dwislpy-spim.hh"
 
 //
 // dwislpy-mips.cc
 //
 // This gives the code for compiling the IR into MIPS32 code, outputting
-// it to a provided `std::ostream`. At the top level, it defines
+// it to a provided `AsmOut` (see `dwislpy-emit.hh`). At the top
+// level, it defines
 //
 //     Prgm::compile
 //
@@ -23,28 +36,66 @@
 // These functions, in turn, rely on `INST::toMIPS` which is
 // implemented for any sub-class of `INST`.
 //
+// Before generating each function's code, `compile_defn` runs the IR
+// optimization passes picked by the pass manager (see `dwislpy-pass.hh`
+// and `dwislpy-opt.hh`) and then the register
+// allocator (see `dwislpy-regs.hh`) so that `toMIPS` can work directly
+// with the registers holding variables and temporaries, loading and
+// storing only those that were spilled to the frame. The spilled ones
+// share frame slots when their lifetimes don't overlap, so a function's
+// frame grows with how many values are live at once rather than with
+// the length of its body.
+//
+// Functions that make no calls are "leaves". They keep their formals in
+// the argument registers they were passed in (see `allocate_registers`)
+// and don't save $ra. A leaf whose variables all fit in registers gets
+// no frame at all, and so ENTER and LEAVE emit nothing beyond `jr $ra`.
+//
 
-#define RETURN_ADDRESS "saved_return_address"
-#define FRAME_POINTER  "saved_frame_pointer"
-
-// compile_defn(os,symt,code)
+// prepare_defn(symt,code,passes)
 //
-// Generate MIPS32 code into `os`, relying on `symt` to figure out
-// frame locations of variables and temporaries. This sets up the
-// frame information, marking things in the `symt`, then walks through
-// `code` and converts each IR instruction (using `toMIPS`) into
-// MIPS32 code.
+// Optimize `code` with `passes`, allocate registers and set up the
+// frame information, marking things in the `symt`. This is all the
+// work of `compile_defn` but for generating the code, and is shared
+// with `load_defn_spim` (see `dwislpy-spim.hh`).
 //
-void compile_defn(std::ostream& os, SymT& symt, INST_vec& code) {
+void prepare_defn(SymT& symt, INST_vec& code, PassManager& passes) {
+
+    // Optimize the IR (see `dwislpy-pass.hh`).
+    passes.run(symt,code);
+
+    // Choose registers for the variables and temporaries, then share
+    // frame slots amongst those that were spilled.
+    Live live {code};
+    allocate_registers(symt,live,MIPS_REGS);
+    
     int num_frmls = symt.get_frmls_size();
-    int num_locls = symt.get_locls_size();
-    int num_cargs = 4; // Max # of args of any F/PCll within this def.
+    int num_slots = allocate_slots(symt,live,MIPS_REGS);
+    int num_saves = symt.get_saves_size();
+
+    // A leaf function makes no calls, so it needn't save $ra nor leave
+    // room for the arguments of calls. Tail calls don't count, since
+    // they leave $ra as it was. If it also has nothing to keep in
+    // memory then it needs no frame at all.
+    bool leaf = live.calls.empty();
+    bool spills = num_slots > 0 || num_saves > 0;
+    for (int i = 0; i < num_frmls; i++) {
+        if (symt.get_frml(i)->reg.empty()) {
+            spills = true;
+        }
+    }
+    int num_cargs = leaf ? 0 : 4; // Max # of args of any F/PCll within this def.
+    int num_links = leaf ? 1 : 2; // The saved $fp, and $ra if not a leaf.
+    symt.set_leaf(leaf);
 
     // Calculate a double-word aligned frame size.
-    int frame_size = 4*(num_locls + num_cargs + 2);
+    int frame_size = 4*(num_slots + num_saves + num_cargs + num_links);
     if (frame_size % 8 != 0) {
         frame_size += 4;
     }
+    if (leaf && !spills) {
+        frame_size = 0;
+    }
     
     //
     // Frame layout according to calling conventions.
@@ -55,71 +106,209 @@ void compile_defn(std::ostream& os, SymT& symt, INST_vec& code) {
     
     // Formal parameters sit above the frame.
     for (int i = 0; i < num_frmls; i++) {
-        std::string frml = symt.get_frml(i)->name;
-        symt.set_frame_offset(frml,i*4);
+        symt.set_frame_offset(symt.get_frml_symb(i),i*4);
     }
 
-    int offset = -4;
-        
-    // Locals sit next.
-    for (int i = 0; i < num_locls; i++) {
-        std::string locl = symt.get_locl(i)->name;
-        symt.set_frame_offset(locl,offset);
-        offset -= 4;
-    }
+    // Spilled locals sit next, in the slots given by `allocate_slots`.
+    int offset = -4 - 4*num_slots;
 
     // Saved registers sit next.
-    std::string ra = symt.add_locl(RETURN_ADDRESS, IntTy {}); // Not really an integer.
-    std::string fp = symt.add_locl(FRAME_POINTER, IntTy {});  // Not really an integer.
-    symt.set_frame_offset(ra,offset);
-    offset -= 4;
+    if (!leaf) {
+        Symb ra = symt.add_locl(RETURN_ADDRESS, IntTy {}); // Not really an integer.
+        symt.set_frame_offset(ra,offset);
+        offset -= 4;
+    }
+    Symb fp = symt.add_locl(FRAME_POINTER, IntTy {});  // Not really an integer.
     symt.set_frame_offset(fp,offset);
     offset -= 4;
 
+    // Saved callee-saved registers sit next.
+    for (int i = 0; i < num_saves; i++) {
+        Symb sv = symt.add_locl(SAVED_REGISTER + symt.get_save(i), IntTy {});
+        symt.set_frame_offset(sv,offset);
+        offset -= 4;
+    }
+
     // Possible arguments to calls sit last.
     
     symt.set_frame_size(frame_size);
+}
 
-    for (INST_ptr inst : code) {
-        inst->toMIPS(os,symt);
+// compile_defn(os,symt,code,passes)
+//
+// Generate MIPS32 code into `os`, relying on `symt` to figure out
+// registers and frame locations of variables and temporaries. This
+// prepares `code` with `prepare_defn`, then walks through `code` and
+// converts each IR instruction (using `toMIPS`) into MIPS32 code.
+//
+void compile_defn(AsmOut& os, SymT& symt, INST_vec& code,
+                  PassManager& passes) {
+    prepare_defn(symt,code,passes);
+    for (const INST& inst : code) {
+        inst.toMIPS(os,symt);
     }
 }
 
-// Prgm::compile(os)
+// output_string(os,data,target)
+//
+// Output the characters of a string constant, with each of its labels
+// placed at its offset. The characters before the last label are
+// output without a terminating zero.
+//
+static void output_string(AsmOut& os, const StrgData& data, Target target) {
+    if (target == LLVM_IR) {
+        output_string_llvm(os,data);
+        return;
+    }
+    const char* asciiz = target == X86_64 ? "\t.asciz " : "\t.asciiz ";
+    unsigned int at = 0;
+    for (std::pair<unsigned int,std::string> off_lbl : data.lbls) {
+        if (off_lbl.first > at) {
+            std::string part = data.strg.substr(at, off_lbl.first - at);
+            os << "\t.ascii \"" << re_escape(part) << "\"" << '\n';
+            at = off_lbl.first;
+        }
+        os << off_lbl.second << ":" << '\n';
+    }
+    os << asciiz << "\"" << re_escape(data.strg.substr(at)) << "\"" << '\n';
+}
+
+// output_strings(os,symt,target)
+//
+// Output the string constants kept by `symt` itself, each labelled.
+//
+static void output_strings(AsmOut& os, const SymT& symt, Target target) {
+    for (std::pair<Name,std::string> lbl_strg : symt.strings) {
+        output_string(os,StrgData {lbl_strg.second,{{0,lbl_strg.first}}},target);
+    }
+}
+
+// output_pool(os,pool,target)
+//
+// Output the string constants of `pool`, sharing the characters of
+// those that end others.
+//
+static void output_pool(AsmOut& os, const StrgPool& pool, Target target) {
+    for (const StrgData& data : pool.layout()) {
+        output_string(os,data,target);
+    }
+}
+
+// compile_target(os,symt,code,passes,target)
+//
+// Generate code for `target` into `os` with `compile_defn`,
+// `compile_defn_x86`, or `compile_defn_llvm`.
+//
+static void compile_target(AsmOut& os, SymT& symt, INST_vec& code,
+                           PassManager& passes, Target target) {
+    if (target == X86_64) {
+        compile_defn_x86(os,symt,code,passes);
+    } else if (target == LLVM_IR) {
+        compile_defn_llvm(os,symt,code,passes);
+    } else {
+        compile_defn(os,symt,code,passes);
+    }
+}
+
+// compile_cached(os,symt,code,passes,cache,target)
+//
+// Generate code for `target` into `os` with `compile_target`, unless
+// `cache` already has the code, in which case that's output instead.
+// `os` should be empty, so that what's added to it can be cached.
+//
+static void compile_cached(AsmOut& os, SymT& symt, INST_vec& code,
+                           PassManager& passes, Cache* cache,
+                           Target target) {
+    if (cache == nullptr) {
+        compile_target(os,symt,code,passes,target);
+        return;
+    }
+    std::string tag = target == X86_64 ? "x86-64 "
+                      : target == LLVM_IR ? "llvm " : "mips ";
+    std::string key = Cache::key_of(tag + passes.list(),symt,code);
+    std::string text;
+    if (cache->fetch(key,text)) {
+        os << text;
+    } else {
+        compile_target(os,symt,code,passes,target);
+        cache->store(key,os.text());
+    }
+}
+
+// Prgm::compile(os,passes,cache,target)
 //
 // Generate MIPS32 code into `os`, relying on `compile_defn` to generate
-// the machine code for each of the `def`s and the `main` script. It also
+// the machine code for each of the `def`s and the `main` script, each
+// optimized by `passes`, on as many threads as `passes` says. The code
+// of each is looked up in `cache` first, if there is one. It also
 // sets up the global information about all the string constants that were
 // discovered duting translation to the IR. 
 //
 // The resulting file (represented by `os`) will contain a SPIM-executable
-// .s file.
+// .s file. If `target` is X86_64 it instead contains x86-64 code for the
+// GNU assembler, along with the runtime that it calls on. If it's
+// LLVM_IR it contains an LLVM module, with the string constants and
+// functions in the same order.
 //
-void Prgm::compile(std::ostream& os) {
+void Prgm::compile(AsmOut& os, PassManager& passes, Cache* cache,
+                   Target target) {
 
-    // Translate the AST to IR.
+    // Translate the AST to IR, then run the whole-program passes, such
+    // as inlining calls to small `def`s.
     //
-    trans();
+    trans(passes.get_jobs());
+    std::unordered_set<std::string> called = passes.run(defs,main_symt,main_code);
 
-    // Generate the `.data` section filled with string constants.
+    // Generate the `.data` section filled with string constants. Those
+    // of a `def` whose calls were all inlined are still needed.
     //
-    os << "\t.data" << std::endl;
-    for (std::pair<Name,std::string> lbl_strg : glbl_symt_ptr->strings) {
-        std::string lbl = lbl_strg.first;
-        std::string strg = "\"" + re_escape(lbl_strg.second) + "\"";
-        os << lbl << ":" << std::endl;
-        os << "\t.asciiz " << strg << std::endl;
+    if (target != LLVM_IR) {
+        os << "\t.data" << '\n';
+    }
+    output_pool(os,*glbl_symt_ptr->get_pool(),target);
+    output_strings(os,*glbl_symt_ptr,target);
+    output_strings(os,main_symt,target);
+    for (std::pair<Name,Defn_ptr> dfpr : defs) {
+        output_strings(os,dfpr.second->symt,target);
     }
     
     // Generate the `.text` section filled with `main` and each `def`'s
-    // (labelled) code.
+    // (labelled) code. Each is compiled into a buffer of its own, on
+    // several threads, and the buffers are output in order.
     //
-    os << "\t.text" << std::endl;
-    os << "\t.globl main" << std::endl;
-    compile_defn(os,main_symt,main_code);
+    if (target == X86_64) {
+        os << "\t.text" << '\n';
+        os << "\t.globl _start" << '\n';
+    } else if (target == MIPS32) {
+        os << "\t.text" << '\n';
+        os << "\t.globl main" << '\n';
+    }
+    std::vector<Defn_ptr> defns {};
     for (std::pair<Name,Defn_ptr> dfpr : defs) {
-        Defn_ptr defn = dfpr.second;
-        compile_defn(os,defn->symt,defn->code);
+        if (called.count(dfpr.first) > 0) {
+            defns.push_back(dfpr.second);
+        } // Otherwise every call to it was inlined.
+    }
+    std::vector<std::unique_ptr<AsmOut>> outs {};
+    for (unsigned int i = 0; i <= defns.size(); i++) {
+        outs.push_back(std::unique_ptr<AsmOut> {new AsmOut {}});
+    }
+    run_jobs(outs.size(), passes.get_jobs(), [&](int i) {
+        if (i == 0) {
+            compile_cached(*outs[i],main_symt,main_code,passes,cache,target);
+        } else {
+            Defn_ptr defn = defns[i-1];
+            compile_cached(*outs[i],defn->symt,defn->code,passes,cache,
+                           target);
+        }
+    });
+    for (std::unique_ptr<AsmOut>& out : outs) {
+        os << out->text();
+    }
+    if (target == X86_64) {
+        output_runtime_x86(os);
+    } else if (target == LLVM_IR) {
+        output_runtime_llvm(os);
     }
 }
 
@@ -130,149 +319,362 @@ void Prgm::compile(std::ostream& os) {
 // pseudo-instruction (an object derived from class INST).
 //
 // The method outputs a series of MIPS instructions to the output
-// stream `os`, using information about frame variables and strings
-// held in `symt`. In particular, it loads variables from the stack
-// frame at their assigned offset within the frame to set some MIPS
-// registers and/or stores register values to the stack frame if they
-// are being updated.
+// stream `os`, using information about registers, frame variables, and
+// strings held in `symt`. Variables and temporaries that were given a
+// register are used in place. Spilled ones are loaded from the stack
+// frame at their assigned offset into a scratch register and/or
+// stored back to the stack frame if they are being updated. The three
+// helpers below do this work.
 // 
 // We define this method for each subclass of INST.
 //
 //
-void ENTER::toMIPS(std::ostream& os, const SymT& symt) const {
-    int ra_slot = symt.get_frame_offset(RETURN_ADDRESS);
-    int fp_slot = symt.get_frame_offset(FRAME_POINTER);
-    os << "\t" << "sw $ra," << ra_slot << "($sp)" << std::endl;
-    os << "\t" << "sw $fp," << fp_slot << "($sp)" << std::endl;
-    os << "\t" << "move $fp, $sp" << std::endl;
-    os << "\t" << "addi $sp,$sp,-" << symt.get_frame_size() << std::endl;
-    for (int argi = 0; argi < symt.get_frmls_size(); argi++) {
-        std::string pram = symt.get_frml(argi)->name;
-        int slot = symt.get_frame_offset(pram);
-        os << "\t" << "sw $a" << argi << "," << slot << "($fp)" << std::endl;
+
+//
+// src_reg(os,symt,nm,scratch)
+//
+// Gives the register holding the value of `nm`, first loading it into
+// the `scratch` register if `nm` was spilled.
+//
+static std::string src_reg(AsmOut& os, const SymT& symt,
+                           Symb nm, std::string scratch) {
+    std::string reg = symt.get_reg(nm);
+    if (reg.empty()) {
+        os << "\t" << "lw " << scratch << "," << symt.get_frame_offset(nm) << "($fp)" << '\n';
+        return scratch;
     }
+    return reg;
 }
+
+//
+// dst_reg(symt,nm,scratch)
 //
-void LEAVE::toMIPS(std::ostream& os, const SymT& symt) const {
-    int ra_slot = symt.get_frame_offset(RETURN_ADDRESS);
-    int fp_slot = symt.get_frame_offset(FRAME_POINTER);
-    os << "\t" << "lw $ra," << ra_slot << "($fp)" << std::endl;
-    os << "\t" << "lw $fp," << fp_slot << "($fp)" << std::endl;
-    os << "\t" << "addi $sp,$sp," << symt.get_frame_size() << std::endl;
-    os << "\t" << "jr $ra" << std::endl;
+// Gives the register where a value for `nm` should be placed. This is
+// `scratch` if `nm` was spilled, to be followed by a `dst_put`.
+//
+static std::string dst_reg(const SymT& symt, Symb nm, std::string scratch) {
+    std::string reg = symt.get_reg(nm);
+    if (reg.empty()) {
+        return scratch;
+    }
+    return reg;
 }
-void SET::toMIPS(std::ostream& os, const SymT& symt) const {
-  os << "\t" << "li $t0," << val << std::endl;
-  os << "\t" << "sw $t0," << symt.get_frame_offset(dst) << "($fp)" << std::endl;
+
+//
+// dst_put(os,symt,nm,reg)
+//
+// Stores the value placed in `reg` to the frame slot of `nm` if `nm`
+// was spilled.
+//
+static void dst_put(AsmOut& os, const SymT& symt,
+                    Symb nm, std::string reg) {
+    if (symt.get_reg(nm).empty()) {
+        os << "\t" << "sw " << reg << "," << symt.get_frame_offset(nm) << "($fp)" << '\n';
+    }
+}
+
+void ENTER::toMIPS(AsmOut& os, const SymT& symt) const {
+    if (symt.get_frame_size() > 0) {
+        int fp_slot = symt.get_frame_offset(FRAME_POINTER);
+        if (!symt.is_leaf()) {
+            int ra_slot = symt.get_frame_offset(RETURN_ADDRESS);
+            os << "\t" << "sw $ra," << ra_slot << "($sp)" << '\n';
+        }
+        os << "\t" << "sw $fp," << fp_slot << "($sp)" << '\n';
+        os << "\t" << "move $fp, $sp" << '\n';
+        os << "\t" << "addi $sp,$sp,-" << symt.get_frame_size() << '\n';
+    }
+    for (unsigned int i = 0; i < symt.get_saves_size(); i++) {
+        std::string reg = symt.get_save(i);
+        int slot = symt.get_frame_offset(SAVED_REGISTER + reg);
+        os << "\t" << "sw " << reg << "," << slot << "($fp)" << '\n';
+    }
+    for (unsigned int argi = 0; argi < symt.get_frmls_size(); argi++) {
+        Symb pram = symt.get_frml_symb(argi);
+        std::string reg = symt.get_reg(pram);
+        std::string areg = "$a" + std::to_string(argi);
+        if (reg.empty()) {
+            int slot = symt.get_frame_offset(pram);
+            os << "\t" << "sw " << areg << "," << slot << "($fp)" << '\n';
+        } else if (reg != areg) {
+            os << "\t" << "move " << reg << "," << areg << '\n';
+        }
+    }
+}
+//
+// take_down(os,symt)
+//
+// Restore the registers saved by ENTER and pop the frame.
+//
+static void take_down(AsmOut& os, const SymT& symt) {
+    for (unsigned int i = 0; i < symt.get_saves_size(); i++) {
+        std::string reg = symt.get_save(i);
+        int slot = symt.get_frame_offset(SAVED_REGISTER + reg);
+        os << "\t" << "lw " << reg << "," << slot << "($fp)" << '\n';
+    }
+    if (symt.get_frame_size() > 0) {
+        int fp_slot = symt.get_frame_offset(FRAME_POINTER);
+        if (!symt.is_leaf()) {
+            int ra_slot = symt.get_frame_offset(RETURN_ADDRESS);
+            os << "\t" << "lw $ra," << ra_slot << "($fp)" << '\n';
+        }
+        os << "\t" << "lw $fp," << fp_slot << "($fp)" << '\n';
+        os << "\t" << "addi $sp,$sp," << symt.get_frame_size() << '\n';
+    }
+}
+//
+void LEAVE::toMIPS(AsmOut& os, const SymT& symt) const {
+    take_down(os,symt);
+    os << "\t" << "jr $ra" << '\n';
+}
+//
+void TCLL::toMIPS(AsmOut& os, const SymT& symt) const {
+    take_down(os,symt);
+    os << "\t" << "j " << lbl << '\n';
+}
+void SET::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rd = dst_reg(symt,dst,"$t0");
+    os << "\t" << "li " << rd << "," << val << '\n';
+    dst_put(os,symt,dst,rd);
+}
+//
+void STL::toMIPS(AsmOut& os, const SymT& symt) const { 
+    std::string rd = dst_reg(symt,dst,"$t0");
+    os << "\t" << "la " << rd << "," << lbl << '\n';
+    dst_put(os,symt,dst,rd);
+}
+//
+void MOV::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"$t1");
+    std::string rd = dst_reg(symt,dst,"$t0");
+    if (rd != rs) {
+        os << "\t" << "move " << rd << "," << rs << '\n';
+    }
+    dst_put(os,symt,dst,rd);
+}
+//
+void RTV::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rd = dst_reg(symt,dst,"$v0");
+    if (rd != "$v0") {
+        os << "\t" << "move " << rd << ",$v0" << '\n';
+    }
+    dst_put(os,symt,dst,rd);
+}
+//
+void GTI::toMIPS(AsmOut& os, const SymT& symt) const {
+    os << "\t" << "li $v0,5" << '\n';
+    os << "\t" << "syscall" << '\n';
+    std::string rd = dst_reg(symt,dst,"$v0");
+    if (rd != "$v0") {
+        os << "\t" << "move " << rd << ",$v0" << '\n';
+    }
+    dst_put(os,symt,dst,rd);
+}
+//
+void NOP::toMIPS(AsmOut& os, [[maybe_unused]] const SymT& symt) const {
+    os << "\t" << "nop" << '\n';
+}
+//
+void PTI::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"$a0");
+    if (rs != "$a0") {
+        os << "\t" << "move $a0," << rs << '\n';
+    }
+    os << "\t" << "li $v0,1" << '\n';
+    os << "\t" << "syscall" << '\n';
+}
+//
+void PTS::toMIPS(AsmOut& os, const SymT& symt) const {
+    os << "\t" << "li $v0,4" << '\n';
+    std::string rs = src_reg(os,symt,src,"$a0");
+    if (rs != "$a0") {
+        os << "\t" << "move $a0," << rs << '\n';
+    }
+    os << "\t" << "syscall" << '\n';
+}
+//
+// arith(os,symt,op,dst,src1,src2)
+//
+// Shared by the three-register arithmetic instructions.
+//
+static void arith(AsmOut& os, const SymT& symt, std::string op,
+                  Symb dst, Symb src1, Symb src2) {
+    std::string rs = src_reg(os,symt,src1,"$t1");
+    std::string rt = src_reg(os,symt,src2,"$t2");
+    std::string rd = dst_reg(symt,dst,"$t0");
+    os << "\t" << op << " " << rd << "," << rs << "," << rt << '\n';
+    dst_put(os,symt,dst,rd);
+}
+//
+void ADD::toMIPS(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"add",dst,src1,src2);
+}
+//
+void SUB::toMIPS(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"sub",dst,src1,src2);
 }
 //
-void STL::toMIPS(std::ostream& os, const SymT& symt) const { 
-    os << "\t" << "la $t0," << lbl << std::endl;
-    os << "\t" << "sw $t0," << symt.get_frame_offset(dst) << "($fp)" << std::endl;
+void MUL::toMIPS(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"mul",dst,src1,src2);
 }
 //
-void MOV::toMIPS(std::ostream& os, const SymT& symt) const {
-  os << "\t" << "lw $t1," << symt.get_frame_offset(src) << "($fp)" << std::endl;
-  os << "\t" << "move $t0,$t1" << std::endl;
-  os << "\t" << "sw $t0," << symt.get_frame_offset(dst) << "($fp)" << std::endl;
+void DIV::toMIPS(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"div",dst,src1,src2);
 }
 //
-void RTV::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "move $t0,$v0" << std::endl;
-    os << "\t" << "sw $t0," << symt.get_frame_offset(dst) << "($fp)" << std::endl;
+void MOD::toMIPS(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"rem",dst,src1,src2);
 }
 //
-void GTI::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "li $v0,5" << std::endl;
-    os << "\t" << "syscall" << std::endl;
-    os << "\t" << "sw $v0," << symt.get_frame_offset(dst) << "($fp)" << std::endl;
+void ADDI::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"$t1");
+    std::string rd = dst_reg(symt,dst,"$t0");
+    os << "\t" << "addi " << rd << "," << rs << "," << val << '\n';
+    dst_put(os,symt,dst,rd);
 }
 //
-void NOP::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "nop" << std::endl;
+void ADDIU::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"$t1");
+    std::string rd = dst_reg(symt,dst,"$t0");
+    os << "\t" << "addiu " << rd << "," << rs << "," << val << '\n';
+    dst_put(os,symt,dst,rd);
 }
 //
-void PTI::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "lw $a0," << symt.get_frame_offset(src) << "($fp)" << std::endl;
-    os << "\t" << "li $v0,1" << std::endl;
-    os << "\t" << "syscall" << std::endl;
+void SLTI::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"$t1");
+    std::string rd = dst_reg(symt,dst,"$t0");
+    os << "\t" << "slti " << rd << "," << rs << "," << val << '\n';
+    dst_put(os,symt,dst,rd);
 }
 //
-void PTS::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "li $v0,4" << std::endl;
-    os << "\t" << "lw $a0," << symt.get_frame_offset(src) << "($fp)" << std::endl;
-    os << "\t" << "syscall" << std::endl;
+void MULP::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"$t1");
+    std::string rd = dst_reg(symt,dst,"$t0");
+    os << "\t" << "sll " << rd << "," << rs << "," << val << '\n';
+    dst_put(os,symt,dst,rd);
 }
 //
-void ADD::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "lw $t1," << symt.get_frame_offset(src1) << "($fp)" << std::endl;
-    os << "\t" << "lw $t2," << symt.get_frame_offset(src2) << "($fp)" << std::endl;
-    os << "\t" << "add $t0,$t1,$t2" << std::endl;
-    os << "\t" << "sw $t0," << symt.get_frame_offset(dst) << "($fp)" << std::endl;
+// DIVP and MODP add 2^k-1 to a negative dividend before shifting or
+// masking so that the quotient is truncated towards zero rather than
+// rounded down. That bias is built in $t2 from the dividend's sign.
+//
+static void bias(AsmOut& os, std::string rs, int k) {
+    if (k == 1) {
+        os << "\t" << "srl $t2," << rs << ",31" << '\n';
+    } else {
+        os << "\t" << "sra $t2," << rs << ",31" << '\n';
+        os << "\t" << "srl $t2,$t2," << 32-k << '\n';
+    }
+}
+//
+void DIVP::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"$t1");
+    std::string rd = dst_reg(symt,dst,"$t0");
+    bias(os,rs,val);
+    os << "\t" << "addu $t2," << rs << ",$t2" << '\n';
+    os << "\t" << "sra " << rd << ",$t2," << val << '\n';
+    dst_put(os,symt,dst,rd);
 }
 //
-void SUB::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "lw $t1," << symt.get_frame_offset(src1) << "($fp)" << std::endl;
-    os << "\t" << "lw $t2," << symt.get_frame_offset(src2) << "($fp)" << std::endl;
-    os << "\t" << "sub $t0,$t1,$t2" << std::endl;
-    os << "\t" << "sw $t0," << symt.get_frame_offset(dst) << "($fp)" << std::endl;
+void MODP::toMIPS(AsmOut& os, const SymT& symt) const {
+    // The remainder is ((s + bias) mod 2^k) - bias.
+    std::string rs = src_reg(os,symt,src,"$t1");
+    std::string rd = dst_reg(symt,dst,"$t0");
+    bias(os,rs,val);
+    os << "\t" << "addu $t1," << rs << ",$t2" << '\n';
+    if (val <= 16) {
+        os << "\t" << "andi $t1,$t1," << (1 << val) - 1 << '\n';
+    } else {
+        os << "\t" << "sll $t1,$t1," << 32-val << '\n';
+        os << "\t" << "srl $t1,$t1," << 32-val << '\n';
+    }
+    os << "\t" << "subu " << rd << ",$t1,$t2" << '\n';
+    dst_put(os,symt,dst,rd);
 }
 //
-void MUL::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "lw $t1," << symt.get_frame_offset(src1) << "($fp)" << std::endl;
-    os << "\t" << "lw $t2," << symt.get_frame_offset(src2) << "($fp)" << std::endl;
-    os << "\t" << "mult $t0,$t1,$t2" << std::endl;
-    os << "\t" << "sw $t0," << symt.get_frame_offset(dst) << "($fp)" << std::endl;
+void SLT::toMIPS(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"slt",dst,src1,src2);
 }
 //
-void DIV::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "lw $t1," << symt.get_frame_offset(src1) << "($fp)" << std::endl;
-    os << "\t" << "lw $t2," << symt.get_frame_offset(src2) << "($fp)" << std::endl;
-    os << "\t" << "div $t0,$t1,$t2" << std::endl;
-    os << "\t" << "sw $t0," << symt.get_frame_offset(dst) << "($fp)" << std::endl;
+void SLE::toMIPS(AsmOut& os, const SymT& symt) const {
+    // s1 <= s2 exactly when not s2 < s1.
+    std::string rs = src_reg(os,symt,src1,"$t1");
+    std::string rt = src_reg(os,symt,src2,"$t2");
+    std::string rd = dst_reg(symt,dst,"$t0");
+    os << "\t" << "slt " << rd << "," << rt << "," << rs << '\n';
+    os << "\t" << "xori " << rd << "," << rd << ",1" << '\n';
+    dst_put(os,symt,dst,rd);
 }
 //
-void MOD::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "lw $t1," << symt.get_frame_offset(src1) << "($fp)" << std::endl;
-    os << "\t" << "lw $t2," << symt.get_frame_offset(src2) << "($fp)" << std::endl;
-    os << "\t" << "rem $t0,$t1,$t2" << std::endl;
-    os << "\t" << "sw $t0," << symt.get_frame_offset(dst) << "($fp)" << std::endl;
+void SEQ::toMIPS(AsmOut& os, const SymT& symt) const {
+    // s1 == s2 exactly when their bitwise difference is below 1.
+    std::string rs = src_reg(os,symt,src1,"$t1");
+    std::string rt = src_reg(os,symt,src2,"$t2");
+    std::string rd = dst_reg(symt,dst,"$t0");
+    os << "\t" << "xor " << rd << "," << rs << "," << rt << '\n';
+    os << "\t" << "sltiu " << rd << "," << rd << ",1" << '\n';
+    dst_put(os,symt,dst,rd);
 }
 //
-void RTN::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "lw $v0," << symt.get_frame_offset(src) << "($fp)" << std::endl;
+void AND::toMIPS(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"and",dst,src1,src2);
 }
 //
-void BCN::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "lw $t1," << symt.get_frame_offset(src1) << "($fp)" << std::endl;
-    os << "\t" << "lw $t2," << symt.get_frame_offset(src2) << "($fp)" << std::endl;
-    os << "\t" << "b" << cndn << " $t1,$t2," << lblt << std::endl;
-    os << "\t" << "j " << lblf << std::endl;
+void OR::toMIPS(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"or",dst,src1,src2);
 }
 //
-void BCZ::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "lw $t1," << symt.get_frame_offset(src) << "($fp)" << std::endl;
-    os << "\t" << "b" << cndn << " $t1," << lblt << std::endl;
-    os << "\t" << "j " << lblf << std::endl;
+void NOT::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"$t1");
+    std::string rd = dst_reg(symt,dst,"$t0");
+    os << "\t" << "xori " << rd << "," << rs << ",1" << '\n';
+    dst_put(os,symt,dst,rd);
 }
 //
-void JMP::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "j " << lbl << std::endl;
+void RTN::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"$v0");
+    if (rs != "$v0") {
+        os << "\t" << "move $v0," << rs << '\n';
+    }
 }
 //
-void CLL::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "jal " << lbl << std::endl;
+void BCN::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src1,"$t1");
+    std::string rt = src_reg(os,symt,src2,"$t2");
+    os << "\t" << "b" << cndn_name(cndn) << " " << rs << "," << rt << "," << lblt << '\n';
+    if (!lblf.empty()) {
+        os << "\t" << "j " << lblf << '\n';
+    }
 }
 //
-void LBL::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << lbl << ":" << std::endl;
+void BCZ::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"$t1");
+    os << "\t" << "b" << cndn_name(cndn) << " " << rs << "," << lblt << '\n';
+    if (!lblf.empty()) {
+        os << "\t" << "j " << lblf << '\n';
+    }
 }
 //
-void CMT::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t\t\t\t#" << msg << std::endl;
+void JMP::toMIPS(AsmOut& os, [[maybe_unused]] const SymT& symt) const {
+    os << "\t" << "j " << lbl << '\n';
 }
 //
-void ARG::toMIPS(std::ostream& os, const SymT& symt) const {
-    os << "\t" << "lw $a" << idx << ","
-       << symt.get_frame_offset(src) << "($fp)" << std::endl;
+void CLL::toMIPS(AsmOut& os, [[maybe_unused]] const SymT& symt) const {
+    os << "\t" << "jal " << lbl << '\n';
+}
+//
+void LBL::toMIPS(AsmOut& os, [[maybe_unused]] const SymT& symt) const {
+    os << lbl << ":" << '\n';
+}
+//
+void CMT::toMIPS(AsmOut& os, [[maybe_unused]] const SymT& symt) const {
+    os << "\t\t\t\t#" << msg << '\n';
+}
+//
+void ARG::toMIPS(AsmOut& os, const SymT& symt) const {
+    std::string ra = "$a" + std::to_string(idx);
+    std::string rs = src_reg(os,symt,src,ra);
+    if (rs != ra) {
+        os << "\t" << "move " << ra << "," << rs << '\n';
+    }
 }
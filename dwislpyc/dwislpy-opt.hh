@@ -0,0 +1,62 @@
+#ifndef _DWISLPY_OPT_HH
+#define _DWISLPY_OPT_HH
+
+//
+// dwislpy-opt.hh
+//
+// Optimization passes over the IR code of a `def` or the `main` script.
+//
+// Each pass takes the function's symbol table and its code, and
+// rewrites the code in place. They run after translation to IR
+// (`Prgm::trans`) and before register allocation and the generation
+// of MIPS code (see `compile_defn`). Which of them run, and in what
+// order, is up to the pass manager (see `dwislpy-pass.hh`). Most work over the code's
+// control-flow graph (see `dwislpy-cfg.hh`) and so each is kept in
+// its own source file:
+//
+// * inline_calls (dwislpy-inln.cc) - replaces calls to small `def`s
+//       with copies of their code. Unlike the others, this works on
+//       the whole program, before the per-function passes. It gives
+//       the names of the `def`s that are still called afterwards.
+//
+// * eliminate_tail_calls (dwislpy-tail.cc) - turns calls whose value
+//       is returned straight away into jumps. This should be the
+//       first of these, since it looks for the code as translated.
+// * propagate_constants (dwislpy-cnst.cc) - conditional constant
+//       propagation. Folds arithmetic on known values, resolves
+//       branches with known outcomes, and deletes unreachable code.
+// * propagate_copies (dwislpy-copy.cc) - replaces reads of a variable
+//       that was copied from another by reads of the original.
+// * remove_dead_code (dwislpy-dead.cc) - deletes instructions whose
+//       only effect is to write a variable that's never read again.
+// * lower_arithmetic (dwislpy-lowr.cc) - uses the immediate forms of
+//       instructions where an operand is a known constant, and shifts
+//       for multiplying, dividing, and taking remainders by powers
+//       of two.
+// * optimize_loops (dwislpy-loop.cc) - moves computations that don't
+//       change within a loop to just before it, and replaces products
+//       of a loop's counters by constants with running sums.
+// * layout_blocks (dwislpy-layo.cc) - orders the blocks so that they
+//       fall into their successors, removing the jumps that aren't
+//       needed. This should be the last pass, since it leaves
+//       branches that fall through.
+//
+
+#include <string>
+#include <unordered_set>
+#include "dwislpy-ast.hh"
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+
+std::unordered_set<std::string> inline_calls(Defs& defs, SymT& main_symt,
+                                             INST_vec& main_code);
+
+void eliminate_tail_calls(SymT& symt, INST_vec& code);
+void propagate_constants(SymT& symt, INST_vec& code);
+void propagate_copies(SymT& symt, INST_vec& code);
+void remove_dead_code(SymT& symt, INST_vec& code);
+void lower_arithmetic(SymT& symt, INST_vec& code);
+void optimize_loops(SymT& symt, INST_vec& code);
+void layout_blocks(SymT& symt, INST_vec& code);
+
+#endif
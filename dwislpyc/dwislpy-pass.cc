@@ -0,0 +1,223 @@
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <mutex>
+#include "dwislpy-util.hh"
+#include "dwislpy-opt.hh"
+#include "dwislpy-pass.hh"
+#include "dwislpy-jobs.hh"
+
+//
+// dwislpy-pass.cc
+//
+// The pass manager. See `dwislpy-pass.hh`.
+//
+
+typedef std::chrono::steady_clock Clock;
+
+static double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+//
+// PassManager()
+//
+// Runs the passes of -O2.
+//
+PassManager::PassManager(void) :
+    passes {}, inlines {false}, stats {false}, jobs {default_jobs()},
+    stat_list {}, stat_lock {}
+{
+    set_level(2);
+}
+
+//
+// PassManager::level(lvl)
+//
+// The passes run at optimization level `lvl`.
+//
+std::vector<std::string> PassManager::level(int lvl) {
+    if (lvl <= 0) {
+        return {};
+    }
+    if (lvl == 1) {
+        return {"const","copy","lower","dead","layout"};
+    }
+    return {"inline","tail","const","copy","lower","dead",
+            "loop","const","copy","dead","layout"};
+}
+
+//
+// PassManager::pass_of(name)
+//
+// The per-function pass with the given name, or `nullptr` if there's
+// none (as for `inline`).
+//
+Pass_fn PassManager::pass_of(std::string name) {
+    if (name == "tail")   return eliminate_tail_calls;
+    if (name == "const")  return propagate_constants;
+    if (name == "copy")   return propagate_copies;
+    if (name == "lower")  return lower_arithmetic;
+    if (name == "dead")   return remove_dead_code;
+    if (name == "loop")   return optimize_loops;
+    if (name == "layout") return layout_blocks;
+    return nullptr;
+}
+
+void PassManager::set_level(int lvl) {
+    set_passes(level(lvl));
+}
+
+//
+// PassManager::set_passes(names)
+//
+// Run the passes with the given `names`, in that order. Throws a
+// DwislpyError if one of them isn't the name of a pass.
+//
+void PassManager::set_passes(std::vector<std::string> names) {
+    passes.clear();
+    inlines = false;
+    for (std::string name : names) {
+        if (name == "inline") {
+            inlines = true;
+        } else if (pass_of(name) != nullptr) {
+            passes.push_back(name);
+        } else {
+            std::string msg = "Unknown optimization pass '" + name + "'.";
+            throw DwislpyError {Locn {"dwislpyc"}, msg};
+        }
+    }
+}
+
+void PassManager::set_passes(std::string list) {
+    std::vector<std::string> names {};
+    size_t start = 0;
+    while (start <= list.size()) {
+        size_t comma = list.find(',',start);
+        if (comma == std::string::npos) {
+            comma = list.size();
+        }
+        if (comma > start) {
+            names.push_back(list.substr(start,comma-start));
+        }
+        start = comma+1;
+    }
+    set_passes(names);
+}
+
+//
+// PassManager::list()
+//
+// The names of the per-function passes, separated by commas, as they
+// would be given to `--passes=`.
+//
+std::string PassManager::list(void) const {
+    std::string names = "";
+    for (std::string name : passes) {
+        names += (names.empty() ? "" : ",") + name;
+    }
+    return names;
+}
+
+//
+// PassManager::stat_of(name)
+//
+// The statistics for the named pass, in the order the passes first ran.
+//
+PassStat& PassManager::stat_of(std::string name) {
+    for (PassStat& stat : stat_list) {
+        if (stat.name == name) {
+            return stat;
+        }
+    }
+    stat_list.push_back(PassStat {name});
+    return stat_list.back();
+}
+
+//
+// PassManager::run(defs,main_symt,main_code)
+//
+// Run the whole-program passes. Gives the names of the `def`s whose
+// code is still needed afterwards.
+//
+std::unordered_set<std::string> PassManager::run(Defs& defs, SymT& main_symt,
+                                                 INST_vec& main_code) {
+    if (inlines) {
+        long before = main_code.size();
+        for (std::pair<Name,Defn_ptr> dfpr : defs) {
+            before += dfpr.second->code.size();
+        }
+        Clock::time_point start = Clock::now();
+        std::unordered_set<std::string> called = inline_calls(defs,main_symt,main_code);
+        double secs = seconds_since(start);
+        if (stats) {
+            long after = main_code.size();
+            for (std::string name : called) {
+                after += defs.at(name)->code.size();
+            }
+            PassStat& stat = stat_of("inline");
+            stat.runs++;
+            stat.removed += before - after;
+            stat.seconds += secs;
+        }
+        return called;
+    }
+    std::unordered_set<std::string> called {};
+    for (std::pair<Name,Defn_ptr> dfpr : defs) {
+        called.insert(dfpr.first);
+    }
+    return called;
+}
+
+//
+// PassManager::run(symt,code)
+//
+// Run the per-function passes over the code of a `def` or the main
+// script. This can be called for several functions at once.
+//
+void PassManager::run(SymT& symt, INST_vec& code) {
+    for (std::string name : passes) {
+        long before = code.size();
+        Clock::time_point start = Clock::now();
+        pass_of(name)(symt,code);
+        double secs = seconds_since(start);
+        if (stats) {
+            std::lock_guard<std::mutex> hold {stat_lock};
+            PassStat& stat = stat_of(name);
+            stat.runs++;
+            stat.removed += before - (long)code.size();
+            stat.seconds += secs;
+        }
+    }
+}
+
+//
+// PassManager::report(os)
+//
+// Output the statistics gathered for each pass that ran.
+//
+void PassManager::report(std::ostream& os) const {
+    os << std::left << std::setw(8) << "pass"
+       << std::right << std::setw(6) << "runs"
+       << std::setw(10) << "removed"
+       << std::setw(12) << "ms" << std::endl;
+    long removed = 0;
+    double seconds = 0.0;
+    for (const PassStat& stat : stat_list) {
+        os << std::left << std::setw(8) << stat.name
+           << std::right << std::setw(6) << stat.runs
+           << std::setw(10) << stat.removed
+           << std::setw(12) << std::fixed << std::setprecision(3)
+           << stat.seconds * 1000.0 << std::endl;
+        removed += stat.removed;
+        seconds += stat.seconds;
+    }
+    os << std::left << std::setw(8) << "total"
+       << std::right << std::setw(6) << ""
+       << std::setw(10) << removed
+       << std::setw(12) << std::fixed << std::setprecision(3)
+       << seconds * 1000.0 << std::endl;
+}
@@ -0,0 +1,106 @@
+#ifndef _DWISLPY_PASS_HH
+#define _DWISLPY_PASS_HH
+
+//
+// dwislpy-pass.hh
+//
+// The pass manager. This picks which of the IR optimization passes (see
+// `dwislpy-opt.hh`) run, and in what order, and keeps statistics about
+// them.
+//
+// Each pass has a short name, used by the `--passes=` option:
+//
+//     inline - inline_calls
+//     tail   - eliminate_tail_calls
+//     const  - propagate_constants
+//     copy   - propagate_copies
+//     lower  - lower_arithmetic
+//     dead   - remove_dead_code
+//     loop   - optimize_loops
+//     layout - layout_blocks
+//
+// A pass can be listed more than once. `inline` works on the whole
+// program and so always runs first, before the others run on each
+// function in the order they're listed. `tail` looks for calls as they
+// were translated and `layout` leaves branches that fall through, so
+// these are best listed first and last.
+//
+// The optimization levels give these lists of passes:
+//
+//     -O0 - none
+//     -O1 - const copy lower dead layout
+//     -O2 - inline tail const copy lower dead loop const copy dead layout
+//
+// with -O2 being the default.
+//
+// With statistics turned on, `report` gives for each pass the number
+// of times it ran, the number of instructions it removed over all those
+// runs (negative if it added some), and the time it took.
+//
+// The per-function passes are run on each function independently, and
+// so the compiler translates and compiles functions on `jobs` threads
+// at once (see `dwislpy-jobs.hh`). The time reported for a pass is
+// summed over those threads.
+//
+
+#include <string>
+#include <vector>
+#include <unordered_set>
+#include <iostream>
+#include <mutex>
+#include "dwislpy-ast.hh"
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+
+typedef void (*Pass_fn)(SymT& symt, INST_vec& code);
+
+//
+// class PassStat
+//
+// The statistics gathered for a pass.
+//
+class PassStat {
+public:
+    std::string name;
+    int runs;
+    long removed;      // Instructions removed, less those added.
+    double seconds;
+    //
+    PassStat(std::string nm) :
+        name {nm}, runs {0}, removed {0}, seconds {0.0} { }
+};
+
+//
+// class PassManager
+//
+class PassManager {
+private:
+    std::vector<std::string> passes;
+    bool inlines;
+    bool stats;
+    int jobs;
+    std::vector<PassStat> stat_list;
+    std::mutex stat_lock;  // Guards `stat_list`.
+    //
+    PassStat& stat_of(std::string name);
+public:
+    PassManager(void);
+    //
+    static std::vector<std::string> level(int lvl);
+    static Pass_fn pass_of(std::string name);
+    //
+    void set_level(int lvl);
+    void set_passes(std::vector<std::string> names);
+    void set_passes(std::string list);  // Comma-separated names.
+    void set_stats(bool on) { stats = on; }
+    void set_jobs(int n) { jobs = n; }
+    int get_jobs(void) const { return jobs; }
+    std::string list(void) const;  // The per-function passes, in order.
+    //
+    std::unordered_set<std::string> run(Defs& defs, SymT& main_symt,
+                                        INST_vec& main_code);
+    void run(SymT& symt, INST_vec& code);
+    void report(std::ostream& os) const;
+};
+
+#endif
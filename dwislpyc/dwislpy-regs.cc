@@ -0,0 +1,230 @@
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-live.hh"
+#include "dwislpy-regs.hh"
+
+//
+// dwislpy-regs.cc
+//
+// Linear scan register allocation. See the header for an overview.
+//
+
+//
+// The registers available for allocation on MIPS32. The scratch
+// registers $t0-$t2 are kept back for use by `toMIPS` when working with
+// spilled variables.
+//
+const Regs MIPS_REGS {
+    {"$t3", "$t4", "$t5", "$t6", "$t7", "$t8", "$t9"},
+    {"$s0", "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$s7"},
+    {"$a0", "$a1", "$a2", "$a3"},
+    4
+};
+
+//
+// The registers available for allocation on x86-64. %rax, %r10, and
+// %r11 are kept back for use by `toX86` as scratch registers, and the
+// argument registers are only used for formals, as on MIPS32. The
+// runtime's I/O routines save every register but %rax and %rdi, so
+// like the MIPS system calls they leave the caller-saved ones alone.
+//
+const Regs X86_REGS {
+    {"%r8", "%r9"},
+    {"%rbx", "%r12", "%r13", "%r14", "%r15"},
+    {"%rdi", "%rsi", "%rdx", "%rcx"},
+    8
+};
+
+//
+// class Intv - the live interval of a variable during allocation.
+//
+class Intv {
+public:
+    Symb name;
+    int from;
+    int to;
+    bool call;       // Whether it needs a callee-saved register.
+    std::string reg; // Empty if spilled.
+};
+
+static bool is_callee_saved(const Regs& regs, std::string reg) {
+    return std::find(regs.callee_saved.begin(),regs.callee_saved.end(),reg)
+           != regs.callee_saved.end();
+}
+
+//
+// allocate_registers(symt,live,regs)
+//
+// Assign registers from `regs` to the variables of some code, recording
+// them in `symt`, given the code's liveness information `live`.
+//
+void allocate_registers(SymT& symt, const Live& live, const Regs& regs) {
+
+    // A function that makes no calls can leave its formals in the
+    // argument registers they arrive in. Only $a0 gets overwritten, by
+    // the system calls that print, or by the ARGs of a tail call. Unused
+    // formals are likewise left where they are.
+    //
+    bool leaf = live.calls.empty() && live.tails.empty();
+    for (unsigned int i = 0; i < symt.get_frmls_size() && i < regs.args.size(); i++) {
+        Symb pram = symt.get_frml_symb(i);
+        std::string areg = regs.args[i];
+        bool used = std::find(live.names.begin(),live.names.end(),pram)
+                    != live.names.end();
+        if (!used || (leaf && (i > 0 || !live.crosses_syscall(pram)))) {
+            symt.set_reg(pram,areg);
+        }
+    }
+
+    // Build the intervals, sorted by their start.
+    //
+    std::vector<Intv> intvs {};
+    for (Symb name : live.names) {
+        Range hull = live.hull(name);
+        SymInfo_ptr info = symt.get_info(name);
+        if (info->kind == FRML && !info->reg.empty()) {
+            continue;
+        }
+        if (info->kind == FRML) {
+            // Formals are all moved out of $a0-$a3 on entry, so each
+            // must hold its register from the start.
+            hull.from = 0;
+        }
+        intvs.push_back(Intv {name, hull.from, hull.to,
+                              live.crosses_call(name), ""});
+    }
+    std::stable_sort(intvs.begin(), intvs.end(),
+                     [](const Intv& i1, const Intv& i2) {
+                         return i1.from < i2.from;
+                     });
+
+    // Scan through the intervals. The `active` ones have a register and
+    // are kept sorted by their end.
+    //
+    std::vector<std::string> free_regs {};
+    free_regs.insert(free_regs.end(),regs.caller_saved.begin(),regs.caller_saved.end());
+    free_regs.insert(free_regs.end(),regs.callee_saved.begin(),regs.callee_saved.end());
+    std::vector<Intv*> active {};
+    for (Intv& curr : intvs) {
+
+        // Expire the intervals that ended before this one starts.
+        //
+        while (!active.empty() && active.front()->to < curr.from) {
+            free_regs.push_back(active.front()->reg);
+            active.erase(active.begin());
+        }
+
+        // Find a free register. Prefer a caller-saved one unless the
+        // value must survive a call.
+        //
+        auto pick = free_regs.end();
+        for (auto r = free_regs.begin(); r != free_regs.end(); r++) {
+            if (is_callee_saved(regs,*r)) {
+                if (pick == free_regs.end()) {
+                    pick = r;
+                }
+            } else if (!curr.call) {
+                pick = r;
+                break;
+            }
+        }
+
+        if (pick != free_regs.end()) {
+            curr.reg = *pick;
+            free_regs.erase(pick);
+        } else {
+            // Spill whichever suitable interval ends last.
+            //
+            Intv* victim = nullptr;
+            for (Intv* actv : active) {
+                if (!curr.call || is_callee_saved(regs,actv->reg)) {
+                    victim = actv;
+                }
+            }
+            if (victim == nullptr || victim->to <= curr.to) {
+                continue;
+            }
+            curr.reg = victim->reg;
+            victim->reg = "";
+            active.erase(std::find(active.begin(),active.end(),victim));
+        }
+        auto at = active.begin();
+        while (at != active.end() && (*at)->to <= curr.to) {
+            at++;
+        }
+        active.insert(at,&curr);
+    }
+
+    // Record the allocation.
+    //
+    for (Intv& intv : intvs) {
+        symt.set_reg(intv.name,intv.reg);
+    }
+    for (std::string reg : regs.callee_saved) {
+        for (Intv& intv : intvs) {
+            if (intv.reg == reg) {
+                symt.add_save(reg);
+                break;
+            }
+        }
+    }
+}
+
+//
+// allocate_slots(symt,live,regs)
+//
+// Assign frame slots to the spilled locals and temporaries of some
+// code, given the code's liveness information `live`. Any previously
+// colored variable that interferes with the current one has a live
+// range reaching past the current one's start, so only those still
+// `active` need to be checked.
+//
+int allocate_slots(SymT& symt, const Live& live, const Regs& regs) {
+
+    // Gather the spilled variables, sorted by their start.
+    //
+    std::vector<Symb> spills {};
+    for (Symb name : live.names) {
+        SymInfo_ptr info = symt.get_info(name);
+        if (info->kind != FRML && info->reg.empty()) {
+            spills.push_back(name);
+        }
+    }
+    std::stable_sort(spills.begin(), spills.end(),
+                     [&live](Symb nm1, Symb nm2) {
+                         return live.hull(nm1).from < live.hull(nm2).from;
+                     });
+
+    // Color them.
+    //
+    int num_slots = 0;
+    std::vector<std::pair<Symb,int>> active {};
+    for (Symb name : spills) {
+        Range hull = live.hull(name);
+        std::vector<bool> taken(num_slots,false);
+        auto actv = active.begin();
+        while (actv != active.end()) {
+            if (live.hull(actv->first).to < hull.from) {
+                actv = active.erase(actv);
+            } else {
+                if (live.overlap(actv->first,name)) {
+                    taken[actv->second] = true;
+                }
+                actv++;
+            }
+        }
+        int slot = 0;
+        while (slot < num_slots && taken[slot]) {
+            slot++;
+        }
+        if (slot == num_slots) {
+            num_slots++;
+        }
+        symt.set_frame_offset(name,-regs.slot_size*(slot+1));
+        active.push_back({name,slot});
+    }
+    return num_slots;
+}
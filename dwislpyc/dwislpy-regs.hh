@@ -0,0 +1,74 @@
+#ifndef _DWISLPY_REGS_HH
+#define _DWISLPY_REGS_HH
+
+//
+// dwislpy-regs.hh
+//
+// Register allocation for the IR code of a `def` or the `main` script.
+//
+// This sits between translation to IR (`Prgm::trans`) and generation
+// of MIPS code (`INST::toMIPS`). It gives as many of the function's
+// variables and temporaries as it can a MIPS register to live in,
+// recording the choice in the `reg` field of each one's `SymInfo`.
+// Variables left without a register are "spilled": they live in their
+// stack frame slot as before, and `toMIPS` loads and stores them using
+// the scratch registers $t0, $t1, and $t2.
+//
+// The allocator is a linear scan over live intervals (see Poletto and
+// Sarkar, "Linear Scan Register Allocation", TOPLAS 1999). Each
+// variable's interval is the hull of its live ranges as computed by
+// `Live` (see `dwislpy-live.hh`).
+//
+// Registers $t3-$t9 are caller-saved and so are only given to variables
+// that aren't live across a CLL. Registers $s0-$s7 are callee-saved and
+// can be given to any variable, but any that get used are recorded with
+// `SymT::add_save` so that ENTER and LEAVE save and restore them.
+//
+// Formals are moved out of their argument registers on entry, except
+// in functions that make no calls, not even tail calls (see TCLL).
+// There they stay in $a0-$a3, unless it's the formal in $a0 and its
+// value is needed after a PTI or PTS. Formals that are never used are
+// also left in their registers.
+//
+// Once registers are chosen, `allocate_slots` gives the spilled locals
+// and temporaries their frame slots. Two spilled variables can share a
+// slot when they are never live at the same time, and so the slots are
+// chosen by greedily coloring the interference graph of the spilled
+// variables, considering them in order of where their lives start.
+// Slot `k` sits at offset `-4*(k+1)` from the frame pointer. It returns
+// the number of slots used. Formals keep their slots above the frame.
+//
+// The registers above are those of MIPS32, as given by `MIPS_REGS`.
+// The x86-64 backend (see `dwislpy-x86.hh`) allocates from `X86_REGS`
+// instead, in the same way, with 8-byte slots.
+//
+
+#include <string>
+#include <vector>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-live.hh"
+
+//
+// class Regs - the registers of a target that can be allocated.
+//
+// * caller_saved - given only to variables not live across a CLL.
+// * callee_saved - given to any variable; saved by ENTER if used.
+// * args         - the registers the formals arrive in, in order.
+// * slot_size    - the size in bytes of a frame slot.
+//
+class Regs {
+public:
+    std::vector<std::string> caller_saved;
+    std::vector<std::string> callee_saved;
+    std::vector<std::string> args;
+    int slot_size;
+};
+
+extern const Regs MIPS_REGS;
+extern const Regs X86_REGS;
+
+void allocate_registers(SymT& symt, const Live& live, const Regs& regs);
+int allocate_slots(SymT& symt, const Live& live, const Regs& regs);
+
+#endif
@@ -0,0 +1,32 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+//
+// dwislpy-rt.c
+//
+// The runtime of programs compiled with `dwislpyc --target=llvm` (see
+// `dwislpy-llvm.hh`), which is linked with them:
+//
+//     clang -O2 foo.ll dwislpy-rt.c -o foo
+//
+// These stand in for the SPIM system calls that print an integer,
+// print a string, and read an integer from a line of input.
+//
+
+void dwislpy_print_int(int32_t n) {
+    printf("%d", n);
+}
+
+void dwislpy_print_str(const char* s) {
+    fputs(s, stdout);
+}
+
+int32_t dwislpy_read_int(void) {
+    char line[256];
+    fflush(stdout);
+    if (fgets(line, sizeof(line), stdin) == NULL) {
+        return 0;
+    }
+    return (int32_t)strtol(line, NULL, 10);
+}
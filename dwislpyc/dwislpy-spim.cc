@@ -0,0 +1,930 @@
+#include <string>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdarg>
+#include <csetjmp>
+#include "dwislpy-spim.hh"
+#include "dwislpy-ast.hh"
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-jobs.hh"
+#include "dwislpy-pass.hh"
+#include "dwislpy-util.hh"
+
+//
+// dwislpy-spim.cc
+//
+// Loading and running compiled programs in the SPIM core. See
+// `dwislpy-spim.hh`.
+//
+// SPIM's headers come last, since they define macros such as `NULL`,
+// `MIN`, and `K`. The opcodes `Y_..._OP` are the tokens of its parser,
+// from the `parser_yacc.h` made by its makefile.
+//
+
+#include "spim.h"
+#include "string-stream.h"
+#include "spim-utils.h"
+#include "inst.h"
+#include "reg.h"
+#include "mem.h"
+#include "data.h"
+#include "sym-tbl.h"
+#include "parser.h"
+#include "parser_yacc.h"
+#include "image.h"
+
+// * * * * *
+//
+// What SPIM's front end would provide.
+//
+
+bool bare_machine = false;
+bool delayed_branches = false;
+bool delayed_loads = false;
+bool accept_pseudo_insts = true;
+bool quiet = false;
+bool mapped_io = false;
+int pipe_out = 0;
+int spim_return_value = 0;
+port message_out, console_out, console_in;
+
+// Where `run_error` returns to, abandoning the run.
+static std::jmp_buf run_env;
+
+void error(char* fmt, ...) {
+    std::va_list args;
+    va_start(args, fmt);
+    std::fflush(stdout);
+    std::vfprintf(stderr, fmt, args);
+    va_end(args);
+}
+
+void fatal_error(char* fmt, ...) {
+    std::va_list args;
+    va_start(args, fmt);
+    std::fflush(stdout);
+    std::vfprintf(stderr, fmt, args);
+    va_end(args);
+    std::exit(-1);
+}
+
+void run_error(char* fmt, ...) {
+    std::va_list args;
+    va_start(args, fmt);
+    std::fflush(stdout);
+    std::vfprintf(stderr, fmt, args);
+    va_end(args);
+    std::longjmp(run_env, 1);
+}
+
+void write_output(port fp, char* fmt, ...) {
+    std::va_list args;
+    va_start(args, fmt);
+    std::vfprintf(fp.f != nullptr ? fp.f : stdout, fmt, args);
+    va_end(args);
+}
+
+void read_input(char* str, int str_size) {
+    std::fflush(stdout);
+    if (std::fgets(str, str_size, stdin) == nullptr && str_size > 0) {
+        str[0] = '\0';
+    }
+}
+
+int console_input_available(void) {
+    return 0;
+}
+
+char get_console_char(void) {
+    int c = std::getchar();
+    return c == EOF ? '\0' : (char)c;
+}
+
+void put_console_char(char c) {
+    std::putchar(c);
+}
+
+// * * * * *
+//
+// Loading the program.
+//
+
+// The registers used by name. SPIM's `reg.h` gives $v0, $a0, and $sp.
+static const int REG_ZERO = 0;
+static const int REG_AT = 1;
+static const int REG_T0 = 8;
+static const int REG_T1 = 9;
+static const int REG_T2 = 10;
+static const int REG_FP = 30;
+static const int REG_RA = 31;
+
+static const char* REGISTERS[32] = {
+    "$zero", "$at", "$v0", "$v1", "$a0", "$a1", "$a2", "$a3",
+    "$t0",   "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7",
+    "$s0",   "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$s7",
+    "$t8",   "$t9", "$k0", "$k1", "$gp", "$sp", "$fp", "$ra"
+};
+
+//
+// reg_num(reg)
+//
+// The number of the register named `reg`, as given by the allocator
+// (see `dwislpy-regs.hh`), or -1 if `reg` is empty.
+//
+static int reg_num(const std::string& reg) {
+    static const std::unordered_map<std::string,int> numbers = [] {
+        std::unordered_map<std::string,int> nums {};
+        for (int r = 0; r < 32; r++) {
+            nums[REGISTERS[r]] = r;
+        }
+        return nums;
+    }();
+    if (reg.empty()) {
+        return -1;
+    }
+    return numbers.at(reg);
+}
+
+//
+// The expansions of pseudo-instructions, as SPIM's assembler makes
+// them when an immediate value doesn't fit in its field.
+//
+
+//
+// fits(op,imm)
+//
+// Whether `imm` fits the immediate field of `op`, which is sign
+// extended for arithmetic and comparisons, and zero extended for the
+// logical operations.
+//
+static bool fits(int op, int imm) {
+    if (op == Y_ANDI_OP || op == Y_ORI_OP || op == Y_XORI_OP) {
+        return (imm & 0xffff0000) == 0;
+    }
+    return (imm & 0xffff8000) == 0 || (imm & 0xffff8000) == 0xffff8000;
+}
+
+//
+// reg_op(op)
+//
+// The register form of the immediate operation `op`.
+//
+static int reg_op(int op) {
+    switch (op) {
+    case Y_ADDI_OP:  return Y_ADD_OP;
+    case Y_ADDIU_OP: return Y_ADDU_OP;
+    case Y_SLTI_OP:  return Y_SLT_OP;
+    case Y_SLTIU_OP: return Y_SLTU_OP;
+    case Y_ANDI_OP:  return Y_AND_OP;
+    case Y_ORI_OP:   return Y_OR_OP;
+    default:         return Y_XOR_OP;
+    }
+}
+
+//
+// produce(out,rt,val)
+//
+// Sets `rt` to `val`, using $at for the upper half if need be.
+//
+static void produce(SpimOut& out, int rt, int val) {
+    if ((val & 0xffff) == 0) {
+        out.i_type(Y_LUI_OP, rt, REG_ZERO, (val >> 16) & 0xffff);
+    } else if ((val & 0xffff0000) == 0) {
+        out.i_type(Y_ORI_OP, rt, REG_ZERO, val);
+    } else {
+        out.i_type(Y_LUI_OP, REG_AT, REG_ZERO, (val >> 16) & 0xffff);
+        out.i_type(Y_ORI_OP, rt, REG_AT, val & 0xffff);
+    }
+}
+
+//
+// imm(out,op,rt,rs,val)
+//
+// The immediate operation `op`. If `val` doesn't fit its field then
+// it's built in $at and the register form is used, or for `li` (an
+// `ori` from $zero) it's built in `rt` itself.
+//
+static void imm(SpimOut& out, int op, int rt, int rs, int val) {
+    if (fits(op,val)) {
+        out.i_type(op, rt, rs, val);
+    } else if (op == Y_ORI_OP && rs == REG_ZERO) {
+        produce(out, rt, val);
+    } else {
+        produce(out, REG_AT, val);
+        out.r_type(reg_op(op), rt, rs, REG_AT);
+    }
+}
+
+//
+// mem(out,op,rt,offs,base)
+//
+// A load or store of `rt` at `offs` from `base`. A large offset has
+// its upper half added to the base in $at, allowing for the low half
+// being sign extended.
+//
+static void mem(SpimOut& out, int op, int rt, int offs, int base) {
+    if (fits(op,offs)) {
+        out.i_type(op, rt, base, offs);
+        return;
+    }
+    int high = (offs >> 16) & 0xffff;
+    if ((offs & 0x8000) != 0) {
+        high += 1;
+    }
+    out.i_type(Y_LUI_OP, REG_AT, REG_ZERO, high);
+    out.r_type(Y_ADDU_OP, REG_AT, REG_AT, base);
+    out.i_type(op, rt, REG_AT, offs & 0xffff);
+}
+
+//
+// move(out,rd,rs)
+//
+static void move(SpimOut& out, int rd, int rs) {
+    out.r_type(Y_ADDU_OP, rd, REG_ZERO, rs);
+}
+
+//
+// load_defn_spim(out,symt,code,passes)
+//
+// Lower `code` into the instructions of `out`. This prepares `code` as
+// `compile_defn` does, and then converts each IR instruction (using
+// `toSPIM`).
+//
+void load_defn_spim(SpimOut& out, SymT& symt, INST_vec& code,
+                    PassManager& passes) {
+    prepare_defn(symt,code,passes);
+    for (const INST& inst : code) {
+        inst.toSPIM(out,symt);
+    }
+}
+
+//
+// INST::toSPIM(out,symt)
+//
+// Method for lowering a pseudo-instruction into MIPS32 machine
+// instructions, the same ones that `INST::toMIPS` outputs as text. It
+// relies on the registers and frame set up in `symt` in the same way,
+// and the three helpers below do the work of those of `toMIPS`.
+//
+// We define this method for each subclass of INST.
+//
+
+//
+// src_reg(out,symt,nm,scratch)
+//
+// Gives the register holding the value of `nm`, first loading it into
+// the `scratch` register if `nm` was spilled.
+//
+static int src_reg(SpimOut& out, const SymT& symt, Symb nm, int scratch) {
+    int reg = reg_num(symt.get_reg(nm));
+    if (reg < 0) {
+        mem(out, Y_LW_OP, scratch, symt.get_frame_offset(nm), REG_FP);
+        return scratch;
+    }
+    return reg;
+}
+
+//
+// dst_reg(symt,nm,scratch)
+//
+// Gives the register where a value for `nm` should be placed. This is
+// `scratch` if `nm` was spilled, to be followed by a `dst_put`.
+//
+static int dst_reg(const SymT& symt, Symb nm, int scratch) {
+    int reg = reg_num(symt.get_reg(nm));
+    if (reg < 0) {
+        return scratch;
+    }
+    return reg;
+}
+
+//
+// dst_put(out,symt,nm,reg)
+//
+// Stores the value placed in `reg` to the frame slot of `nm` if `nm`
+// was spilled.
+//
+static void dst_put(SpimOut& out, const SymT& symt, Symb nm, int reg) {
+    if (symt.get_reg(nm).empty()) {
+        mem(out, Y_SW_OP, reg, symt.get_frame_offset(nm), REG_FP);
+    }
+}
+
+void ENTER::toSPIM(SpimOut& out, const SymT& symt) const {
+    if (symt.get_frame_size() > 0) {
+        int fp_slot = symt.get_frame_offset(FRAME_POINTER);
+        if (!symt.is_leaf()) {
+            int ra_slot = symt.get_frame_offset(RETURN_ADDRESS);
+            mem(out, Y_SW_OP, REG_RA, ra_slot, REG_SP);
+        }
+        mem(out, Y_SW_OP, REG_FP, fp_slot, REG_SP);
+        move(out, REG_FP, REG_SP);
+        imm(out, Y_ADDI_OP, REG_SP, REG_SP, -symt.get_frame_size());
+    }
+    for (unsigned int i = 0; i < symt.get_saves_size(); i++) {
+        std::string reg = symt.get_save(i);
+        int slot = symt.get_frame_offset(SAVED_REGISTER + reg);
+        mem(out, Y_SW_OP, reg_num(reg), slot, REG_FP);
+    }
+    for (unsigned int argi = 0; argi < symt.get_frmls_size(); argi++) {
+        Symb pram = symt.get_frml_symb(argi);
+        int reg = reg_num(symt.get_reg(pram));
+        int areg = REG_A0 + argi;
+        if (reg < 0) {
+            mem(out, Y_SW_OP, areg, symt.get_frame_offset(pram), REG_FP);
+        } else if (reg != areg) {
+            move(out, reg, areg);
+        }
+    }
+}
+//
+// take_down(out,symt)
+//
+// Restore the registers saved by ENTER and pop the frame.
+//
+static void take_down(SpimOut& out, const SymT& symt) {
+    for (unsigned int i = 0; i < symt.get_saves_size(); i++) {
+        std::string reg = symt.get_save(i);
+        int slot = symt.get_frame_offset(SAVED_REGISTER + reg);
+        mem(out, Y_LW_OP, reg_num(reg), slot, REG_FP);
+    }
+    if (symt.get_frame_size() > 0) {
+        int fp_slot = symt.get_frame_offset(FRAME_POINTER);
+        if (!symt.is_leaf()) {
+            int ra_slot = symt.get_frame_offset(RETURN_ADDRESS);
+            mem(out, Y_LW_OP, REG_RA, ra_slot, REG_FP);
+        }
+        mem(out, Y_LW_OP, REG_FP, fp_slot, REG_FP);
+        imm(out, Y_ADDI_OP, REG_SP, REG_SP, symt.get_frame_size());
+    }
+}
+//
+void LEAVE::toSPIM(SpimOut& out, const SymT& symt) const {
+    take_down(out,symt);
+    out.r_type(Y_JR_OP, 0, REG_RA, 0);
+}
+//
+void TCLL::toSPIM(SpimOut& out, const SymT& symt) const {
+    take_down(out,symt);
+    out.to(Y_J_OP, 0, 0, FILL_JUMP, lbl);
+}
+//
+void SET::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rd = dst_reg(symt,dst,REG_T0);
+    imm(out, Y_ORI_OP, rd, REG_ZERO, val);
+    dst_put(out,symt,dst,rd);
+}
+//
+void STL::toSPIM(SpimOut& out, const SymT& symt) const {
+    // As with `la`, the string's address is set as `li` would set it.
+    std::unordered_map<Labl,int>::const_iterator at = out.strgs.find(lbl);
+    if (at == out.strgs.end()) {
+        throw DwislpyError {Locn {"dwislpyc"},
+                            "Undefined label in the MIPS code: " + lbl.name()};
+    }
+    int rd = dst_reg(symt,dst,REG_T0);
+    imm(out, Y_ORI_OP, rd, REG_ZERO, at->second);
+    dst_put(out,symt,dst,rd);
+}
+//
+void MOV::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src,REG_T1);
+    int rd = dst_reg(symt,dst,REG_T0);
+    if (rd != rs) {
+        move(out, rd, rs);
+    }
+    dst_put(out,symt,dst,rd);
+}
+//
+void RTV::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rd = dst_reg(symt,dst,REG_V0);
+    if (rd != REG_V0) {
+        move(out, rd, REG_V0);
+    }
+    dst_put(out,symt,dst,rd);
+}
+//
+void GTI::toSPIM(SpimOut& out, const SymT& symt) const {
+    imm(out, Y_ORI_OP, REG_V0, REG_ZERO, 5);
+    out.r_type(Y_SYSCALL_OP, 0, 0, 0);
+    int rd = dst_reg(symt,dst,REG_V0);
+    if (rd != REG_V0) {
+        move(out, rd, REG_V0);
+    }
+    dst_put(out,symt,dst,rd);
+}
+//
+void NOP::toSPIM(SpimOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.shift(Y_SLL_OP, 0, 0, 0);
+}
+//
+void PTI::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src,REG_A0);
+    if (rs != REG_A0) {
+        move(out, REG_A0, rs);
+    }
+    imm(out, Y_ORI_OP, REG_V0, REG_ZERO, 1);
+    out.r_type(Y_SYSCALL_OP, 0, 0, 0);
+}
+//
+void PTS::toSPIM(SpimOut& out, const SymT& symt) const {
+    imm(out, Y_ORI_OP, REG_V0, REG_ZERO, 4);
+    int rs = src_reg(out,symt,src,REG_A0);
+    if (rs != REG_A0) {
+        move(out, REG_A0, rs);
+    }
+    out.r_type(Y_SYSCALL_OP, 0, 0, 0);
+}
+//
+// arith(out,symt,op,dst,src1,src2)
+//
+// Shared by the three-register arithmetic instructions.
+//
+static void arith(SpimOut& out, const SymT& symt, int op,
+                  Symb dst, Symb src1, Symb src2) {
+    int rs = src_reg(out,symt,src1,REG_T1);
+    int rt = src_reg(out,symt,src2,REG_T2);
+    int rd = dst_reg(symt,dst,REG_T0);
+    out.r_type(op, rd, rs, rt);
+    dst_put(out,symt,dst,rd);
+}
+//
+// divide(out,symt,op,dst,src1,src2)
+//
+// Shared by DIV and MOD, which are `div` and `rem`. As SPIM expands
+// them, a zero divisor hits a `break`, and otherwise `div` leaves the
+// quotient in LO and the remainder in HI, which `op` moves out.
+//
+static void divide(SpimOut& out, const SymT& symt, int op,
+                   Symb dst, Symb src1, Symb src2) {
+    int rs = src_reg(out,symt,src1,REG_T1);
+    int rt = src_reg(out,symt,src2,REG_T2);
+    int rd = dst_reg(symt,dst,REG_T0);
+    out.i_type(Y_BNE_OP, REG_ZERO, rt, 2);
+    out.r_type(Y_BREAK_OP, 0, 0, 0);
+    out.r_type(Y_DIV_OP, 0, rs, rt);
+    out.r_type(op, rd, 0, 0);
+    dst_put(out,symt,dst,rd);
+}
+//
+void ADD::toSPIM(SpimOut& out, const SymT& symt) const {
+    arith(out,symt,Y_ADD_OP,dst,src1,src2);
+}
+//
+void SUB::toSPIM(SpimOut& out, const SymT& symt) const {
+    arith(out,symt,Y_SUB_OP,dst,src1,src2);
+}
+//
+void MUL::toSPIM(SpimOut& out, const SymT& symt) const {
+    arith(out,symt,Y_MUL_OP,dst,src1,src2);
+}
+//
+void DIV::toSPIM(SpimOut& out, const SymT& symt) const {
+    divide(out,symt,Y_MFLO_OP,dst,src1,src2);
+}
+//
+void MOD::toSPIM(SpimOut& out, const SymT& symt) const {
+    divide(out,symt,Y_MFHI_OP,dst,src1,src2);
+}
+//
+void ADDI::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src,REG_T1);
+    int rd = dst_reg(symt,dst,REG_T0);
+    imm(out, Y_ADDI_OP, rd, rs, val);
+    dst_put(out,symt,dst,rd);
+}
+//
+void ADDIU::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src,REG_T1);
+    int rd = dst_reg(symt,dst,REG_T0);
+    imm(out, Y_ADDIU_OP, rd, rs, val);
+    dst_put(out,symt,dst,rd);
+}
+//
+void SLTI::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src,REG_T1);
+    int rd = dst_reg(symt,dst,REG_T0);
+    imm(out, Y_SLTI_OP, rd, rs, val);
+    dst_put(out,symt,dst,rd);
+}
+//
+void MULP::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src,REG_T1);
+    int rd = dst_reg(symt,dst,REG_T0);
+    out.shift(Y_SLL_OP, rd, rs, val);
+    dst_put(out,symt,dst,rd);
+}
+//
+// bias(out,rs,k)
+//
+// The bias of DIVP and MODP, built in $t2 as `toMIPS` does.
+//
+static void bias(SpimOut& out, int rs, int k) {
+    if (k == 1) {
+        out.shift(Y_SRL_OP, REG_T2, rs, 31);
+    } else {
+        out.shift(Y_SRA_OP, REG_T2, rs, 31);
+        out.shift(Y_SRL_OP, REG_T2, REG_T2, 32-k);
+    }
+}
+//
+void DIVP::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src,REG_T1);
+    int rd = dst_reg(symt,dst,REG_T0);
+    bias(out,rs,val);
+    out.r_type(Y_ADDU_OP, REG_T2, rs, REG_T2);
+    out.shift(Y_SRA_OP, rd, REG_T2, val);
+    dst_put(out,symt,dst,rd);
+}
+//
+void MODP::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src,REG_T1);
+    int rd = dst_reg(symt,dst,REG_T0);
+    bias(out,rs,val);
+    out.r_type(Y_ADDU_OP, REG_T1, rs, REG_T2);
+    if (val <= 16) {
+        out.i_type(Y_ANDI_OP, REG_T1, REG_T1, (1 << val) - 1);
+    } else {
+        out.shift(Y_SLL_OP, REG_T1, REG_T1, 32-val);
+        out.shift(Y_SRL_OP, REG_T1, REG_T1, 32-val);
+    }
+    out.r_type(Y_SUBU_OP, rd, REG_T1, REG_T2);
+    dst_put(out,symt,dst,rd);
+}
+//
+void SLT::toSPIM(SpimOut& out, const SymT& symt) const {
+    arith(out,symt,Y_SLT_OP,dst,src1,src2);
+}
+//
+void SLE::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src1,REG_T1);
+    int rt = src_reg(out,symt,src2,REG_T2);
+    int rd = dst_reg(symt,dst,REG_T0);
+    out.r_type(Y_SLT_OP, rd, rt, rs);
+    out.i_type(Y_XORI_OP, rd, rd, 1);
+    dst_put(out,symt,dst,rd);
+}
+//
+void SEQ::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src1,REG_T1);
+    int rt = src_reg(out,symt,src2,REG_T2);
+    int rd = dst_reg(symt,dst,REG_T0);
+    out.r_type(Y_XOR_OP, rd, rs, rt);
+    out.i_type(Y_SLTIU_OP, rd, rd, 1);
+    dst_put(out,symt,dst,rd);
+}
+//
+void AND::toSPIM(SpimOut& out, const SymT& symt) const {
+    arith(out,symt,Y_AND_OP,dst,src1,src2);
+}
+//
+void OR::toSPIM(SpimOut& out, const SymT& symt) const {
+    arith(out,symt,Y_OR_OP,dst,src1,src2);
+}
+//
+void NOT::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src,REG_T1);
+    int rd = dst_reg(symt,dst,REG_T0);
+    out.i_type(Y_XORI_OP, rd, rs, 1);
+    dst_put(out,symt,dst,rd);
+}
+//
+void RTN::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src,REG_V0);
+    if (rs != REG_V0) {
+        move(out, REG_V0, rs);
+    }
+}
+//
+// branch(out,cn,rs,rt,lbl)
+//
+// A branch to `lbl` when `cn` holds of `rs` and `rt`, or of `rs` alone
+// for the conditions against zero. Those that compare which is less
+// are expanded, as SPIM does, into a `slt` into $at and a test of it.
+//
+static void branch(SpimOut& out, Cndn cn, int rs, int rt, Labl lbl) {
+    switch (cn) {
+    case Cndn::EQ:  out.to(Y_BEQ_OP, rt, rs, FILL_BRANCH, lbl); break;
+    case Cndn::NE:  out.to(Y_BNE_OP, rt, rs, FILL_BRANCH, lbl); break;
+    case Cndn::LT:
+        out.r_type(Y_SLT_OP, REG_AT, rs, rt);
+        out.to(Y_BNE_OP, REG_ZERO, REG_AT, FILL_BRANCH, lbl);
+        break;
+    case Cndn::GE:
+        out.r_type(Y_SLT_OP, REG_AT, rs, rt);
+        out.to(Y_BEQ_OP, REG_ZERO, REG_AT, FILL_BRANCH, lbl);
+        break;
+    case Cndn::GT:
+        out.r_type(Y_SLT_OP, REG_AT, rt, rs);
+        out.to(Y_BNE_OP, REG_ZERO, REG_AT, FILL_BRANCH, lbl);
+        break;
+    case Cndn::LE:
+        out.r_type(Y_SLT_OP, REG_AT, rt, rs);
+        out.to(Y_BEQ_OP, REG_ZERO, REG_AT, FILL_BRANCH, lbl);
+        break;
+    case Cndn::EQZ: out.to(Y_BEQ_OP, REG_ZERO, rs, FILL_BRANCH, lbl); break;
+    case Cndn::NEZ: out.to(Y_BNE_OP, REG_ZERO, rs, FILL_BRANCH, lbl); break;
+    case Cndn::LTZ: out.to(Y_BLTZ_OP, REG_ZERO, rs, FILL_BRANCH, lbl); break;
+    case Cndn::LEZ: out.to(Y_BLEZ_OP, REG_ZERO, rs, FILL_BRANCH, lbl); break;
+    case Cndn::GTZ: out.to(Y_BGTZ_OP, REG_ZERO, rs, FILL_BRANCH, lbl); break;
+    case Cndn::GEZ: out.to(Y_BGEZ_OP, REG_ZERO, rs, FILL_BRANCH, lbl); break;
+    }
+}
+//
+void BCN::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src1,REG_T1);
+    int rt = src_reg(out,symt,src2,REG_T2);
+    branch(out,cndn,rs,rt,lblt);
+    if (!lblf.empty()) {
+        out.to(Y_J_OP, 0, 0, FILL_JUMP, lblf);
+    }
+}
+//
+void BCZ::toSPIM(SpimOut& out, const SymT& symt) const {
+    int rs = src_reg(out,symt,src,REG_T1);
+    branch(out,cndn,rs,REG_ZERO,lblt);
+    if (!lblf.empty()) {
+        out.to(Y_J_OP, 0, 0, FILL_JUMP, lblf);
+    }
+}
+//
+void JMP::toSPIM(SpimOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.to(Y_J_OP, 0, 0, FILL_JUMP, lbl);
+}
+//
+void CLL::toSPIM(SpimOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.to(Y_JAL_OP, 0, 0, FILL_JUMP, lbl);
+}
+//
+void LBL::toSPIM(SpimOut& out, [[maybe_unused]] const SymT& symt) const {
+    out.label(lbl);
+}
+//
+void CMT::toSPIM([[maybe_unused]] SpimOut& out,
+                 [[maybe_unused]] const SymT& symt) const {
+}
+//
+void ARG::toSPIM(SpimOut& out, const SymT& symt) const {
+    int ra = REG_A0 + idx;
+    int rs = src_reg(out,symt,src,ra);
+    if (rs != ra) {
+        move(out, ra, rs);
+    }
+}
+
+//
+// startup(out)
+//
+// The `__start` routine, as in SPIM's exception handler.
+//
+static void startup(SpimOut& out) {
+    out.label(Labl::of("__start"));
+    out.to(Y_JAL_OP, 0, 0, FILL_JUMP, Labl::of("main"));
+    out.shift(Y_SLL_OP, 0, 0, 0);
+    imm(out, Y_ORI_OP, REG_V0, REG_ZERO, 10);
+    out.r_type(Y_SYSCALL_OP, 0, 0, 0);
+}
+
+//
+// handler(out)
+//
+// The exception handler, at `EXCEPTION_ADDR`. Once SPIM has reported
+// an exception, this ends the program with an exit status of 1.
+//
+static void handler(SpimOut& out) {
+    imm(out, Y_ORI_OP, REG_A0, REG_ZERO, 1);
+    imm(out, Y_ORI_OP, REG_V0, REG_ZERO, 17);
+    out.r_type(Y_SYSCALL_OP, 0, 0, 0);
+}
+
+typedef std::unordered_map<Labl,int> Addrs;
+
+//
+// place(addrs,lbl,addr)
+//
+// Notes that `lbl` is at `addr`, in `addrs` and in SPIM's symbol table.
+//
+static void place(Addrs& addrs, Labl lbl, mem_addr addr) {
+    addrs[lbl] = addr;
+    record_label(const_cast<char*>(lbl.name().c_str()), addr, 1);
+}
+
+//
+// store_data(addrs,data)
+//
+// Stores the characters of a string constant, placing each of its
+// labels at its offset.
+//
+static void store_data(Addrs& addrs, const StrgData& data) {
+    mem_addr here = current_data_pc();
+    for (const std::pair<unsigned int,std::string>& off_lbl : data.lbls) {
+        place(addrs, Labl::of(off_lbl.second), here + off_lbl.first);
+    }
+    std::string strg = data.strg;
+    store_string(&strg[0], strg.size(), true);
+}
+
+//
+// store_strings(addrs,symt)
+//
+// Stores the string constants kept by `symt` itself, each labelled.
+//
+static void store_strings(Addrs& addrs, const SymT& symt) {
+    for (const std::pair<const Name,std::string>& lbl_strg : symt.strings) {
+        store_data(addrs, StrgData {lbl_strg.second,{{0,lbl_strg.first}}});
+    }
+}
+
+//
+// store_code(out,addrs)
+//
+// Makes SPIM `instruction`s of those of `out`, filling in the targets
+// of branches and jumps from `addrs`, and stores them from the current
+// text address.
+//
+static void store_code(const SpimOut& out, const Addrs& addrs) {
+    for (const SpimInst& si : out.insts) {
+        mem_addr pc = current_text_pc();
+        int value = si.imm;
+        if (si.fill != FILL_NONE) {
+            Addrs::const_iterator at = addrs.find(si.lbl);
+            if (at == addrs.end()) {
+                throw DwislpyError {Locn {"dwislpyc"},
+                                    "Undefined label in the MIPS code: "
+                                    + si.lbl.name()};
+            }
+            mem_addr addr = at->second;
+            if (si.fill == FILL_BRANCH) {
+                value = (int32)(addr - pc) >> 2;
+            } else {
+                value = (addr & 0x0fffffff) >> 2;
+            }
+        }
+        instruction* inst = (instruction*)zmalloc(sizeof(instruction));
+        SET_OPCODE(inst, si.op);
+        switch (si.form) {
+        case FORM_R:
+            SET_RS(inst, si.rs);
+            SET_RT(inst, si.rt);
+            SET_RD(inst, si.rd);
+            SET_SHAMT(inst, value & 0x1f);
+            break;
+        case FORM_I:
+            SET_RS(inst, si.rs);
+            SET_RT(inst, si.rt);
+            SET_IMM(inst, value);
+            break;
+        case FORM_J:
+            SET_TARGET(inst, value);
+            break;
+        }
+        store_instruction(inst);
+    }
+}
+
+//
+// Prgm::load_spim(passes)
+//
+// Load the program into SPIM's memory, optimized by `passes`.
+//
+// SPIM's memory is set up, and the exception handler stored. Then the
+// string constants are stored, in the same order as `Prgm::compile`
+// outputs them, which places their labels. Like `Prgm::compile`, this
+// translates the program and runs the whole-program passes, and then
+// prepares and lowers each `def` and the `main` script on as many
+// threads as `passes` says. The `__start` routine, `main`, and each
+// `def` are laid end to end from the start of the text segment, which
+// places the labels of the code, and then they're stored. Every label
+// used must have been placed.
+//
+void Prgm::load_spim(PassManager& passes) {
+
+    // Set up SPIM's memory, and store the exception handler.
+    //
+    console_out.f = stdout;
+    message_out.f = stdout;
+    console_in.i = 0;
+    initialize_world(nullptr, false);
+    user_kernel_text_segment(true);
+    data_dir = false;
+    text_dir = true;
+    set_text_pc(EXCEPTION_ADDR);
+    Addrs addrs {};
+    SpimOut handler_out {addrs};
+    handler(handler_out);
+    store_code(handler_out,addrs);
+
+    // Translate the AST to IR, then run the whole-program passes.
+    //
+    trans(passes.get_jobs());
+    std::unordered_set<std::string> called = passes.run(defs,main_symt,main_code);
+
+    // Store the string constants. Those of a `def` whose calls were all
+    // inlined are still needed.
+    //
+    user_kernel_data_segment(false);
+    data_dir = true;
+    text_dir = false;
+    enable_data_alignment();
+    for (const StrgData& data : glbl_symt_ptr->get_pool()->layout()) {
+        store_data(addrs,data);
+    }
+    store_strings(addrs,*glbl_symt_ptr);
+    store_strings(addrs,main_symt);
+    for (std::pair<Name,Defn_ptr> dfpr : defs) {
+        store_strings(addrs,dfpr.second->symt);
+    }
+
+    // Lower `main` and each `def` that's still called, each into its
+    // own instructions, after those of `__start`.
+    //
+    std::vector<Defn_ptr> defns {};
+    for (std::pair<Name,Defn_ptr> dfpr : defs) {
+        if (called.count(dfpr.first) > 0) {
+            defns.push_back(dfpr.second);
+        } // Otherwise every call to it was inlined.
+    }
+    std::vector<std::unique_ptr<SpimOut>> outs {};
+    for (unsigned int i = 0; i <= defns.size() + 1; i++) {
+        outs.push_back(std::unique_ptr<SpimOut> {new SpimOut {addrs}});
+    }
+    startup(*outs[0]);
+    run_jobs(defns.size() + 1, passes.get_jobs(), [&](int i) {
+        if (i == 0) {
+            load_defn_spim(*outs[1],main_symt,main_code,passes);
+        } else {
+            Defn_ptr defn = defns[i-1];
+            load_defn_spim(*outs[i+1],defn->symt,defn->code,passes);
+        }
+    });
+
+    // Place the labels of the code, then store it.
+    //
+    user_kernel_text_segment(false);
+    data_dir = false;
+    text_dir = true;
+    mem_addr here = current_text_pc();
+    for (std::unique_ptr<SpimOut>& out : outs) {
+        for (std::pair<Labl,int> lbl_at : out->labels) {
+            place(addrs, lbl_at.first, here + BYTES_PER_WORD * lbl_at.second);
+        }
+        here += BYTES_PER_WORD * out->insts.size();
+    }
+    make_label_global(const_cast<char*>("main"));
+    for (std::unique_ptr<SpimOut>& out : outs) {
+        store_code(*out,addrs);
+    }
+    end_of_assembly_file();
+}
+
+//
+// run_from(pc)
+//
+// Runs the loaded program from `pc` until it exits, or until a run
+// error abandons it. Gives whether it ran to its end.
+//
+static bool run_from(mem_addr pc) {
+    bool continuable;
+    if (setjmp(run_env) != 0) {
+        return false;
+    }
+    run_program(pc, DEFAULT_RUN_STEPS, false, false, &continuable);
+    if (CP0_ExCode == ExcCode_Bp) {
+        // SPIM gives no reason for the `break` of a division by zero.
+        error(const_cast<char*>("  Division by zero\n"));
+    }
+    return true;
+}
+
+//
+// run_spim_program(name)
+//
+// Runs the program that was loaded, giving its exit status.
+//
+int run_spim_program(std::string name) {
+    std::vector<char> arg0 {name.begin(), name.end()};
+    arg0.push_back('\0');
+    char* argv[] = {arg0.data()};
+    initialize_run_stack(1, argv);
+    bool finished = run_from(starting_address());
+    std::fflush(stdout);
+    return finished ? spim_return_value : 1;
+}
+
+//
+// save_spim_image(name)
+//
+// Writes the program that was loaded to the image file `name`.
+//
+void save_spim_image(std::string name) {
+    if (!write_image_file(const_cast<char*>(name.c_str()))) {
+        throw DwislpyError {Locn {"dwislpyc"},
+                            "Unable to write the image " + name + "."};
+    }
+}
@@ -0,0 +1,144 @@
+#ifndef _DWISLPY_SPIM_HH
+#define _DWISLPY_SPIM_HH
+
+//
+// dwislpy-spim.hh
+//
+// Running compiled programs within `dwislpyc` itself, used by
+// `dwislpyc --run`. The core of the SPIM simulator (`spim-cmd/CPU`) is
+// linked in, and the program is loaded straight into its memory by
+// `Prgm::load_spim`. There is no `foo.s` written and read back, nor is
+// any MIPS text made in memory: SPIM's scanner and parser aren't run,
+// and neither is its exception handler read from `exceptions.s`.
+//
+// Instead, the string constants are stored first, by `store_string`,
+// which gives the address of each. Then, like `Prgm::compile`, each
+// `def` and the `main` script is optimized and given registers and a
+// frame (by `prepare_defn`, see `dwislpy-mips.cc`), on as many threads
+// as the passes say, and `INST::toSPIM` lowers each of its IR
+// instructions into the MIPS32 machine instructions that
+// `INST::toMIPS` would output for it, with the same registers, as
+// `SpimInst` records. Pseudo-instructions such as `blt`, `li`, and
+// `la` are expanded just as SPIM's assembler would expand them. Each
+// record is one machine instruction, and so once every function is
+// lowered the address of each label in the code is known. The records
+// are then made into SPIM's own `instruction`s, with the targets of
+// their branches and jumps filled in, and stored by
+// `store_instruction`.
+//
+// The program is started by a `__start` routine like that of SPIM's
+// exception handler, which calls `main` and then exits. SPIM's handler
+// isn't loaded, and so an exception (such as an arithmetic overflow)
+// is reported by SPIM and then ends the run, rather than being skipped
+// over.
+//
+// This file also provides what SPIM's terminal front end, `spim.cpp`,
+// would: its settings, and the console I/O used by its system calls.
+// Output is buffered, and is flushed before input is read and when the
+// program ends.
+//
+// What's been loaded can instead be saved as an image, used by
+// `dwislpyc --image`. SPIM loads the image with `spim -image foo.img`,
+// without assembling it again (see `spim-cmd/CPU/image.h`). The image
+// holds the `__start` routine and exception handler above, and so it
+// runs the same as with `--run`.
+//
+// class SpimInst
+//
+// A MIPS32 machine instruction, as SPIM holds it: its opcode (one of
+// SPIM's `Y_..._OP`s), its `form` (R-type, I-type, or J-type), its
+// register fields, and its immediate field, or for an R-type
+// instruction its shift amount. A branch or jump to a label gives it
+// as `lbl`, and `fill` says which of the two it is.
+//
+// class SpimOut
+//
+// The writer of one function's instructions, passed to `INST::toSPIM`:
+//
+// * strgs  - the address of each string constant.
+// * insts  - the instructions so far.
+// * labels - each label, and the position of the instruction it labels.
+//
+// * r_type(op,rd,rs,rt)       - adds an R-type instruction.
+// * shift(op,rd,rt,sh)        - adds a shift by a constant.
+// * i_type(op,rt,rs,imm)      - adds an I-type instruction, whose
+//                               `imm` must fit its field.
+// * to(op,rt,rs,fill,lbl)     - adds a branch or jump to `lbl`.
+// * label(lbl)                - labels the next instruction.
+//
+// * prepare_defn(symt,code,passes) - optimizes `code` and allocates its
+//                                    registers and frame, as
+//                                    `compile_defn` does before it
+//                                    generates code.
+// * load_defn_spim(out,symt,code,passes)
+//                                  - prepares `code`, and then lowers it
+//                                    into `out`.
+// * run_spim_program(name)         - runs what's been loaded, with
+//                                    `name` as the program's `argv[0]`,
+//                                    and gives its exit status.
+// * save_spim_image(name)          - writes what's been loaded to the
+//                                    image file `name`.
+//
+// The frames laid out by `prepare_defn` hold the saved registers under
+// the names below, which ENTER and LEAVE look up.
+//
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <unordered_map>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-pass.hh"
+
+#define RETURN_ADDRESS "saved_return_address"
+#define FRAME_POINTER  "saved_frame_pointer"
+#define SAVED_REGISTER "saved_"
+
+enum SpimForm { FORM_R, FORM_I, FORM_J };
+enum SpimFill { FILL_NONE, FILL_BRANCH, FILL_JUMP };
+
+class SpimInst {
+public:
+    int op;
+    SpimForm form;
+    int rs;
+    int rt;
+    int rd;
+    int imm;
+    SpimFill fill;
+    Labl lbl;
+};
+
+class SpimOut {
+public:
+    const std::unordered_map<Labl,int>& strgs;
+    std::vector<SpimInst> insts;
+    std::vector<std::pair<Labl,int>> labels;
+    SpimOut(const std::unordered_map<Labl,int>& ss) :
+        strgs {ss}, insts {}, labels {} { }
+    void r_type(int op, int rd, int rs, int rt) {
+        insts.push_back({op, FORM_R, rs, rt, rd, 0, FILL_NONE, Labl {}});
+    }
+    void shift(int op, int rd, int rt, int sh) {
+        insts.push_back({op, FORM_R, 0, rt, rd, sh, FILL_NONE, Labl {}});
+    }
+    void i_type(int op, int rt, int rs, int imm) {
+        insts.push_back({op, FORM_I, rs, rt, 0, imm, FILL_NONE, Labl {}});
+    }
+    void to(int op, int rt, int rs, SpimFill fill, Labl lbl) {
+        SpimForm form = fill == FILL_JUMP ? FORM_J : FORM_I;
+        insts.push_back({op, form, rs, rt, 0, 0, fill, lbl});
+    }
+    void label(Labl lbl) {
+        labels.push_back({lbl, (int)insts.size()});
+    }
+};
+
+void prepare_defn(SymT& symt, INST_vec& code, PassManager& passes);
+void load_defn_spim(SpimOut& out, SymT& symt, INST_vec& code,
+                    PassManager& passes);
+int run_spim_program(std::string name);
+void save_spim_image(std::string name);
+
+#endif
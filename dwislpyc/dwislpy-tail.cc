@@ -0,0 +1,147 @@
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-opt.hh"
+
+//
+// dwislpy-tail.cc
+//
+// Tail call elimination over the IR.
+//
+// A `return f(...)` is translated as
+//
+//     ARG 0,s0 ... CLL f; RTV t; RTN t; JMP f_done
+//
+// where `f_done` labels the function's LEAVE. Such a call is in tail
+// position: once it returns, all that's left to do is to return its
+// value. The same holds for a procedure call followed only by a
+// `return` or by the end of the procedure's body. This pass finds
+// these calls, following any JMPs between the call and the LEAVE, and
+// replaces them:
+//
+// * A call to the function itself becomes MOVs of the arguments into
+//   the formals followed by a JMP back to the start of the body, just
+//   after the ENTER. The recursion becomes a loop that runs in a single
+//   frame.
+//
+// * Any other call becomes a TCLL. This takes down the caller's frame
+//   before jumping to the callee, so that the callee returns straight
+//   to the caller's caller, and the stack doesn't grow.
+//
+// The code left after the call becomes unreachable from it, but is
+// kept (and removed later if nothing else reaches it).
+//
+
+//
+// returns(symt,code,where,at,rslt)
+//
+// Whether the code starting at position `at` goes straight to the
+// LEAVE, returning `rslt` or nothing. Procedures translate `return` as
+// the return of a None temporary, and that's allowed too.
+//
+static bool returns(const SymT& symt, const INST_vec& code,
+                    const std::unordered_map<Labl,int>& where,
+                    int at, Symb rslt) {
+    int size = code.size();
+    Symb none {};
+    for (int steps = 0; at < size && steps < size; steps++) {
+        const INST& inst = code[at];
+        if (inst.as<LBL>() || inst.as<NOP>()) {
+            at++;
+        } else if (const JMP* jmp = inst.as<JMP>()) {
+            at = where.at(jmp->lbl);
+        } else if (inst.as<LEAVE>()) {
+            return true;
+        } else if (const SET* set = inst.as<SET>()) {
+            if (set->val != 0
+                || !std::holds_alternative<NoneTy>(symt.get_info(set->dst)->type)) {
+                return false;
+            }
+            none = set->dst;
+            at++;
+        } else if (const RTN* rtn = inst.as<RTN>()) {
+            if (rtn->src != rslt && rtn->src != none) {
+                return false;
+            }
+            at++;
+        } else {
+            return false;
+        }
+    }
+    return false;
+}
+
+//
+// eliminate_tail_calls(symt,code)
+//
+void eliminate_tail_calls(SymT& symt, INST_vec& code) {
+    Labl self = code[0].as<LBL>()->lbl;
+    std::unordered_map<Labl,int> where {};
+    for (unsigned int i = 0; i < code.size(); i++) {
+        if (LBL* lbl = code[i].as<LBL>()) {
+            where[lbl->lbl] = i;
+        }
+    }
+
+    Labl body {};
+    INST_vec rewritten {};
+    for (unsigned int i = 0; i < code.size(); i++) {
+        CLL* cll = code[i].as<CLL>();
+        if (cll == nullptr) {
+            rewritten.push_back(code[i]);
+            continue;
+        }
+        int next = i+1;
+        Symb rslt {};
+        if (next < (int)code.size()) {
+            if (RTV* rtv = code[next].as<RTV>()) {
+                rslt = rtv->dst;
+                next++;
+            }
+        }
+        if (!returns(symt,code,where,next,rslt)) {
+            rewritten.push_back(code[i]);
+            continue;
+        }
+        if (cll->lbl != self) {
+            rewritten.push_back(TCLL {cll->lbl});
+            i = next-1;
+            continue;
+        }
+
+        // Turn the ARGs of a call to itself into MOVs to its formals.
+        // Each argument was computed into its own temporary, so they
+        // can be assigned in any order.
+        //
+        INST_vec movs {};
+        while (!rewritten.empty()) {
+            ARG* arg = rewritten.back().as<ARG>();
+            if (arg == nullptr) {
+                break;
+            }
+            Symb frml = symt.get_frml_symb(arg->idx);
+            movs.push_back(MOV {frml,arg->src});
+            rewritten.pop_back();
+        }
+        rewritten.insert(rewritten.end(),movs.rbegin(),movs.rend());
+        if (body.empty()) {
+            body = symt.add_labl();
+        }
+        rewritten.push_back(JMP {body});
+        i = next-1;
+    }
+
+    // Label the body, just after the ENTER.
+    //
+    if (!body.empty()) {
+        for (unsigned int i = 0; i < rewritten.size(); i++) {
+            if (rewritten[i].as<ENTER>()) {
+                rewritten.insert(rewritten.begin()+i+1,LBL {body});
+                break;
+            }
+        }
+    }
+    code = rewritten;
+}
@@ -0,0 +1,676 @@
+#include <string>
+#include "dwislpy-emit.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-check.hh"
+#include "dwislpy-pass.hh"
+#include "dwislpy-live.hh"
+#include "dwislpy-regs.hh"
+#include "dwislpy-x86.hh"
+
+//
+// dwislpy-x86.cc
+//
+// This gives the code for compiling the IR into x86-64 code, the
+// counterpart of `dwislpy-mips.cc`. See `dwislpy-x86.hh` for the
+// conventions it follows.
+//
+// A function's frame looks like this, below the saved %rbp:
+//
+//     -8(%rbp) ...    the slots given by `allocate_slots`
+//                     the slots of spilled formals
+//                     the saved callee-saved registers
+//
+// and is padded to a multiple of 16 bytes, so that %rsp stays aligned
+// at calls.
+//
+
+#define SAVED_REGISTER "saved_"
+
+// compile_defn_x86(os,symt,code,passes)
+//
+// Generate x86-64 code into `os`. This works like `compile_defn`, but
+// allocates registers from `X86_REGS` and lays out the frame as above.
+//
+void compile_defn_x86(AsmOut& os, SymT& symt, INST_vec& code,
+                      PassManager& passes) {
+
+    // Optimize the IR (see `dwislpy-pass.hh`).
+    passes.run(symt,code);
+
+    // Choose registers for the variables and temporaries, then share
+    // frame slots amongst those that were spilled.
+    Live live {code};
+    allocate_registers(symt,live,X86_REGS);
+    int num_slots = allocate_slots(symt,live,X86_REGS);
+    symt.set_leaf(live.calls.empty());
+
+    // Spilled formals sit below the slots, since unlike on MIPS32 the
+    // caller leaves no room for them.
+    int offset = -8 - 8*num_slots;
+    for (unsigned int i = 0; i < symt.get_frmls_size(); i++) {
+        Symb pram = symt.get_frml_symb(i);
+        if (symt.get_reg(pram).empty()) {
+            symt.set_frame_offset(pram,offset);
+            offset -= 8;
+        }
+    }
+
+    // Saved callee-saved registers sit last.
+    for (unsigned int i = 0; i < symt.get_saves_size(); i++) {
+        Symb sv = symt.add_locl(SAVED_REGISTER + symt.get_save(i), IntTy {});
+        symt.set_frame_offset(sv,offset);
+        offset -= 8;
+    }
+
+    // Calculate a 16-byte aligned frame size.
+    int frame_size = -8 - offset;
+    if (frame_size % 16 != 0) {
+        frame_size += 8;
+    }
+    symt.set_frame_size(frame_size);
+
+    for (const INST& inst : code) {
+        inst.toX86(os,symt);
+    }
+}
+
+//
+// INST::toX86(os,symt)
+//
+// Method for generating x86-64 code that performs the work of a
+// pseudo-instruction, just as `INST::toMIPS` does for MIPS32. Spilled
+// variables are loaded into and stored from the scratch registers %rax,
+// %r10, and %r11 by the helpers below.
+//
+// We define this method for each subclass of INST.
+//
+
+//
+// reg32(reg)
+//
+// The name of the low 32 bits of the 64-bit register `reg`.
+//
+static std::string reg32(const std::string& reg) {
+    if (reg[2] >= '0' && reg[2] <= '9') {
+        return reg + "d";       // %r8 to %r15
+    }
+    return "%e" + reg.substr(2);
+}
+
+//
+// src_reg(os,symt,nm,scratch)
+//
+// Gives the register holding the value of `nm`, first loading it into
+// the `scratch` register if `nm` was spilled.
+//
+static std::string src_reg(AsmOut& os, const SymT& symt,
+                           Symb nm, std::string scratch) {
+    std::string reg = symt.get_reg(nm);
+    if (reg.empty()) {
+        os << "\t" << "movq " << symt.get_frame_offset(nm) << "(%rbp)," << scratch << '\n';
+        return scratch;
+    }
+    return reg;
+}
+
+//
+// dst_reg(symt,nm,scratch)
+//
+// Gives the register where a value for `nm` should be placed. This is
+// `scratch` if `nm` was spilled, to be followed by a `dst_put`.
+//
+static std::string dst_reg(const SymT& symt, Symb nm, std::string scratch) {
+    std::string reg = symt.get_reg(nm);
+    if (reg.empty()) {
+        return scratch;
+    }
+    return reg;
+}
+
+//
+// dst_put(os,symt,nm,reg)
+//
+// Stores the value placed in `reg` to the frame slot of `nm` if `nm`
+// was spilled.
+//
+static void dst_put(AsmOut& os, const SymT& symt,
+                    Symb nm, std::string reg) {
+    if (symt.get_reg(nm).empty()) {
+        os << "\t" << "movq " << reg << "," << symt.get_frame_offset(nm) << "(%rbp)" << '\n';
+    }
+}
+
+void ENTER::toX86(AsmOut& os, const SymT& symt) const {
+    os << "\t" << "pushq %rbp" << '\n';
+    os << "\t" << "movq %rsp,%rbp" << '\n';
+    if (symt.get_frame_size() > 0) {
+        os << "\t" << "subq $" << symt.get_frame_size() << ",%rsp" << '\n';
+    }
+    for (unsigned int i = 0; i < symt.get_saves_size(); i++) {
+        std::string reg = symt.get_save(i);
+        int slot = symt.get_frame_offset(SAVED_REGISTER + reg);
+        os << "\t" << "movq " << reg << "," << slot << "(%rbp)" << '\n';
+    }
+    for (unsigned int argi = 0;
+         argi < symt.get_frmls_size() && argi < X86_REGS.args.size(); argi++) {
+        Symb pram = symt.get_frml_symb(argi);
+        std::string reg = symt.get_reg(pram);
+        std::string areg = X86_REGS.args[argi];
+        if (reg.empty()) {
+            int slot = symt.get_frame_offset(pram);
+            os << "\t" << "movq " << areg << "," << slot << "(%rbp)" << '\n';
+        } else if (reg != areg) {
+            os << "\t" << "movq " << areg << "," << reg << '\n';
+        }
+    }
+}
+//
+// take_down(os,symt)
+//
+// Restore the registers saved by ENTER and pop the frame.
+//
+static void take_down(AsmOut& os, const SymT& symt) {
+    for (unsigned int i = 0; i < symt.get_saves_size(); i++) {
+        std::string reg = symt.get_save(i);
+        int slot = symt.get_frame_offset(SAVED_REGISTER + reg);
+        os << "\t" << "movq " << slot << "(%rbp)," << reg << '\n';
+    }
+    os << "\t" << "leave" << '\n';
+}
+//
+void LEAVE::toX86(AsmOut& os, const SymT& symt) const {
+    take_down(os,symt);
+    os << "\t" << "ret" << '\n';
+}
+//
+void TCLL::toX86(AsmOut& os, const SymT& symt) const {
+    take_down(os,symt);
+    os << "\t" << "jmp " << lbl << '\n';
+}
+//
+void SET::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rd = dst_reg(symt,dst,"%rax");
+    os << "\t" << "movl $" << val << "," << reg32(rd) << '\n';
+    dst_put(os,symt,dst,rd);
+}
+//
+void STL::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rd = dst_reg(symt,dst,"%rax");
+    os << "\t" << "leaq " << lbl << "(%rip)," << rd << '\n';
+    dst_put(os,symt,dst,rd);
+}
+//
+void MOV::toX86(AsmOut& os, const SymT& symt) const {
+    // A spilled value headed for a spilled variable goes straight back.
+    std::string rs = src_reg(os,symt,src,"%r10");
+    std::string rd = dst_reg(symt,dst,rs);
+    if (rd != rs) {
+        os << "\t" << "movq " << rs << "," << rd << '\n';
+    }
+    dst_put(os,symt,dst,rd);
+}
+//
+void RTV::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rd = dst_reg(symt,dst,"%rax");
+    if (rd != "%rax") {
+        os << "\t" << "movq %rax," << rd << '\n';
+    }
+    dst_put(os,symt,dst,rd);
+}
+//
+void GTI::toX86(AsmOut& os, const SymT& symt) const {
+    os << "\t" << "call dwislpy_read_int" << '\n';
+    std::string rd = dst_reg(symt,dst,"%rax");
+    if (rd != "%rax") {
+        os << "\t" << "movq %rax," << rd << '\n';
+    }
+    dst_put(os,symt,dst,rd);
+}
+//
+void NOP::toX86(AsmOut& os, [[maybe_unused]] const SymT& symt) const {
+    os << "\t" << "nop" << '\n';
+}
+//
+void PTI::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"%rdi");
+    if (rs != "%rdi") {
+        os << "\t" << "movq " << rs << ",%rdi" << '\n';
+    }
+    os << "\t" << "call dwislpy_print_int" << '\n';
+}
+//
+void PTS::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"%rdi");
+    if (rs != "%rdi") {
+        os << "\t" << "movq " << rs << ",%rdi" << '\n';
+    }
+    os << "\t" << "call dwislpy_print_str" << '\n';
+}
+//
+// arith(os,symt,op,dst,src1,src2)
+//
+// Shared by the two-operand arithmetic instructions, which overwrite
+// their second operand. When the destination is the register of
+// `src2` the work is done in %rax instead.
+//
+static void arith(AsmOut& os, const SymT& symt, std::string op,
+                  Symb dst, Symb src1, Symb src2) {
+    std::string rs = src_reg(os,symt,src1,"%r10");
+    std::string rt = src_reg(os,symt,src2,"%r11");
+    std::string rd = dst_reg(symt,dst,"%rax");
+    std::string rw = (rd == rt && rd != rs) ? "%rax" : rd;
+    if (rw != rs) {
+        os << "\t" << "movl " << reg32(rs) << "," << reg32(rw) << '\n';
+    }
+    os << "\t" << op << " " << reg32(rt) << "," << reg32(rw) << '\n';
+    if (rw != rd) {
+        os << "\t" << "movl " << reg32(rw) << "," << reg32(rd) << '\n';
+    }
+    dst_put(os,symt,dst,rd);
+}
+//
+void ADD::toX86(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"addl",dst,src1,src2);
+}
+//
+void SUB::toX86(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"subl",dst,src1,src2);
+}
+//
+void MUL::toX86(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"imull",dst,src1,src2);
+}
+//
+// divide(os,symt,result,dst,src1,src2)
+//
+// Shared by DIV and MOD. `idivl` divides %edx:%eax, leaving the
+// quotient in %eax and the remainder in %edx, and so %rdx, which may
+// hold a formal, is kept in %r10 meanwhile.
+//
+static void divide(AsmOut& os, const SymT& symt, std::string result,
+                   Symb dst, Symb src1, Symb src2) {
+    std::string rs = src_reg(os,symt,src1,"%r10");
+    std::string rt = src_reg(os,symt,src2,"%r11");
+    std::string rd = dst_reg(symt,dst,"%rax");
+    if (rt == "%rdx" || rt == "%rax") {
+        os << "\t" << "movq " << rt << ",%r11" << '\n';
+        rt = "%r11";
+    }
+    if (rs != "%rax") {
+        os << "\t" << "movl " << reg32(rs) << ",%eax" << '\n';
+    }
+    os << "\t" << "movq %rdx,%r10" << '\n';
+    os << "\t" << "cltd" << '\n';
+    os << "\t" << "idivl " << reg32(rt) << '\n';
+    if (rd != result) {
+        os << "\t" << "movl " << reg32(result) << "," << reg32(rd) << '\n';
+    }
+    if (rd != "%rdx") {
+        os << "\t" << "movq %r10,%rdx" << '\n';
+    }
+    dst_put(os,symt,dst,rd);
+}
+//
+void DIV::toX86(AsmOut& os, const SymT& symt) const {
+    divide(os,symt,"%rax",dst,src1,src2);
+}
+//
+void MOD::toX86(AsmOut& os, const SymT& symt) const {
+    divide(os,symt,"%rdx",dst,src1,src2);
+}
+//
+void ADDI::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"%r10");
+    std::string rd = dst_reg(symt,dst,"%rax");
+    os << "\t" << "leal " << val << "(" << rs << ")," << reg32(rd) << '\n';
+    dst_put(os,symt,dst,rd);
+}
+//
+void ADDIU::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"%r10");
+    std::string rd = dst_reg(symt,dst,"%rax");
+    os << "\t" << "leal " << val << "(" << rs << ")," << reg32(rd) << '\n';
+    dst_put(os,symt,dst,rd);
+}
+//
+// compare(os,symt,cc,dst,rs,rt)
+//
+// Sets the register of `dst` to 1 if `rs` compares to `rt` as the
+// condition code `cc` says, or to 0 if not.
+//
+static void compare(AsmOut& os, const SymT& symt, std::string cc,
+                    Symb dst, std::string rs, std::string rt) {
+    std::string rd = dst_reg(symt,dst,"%rax");
+    os << "\t" << "cmpl " << rt << "," << reg32(rs) << '\n';
+    os << "\t" << "set" << cc << " %al" << '\n';
+    os << "\t" << "movzbl %al," << reg32(rd) << '\n';
+    dst_put(os,symt,dst,rd);
+}
+//
+void SLTI::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"%r10");
+    compare(os,symt,"l",dst,rs,"$" + std::to_string(val));
+}
+//
+void MULP::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"%r10");
+    std::string rd = dst_reg(symt,dst,"%rax");
+    if (rd != rs) {
+        os << "\t" << "movl " << reg32(rs) << "," << reg32(rd) << '\n';
+    }
+    os << "\t" << "sall $" << val << "," << reg32(rd) << '\n';
+    dst_put(os,symt,dst,rd);
+}
+//
+// DIVP and MODP add 2^k-1 to a negative dividend before shifting or
+// masking, just as on MIPS32. That bias is built in %r11d.
+//
+static void bias(AsmOut& os, std::string rs, int k) {
+    os << "\t" << "movl " << reg32(rs) << ",%r11d" << '\n';
+    if (k == 1) {
+        os << "\t" << "shrl $31,%r11d" << '\n';
+    } else {
+        os << "\t" << "sarl $31,%r11d" << '\n';
+        os << "\t" << "shrl $" << 32-k << ",%r11d" << '\n';
+    }
+}
+//
+void DIVP::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"%r10");
+    std::string rd = dst_reg(symt,dst,"%rax");
+    bias(os,rs,val);
+    os << "\t" << "addl " << reg32(rs) << ",%r11d" << '\n';
+    os << "\t" << "sarl $" << val << ",%r11d" << '\n';
+    os << "\t" << "movl %r11d," << reg32(rd) << '\n';
+    dst_put(os,symt,dst,rd);
+}
+//
+void MODP::toX86(AsmOut& os, const SymT& symt) const {
+    // The remainder is ((s + bias) mod 2^k) - bias.
+    std::string rs = src_reg(os,symt,src,"%r10");
+    std::string rd = dst_reg(symt,dst,"%rax");
+    bias(os,rs,val);
+    if (rs != "%r10") {
+        os << "\t" << "movl " << reg32(rs) << ",%r10d" << '\n';
+    }
+    os << "\t" << "addl %r11d,%r10d" << '\n';
+    os << "\t" << "andl $" << (1 << val) - 1 << ",%r10d" << '\n';
+    os << "\t" << "subl %r11d,%r10d" << '\n';
+    os << "\t" << "movl %r10d," << reg32(rd) << '\n';
+    dst_put(os,symt,dst,rd);
+}
+//
+void SLT::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src1,"%r10");
+    std::string rt = src_reg(os,symt,src2,"%r11");
+    compare(os,symt,"l",dst,rs,reg32(rt));
+}
+//
+void SLE::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src1,"%r10");
+    std::string rt = src_reg(os,symt,src2,"%r11");
+    compare(os,symt,"le",dst,rs,reg32(rt));
+}
+//
+void SEQ::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src1,"%r10");
+    std::string rt = src_reg(os,symt,src2,"%r11");
+    compare(os,symt,"e",dst,rs,reg32(rt));
+}
+//
+void AND::toX86(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"andl",dst,src1,src2);
+}
+//
+void OR::toX86(AsmOut& os, const SymT& symt) const {
+    arith(os,symt,"orl",dst,src1,src2);
+}
+//
+void NOT::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"%r10");
+    std::string rd = dst_reg(symt,dst,"%rax");
+    if (rd != rs) {
+        os << "\t" << "movl " << reg32(rs) << "," << reg32(rd) << '\n';
+    }
+    os << "\t" << "xorl $1," << reg32(rd) << '\n';
+    dst_put(os,symt,dst,rd);
+}
+//
+void RTN::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"%rax");
+    if (rs != "%rax") {
+        os << "\t" << "movq " << rs << ",%rax" << '\n';
+    }
+}
+//
+// jump_cc(cn)
+//
+// The x86 condition code of the IR branch condition `cn`, such as
+// "le" for BCN's "le" or BCZ's "lez".
+//
+static std::string jump_cc(Cndn cn) {
+    std::string cndn = cndn_name(cn);
+    if (cndn.back() == 'z') {
+        cndn.pop_back();
+    }
+    if (cndn == "lt") return "l";
+    if (cndn == "gt") return "g";
+    if (cndn == "eq") return "e";
+    return cndn;                // le, ge, ne
+}
+//
+void BCN::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src1,"%r10");
+    std::string rt = src_reg(os,symt,src2,"%r11");
+    os << "\t" << "cmpl " << reg32(rt) << "," << reg32(rs) << '\n';
+    os << "\t" << "j" << jump_cc(cndn) << " " << lblt << '\n';
+    if (!lblf.empty()) {
+        os << "\t" << "jmp " << lblf << '\n';
+    }
+}
+//
+void BCZ::toX86(AsmOut& os, const SymT& symt) const {
+    std::string rs = src_reg(os,symt,src,"%r10");
+    os << "\t" << "testl " << reg32(rs) << "," << reg32(rs) << '\n';
+    os << "\t" << "j" << jump_cc(cndn) << " " << lblt << '\n';
+    if (!lblf.empty()) {
+        os << "\t" << "jmp " << lblf << '\n';
+    }
+}
+//
+void JMP::toX86(AsmOut& os, [[maybe_unused]] const SymT& symt) const {
+    os << "\t" << "jmp " << lbl << '\n';
+}
+//
+void CLL::toX86(AsmOut& os, [[maybe_unused]] const SymT& symt) const {
+    os << "\t" << "call " << lbl << '\n';
+}
+//
+void LBL::toX86(AsmOut& os, [[maybe_unused]] const SymT& symt) const {
+    os << lbl << ":" << '\n';
+}
+//
+void CMT::toX86(AsmOut& os, [[maybe_unused]] const SymT& symt) const {
+    os << "\t\t\t\t#" << msg << '\n';
+}
+//
+void ARG::toX86(AsmOut& os, const SymT& symt) const {
+    if (idx >= (int)X86_REGS.args.size()) {
+        throw DwislpyError { Locn {"dwislpyc"},
+                             "x86-64 target supports at most "
+                             + std::to_string(X86_REGS.args.size())
+                             + " arguments." };
+    }
+    std::string ra = X86_REGS.args[idx];
+    std::string rs = src_reg(os,symt,src,ra);
+    if (rs != ra) {
+        os << "\t" << "movq " << rs << "," << ra << '\n';
+    }
+}
+
+//
+// output_runtime_x86(os)
+//
+// Outputs `_start` and the I/O routines described in `dwislpy-x86.hh`.
+// Output collects in `dwislpy_out_buf` until `dwislpy_flush` writes it.
+//
+static const char* RUNTIME_X86 =
+    "_start:\n"
+    "\tcall main\n"
+    "\tcall dwislpy_flush\n"
+    "\tmovl $60,%eax\n"                 // exit(0)
+    "\txorl %edi,%edi\n"
+    "\tsyscall\n"
+    "dwislpy_flush:\n"                  // Saves every register.
+    "\tpushq %rax\n"
+    "\tpushq %rdi\n"
+    "\tpushq %rsi\n"
+    "\tpushq %rdx\n"
+    "\tpushq %rcx\n"
+    "\tpushq %r11\n"
+    "\tleaq dwislpy_out_buf(%rip),%rsi\n"
+    "\tmovq dwislpy_out_len(%rip),%rdx\n"
+    "1:\ttestq %rdx,%rdx\n"
+    "\tjle 2f\n"
+    "\tmovl $1,%eax\n"                  // write(1,buf,len)
+    "\tmovl $1,%edi\n"
+    "\tsyscall\n"
+    "\ttestq %rax,%rax\n"
+    "\tjle 2f\n"
+    "\taddq %rax,%rsi\n"
+    "\tsubq %rax,%rdx\n"
+    "\tjmp 1b\n"
+    "2:\tmovq $0,dwislpy_out_len(%rip)\n"
+    "\tpopq %r11\n"
+    "\tpopq %rcx\n"
+    "\tpopq %rdx\n"
+    "\tpopq %rsi\n"
+    "\tpopq %rdi\n"
+    "\tpopq %rax\n"
+    "\tret\n"
+    "dwislpy_putc:\n"                   // Appends %al. Saves every register.
+    "\tpushq %rdx\n"
+    "\tpushq %rcx\n"
+    "\tleaq dwislpy_out_buf(%rip),%rcx\n"
+    "\tmovq dwislpy_out_len(%rip),%rdx\n"
+    "\tmovb %al,(%rcx,%rdx)\n"
+    "\tincq %rdx\n"
+    "\tmovq %rdx,dwislpy_out_len(%rip)\n"
+    "\tcmpq $4096,%rdx\n"
+    "\tjb 1f\n"
+    "\tcall dwislpy_flush\n"
+    "1:\tpopq %rcx\n"
+    "\tpopq %rdx\n"
+    "\tret\n"
+    "dwislpy_print_str:\n"
+    "\tpushq %rsi\n"
+    "\tmovq %rdi,%rsi\n"
+    "1:\tmovzbl (%rsi),%eax\n"
+    "\ttestl %eax,%eax\n"
+    "\tjz 2f\n"
+    "\tcall dwislpy_putc\n"
+    "\tincq %rsi\n"
+    "\tjmp 1b\n"
+    "2:\tpopq %rsi\n"
+    "\tret\n"
+    "dwislpy_print_int:\n"              // Digits are built backwards on the stack.
+    "\tpushq %rdx\n"
+    "\tpushq %rcx\n"
+    "\tpushq %rsi\n"
+    "\tsubq $24,%rsp\n"
+    "\tmovslq %edi,%rax\n"
+    "\tmovq %rax,%rcx\n"
+    "\ttestq %rax,%rax\n"
+    "\tjns 1f\n"
+    "\tnegq %rax\n"
+    "1:\tleaq 23(%rsp),%rsi\n"
+    "\tmovq $10,%rdi\n"
+    "2:\txorl %edx,%edx\n"
+    "\tdivq %rdi\n"
+    "\taddb $48,%dl\n"                  // '0'
+    "\tmovb %dl,(%rsi)\n"
+    "\tdecq %rsi\n"
+    "\ttestq %rax,%rax\n"
+    "\tjnz 2b\n"
+    "\ttestq %rcx,%rcx\n"
+    "\tjns 3f\n"
+    "\tmovb $45,(%rsi)\n"               // '-'
+    "\tdecq %rsi\n"
+    "3:\tincq %rsi\n"
+    "\tleaq 24(%rsp),%rdx\n"
+    "4:\tmovb (%rsi),%al\n"
+    "\tcall dwislpy_putc\n"
+    "\tincq %rsi\n"
+    "\tcmpq %rdx,%rsi\n"
+    "\tjb 4b\n"
+    "\taddq $24,%rsp\n"
+    "\tpopq %rsi\n"
+    "\tpopq %rcx\n"
+    "\tpopq %rdx\n"
+    "\tret\n"
+    "dwislpy_read_int:\n"               // Reads a line a byte at a time.
+    "\tcall dwislpy_flush\n"
+    "\tpushq %rdi\n"
+    "\tpushq %rsi\n"
+    "\tpushq %rdx\n"
+    "\tpushq %rcx\n"
+    "\tpushq %r11\n"
+    "\tpushq %rbx\n"
+    "\tpushq %r8\n"
+    "\tpushq %r9\n"
+    "\tsubq $8,%rsp\n"
+    "\txorl %r8d,%r8d\n"                // The value.
+    "\txorl %r9d,%r9d\n"                // Whether it's negative.
+    "\txorl %ebx,%ebx\n"                // 0 before digits, 1 in them, 2 after.
+    "1:\txorl %eax,%eax\n"              // read(0,buf,1)
+    "\txorl %edi,%edi\n"
+    "\tmovq %rsp,%rsi\n"
+    "\tmovl $1,%edx\n"
+    "\tsyscall\n"
+    "\ttestq %rax,%rax\n"
+    "\tjle 3f\n"
+    "\tmovzbl (%rsp),%eax\n"
+    "\tcmpl $10,%eax\n"                 // '\n'
+    "\tje 3f\n"
+    "\tcmpl $2,%ebx\n"
+    "\tje 1b\n"
+    "\tsubl $48,%eax\n"
+    "\tcmpl $9,%eax\n"
+    "\tja 2f\n"
+    "\timull $10,%r8d,%r8d\n"
+    "\taddl %eax,%r8d\n"
+    "\tmovl $1,%ebx\n"
+    "\tjmp 1b\n"
+    "2:\ttestl %ebx,%ebx\n"
+    "\tjnz 4f\n"
+    "\tcmpl $-3,%eax\n"                 // '-' - '0'
+    "\tjne 1b\n"
+    "\txorl $1,%r9d\n"
+    "\tjmp 1b\n"
+    "4:\tmovl $2,%ebx\n"
+    "\tjmp 1b\n"
+    "3:\tmovl %r8d,%eax\n"
+    "\ttestl %r9d,%r9d\n"
+    "\tjz 5f\n"
+    "\tnegl %eax\n"
+    "5:\taddq $8,%rsp\n"
+    "\tpopq %r9\n"
+    "\tpopq %r8\n"
+    "\tpopq %rbx\n"
+    "\tpopq %r11\n"
+    "\tpopq %rcx\n"
+    "\tpopq %rdx\n"
+    "\tpopq %rsi\n"
+    "\tpopq %rdi\n"
+    "\tret\n"
+    "\t.data\n"
+    "dwislpy_out_len:\n"
+    "\t.quad 0\n"
+    "\t.bss\n"
+    "dwislpy_out_buf:\n"
+    "\t.skip 4096\n"
+    "\t.section .note.GNU-stack,\"\",@progbits\n";
+
+void output_runtime_x86(AsmOut& os) {
+    os << RUNTIME_X86;
+}
@@ -0,0 +1,51 @@
+#ifndef _DWISLPY_X86_HH
+#define _DWISLPY_X86_HH
+
+//
+// dwislpy-x86.hh
+//
+// The x86-64 backend, used by `dwislpyc --target=x86-64`. It lowers the
+// same IR as the MIPS32 backend (see `dwislpy-mips.cc`) to System V
+// x86-64 assembly in AT&T syntax, for the GNU assembler. The output is
+// a whole Linux program, with a small runtime of its own that makes
+// system calls directly, and so it needs no C library:
+//
+//     as -o foo.o foo.s && ld -o foo foo.o
+//
+// Functions follow the System V calling convention for the integer
+// registers: arguments arrive in %rdi, %rsi, %rdx, and %rcx, results
+// are returned in %rax, and %rbx and %r12-%r15 are preserved. Each
+// function has a frame kept by %rbp, holding 8-byte slots for spilled
+// variables and formals and for the callee-saved registers it uses.
+// Registers are chosen by the same allocator as for MIPS32, from
+// `X86_REGS` (see `dwislpy-regs.hh`), and %rax, %r10, and %r11 serve
+// as the scratch registers that $t0-$t2 do there.
+//
+// DWISLPY's integers are 32 bits wide, as on MIPS32, so arithmetic and
+// comparisons work on the low halves of registers. Strings are 64-bit
+// addresses, and so variables are moved and spilled whole.
+//
+// The runtime provides `_start`, which calls `main` and then exits,
+// along with these routines, which stand in for SPIM's system calls:
+//
+//     dwislpy_print_int - prints the integer in %edi
+//     dwislpy_print_str - prints the string at %rdi
+//     dwislpy_read_int  - reads a line and gives its integer in %eax
+//
+// These save every register but %rax and %rdi. Output is buffered, and
+// is flushed when the buffer fills, before input is read, and on exit.
+//
+// * compile_defn_x86(os,symt,code,passes) - like `compile_defn`.
+// * output_runtime_x86(os)                - outputs the runtime.
+//
+
+#include "dwislpy-check.hh"
+#include "dwislpy-inst.hh"
+#include "dwislpy-emit.hh"
+#include "dwislpy-pass.hh"
+
+void compile_defn_x86(AsmOut& os, SymT& symt, INST_vec& code,
+                      PassManager& passes);
+void output_runtime_x86(AsmOut& os);
+
+#endif
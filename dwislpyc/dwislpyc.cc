@@ -1,28 +1,78 @@
 #include <iostream>
 #include <fstream>
 #include <cstring>
+#include <cstdlib>
+#include <memory>
 
 #include "dwislpy-ast.hh"
 #include "dwislpy-flex.hh"
 #include "dwislpy-bison.tab.hh"
 #include "dwislpy-util.hh"
 #include "dwislpy-main.hh"
+#include "dwislpy-pass.hh"
+#include "dwislpy-emit.hh"
+#include "dwislpy-cach.hh"
+#include "dwislpy-spim.hh"
 
 //
 // dwslpyc - a DWISLPY compiler
 //
-// Usage: ./dwislpyc <DWISLPY source file name>
+// Usage: ./dwislpyc [-O0|-O1|-O2] [--passes=<list>] [--pass-stats]
+//                   [--jobs=<n>] [--cache=<dir>] [--dump-cfg]
+//                   [--target=mips|x86-64|llvm] [--run|--image|--run-ir]
+//                   <DWISLPY source file name>
 //
 // This command compiles a DWISLPY program into MIPS source. If the
 // source file's name is `foo.py` (or `foo.slpy` etc.) It will
 // generate the MIPS source `foo.s`. This source can be run using the
 // SPIM text-based MIPS32 emulator.
 //
+// With `--target=x86-64` it instead generates x86-64 assembly for the
+// GNU assembler, which links into a Linux executable of its own (see
+// `dwislpy-x86.hh`). With `--target=llvm` it generates LLVM IR in
+// `foo.ll`, to be compiled along with the C runtime `dwislpy-rt.c` (see
+// `dwislpy-llvm.hh`). The default is `--target=mips`.
+//
+// The IR is optimized at level -O2 unless another level is given, or
+// unless `--passes=` lists the passes to run, separated by commas (see
+// `dwislpy-pass.hh`). With `--pass-stats` it reports, for each pass,
+// the instructions it removed and the time it took.
+//
+// The functions of the program are translated and compiled on as many
+// threads as there are cores, or on `n` threads with `--jobs=<n>`. The
+// output is the same whatever the number of threads.
+//
+// With `--cache=<dir>` the code compiled for each function is kept in
+// the directory `dir`, and reused when the function is compiled again
+// unchanged (see `dwislpy-cach.hh`). The directory can be shared by
+// builds that run at the same time.
+//
+// With `--run` it writes no file, and instead runs the MIPS code in
+// the SPIM simulator linked into `dwislpyc`, building its machine
+// instructions straight into SPIM's memory (see `dwislpy-spim.hh`).
+// The program's exit status is then `dwislpyc`'s. With `--image` it
+// loads the code in the same way and then saves it, as SPIM holds it,
+// to `foo.img`. Running that with `spim -image foo.img` skips
+// assembling the code on each run. No text is made for the code, and
+// so `--cache` isn't used with these.
+//
+// With `--run-ir` it writes no file either, and instead runs the
+// optimized IR itself in an interpreter (see `dwislpy-intp.hh`). No
+// code is generated for any target, so running a program this way with
+// `-O0` and then with some `--passes=` checks those passes alone. A
+// run-time error, like any other error reported, gives `dwislpyc` an
+// exit status of 1.
+//
+// With `--dump-cfg` it instead outputs the control-flow graph of the
+// IR of the main script and of each `def`, showing the basic blocks,
+// their predecessors, successors, and immediate dominators.
+//
 // The code is heavily reliant upon:
 //
 // * dwislpy-ast.{cc,hh} - defines the AST for our language
 // * dwislpy-check.{cc,hh} - annotates the AST in prep for compilation
 // * dwislpy-inst.{cc,hh} - defines the IR, performs translation/compilation
+// * dwislpy-pass.{cc,hh} - picks and runs the IR optimization passes
 //
 
 // * * * * *
@@ -77,17 +127,53 @@ void DWISLPY::Driver::check(void) {
 
 // compile
 //
-// Runs the DwiSlpy program.
+// Compiles the DwiSlpy program for `target`, optimizing it with
+// `passes`, and reusing the code of any function found in `cache` (if
+// not null).
 //
-void DWISLPY::Driver::compile(void) {
+void DWISLPY::Driver::compile(PassManager& passes, Cache* cache,
+                              Target target) {
     std::ofstream out_stream { };
     size_t thedot = src_name.find_last_of("."); 
-    std::string out_name = src_name.substr(0, thedot) + ".s"; 
+    std::string out_name = src_name.substr(0, thedot)
+                           + (target == LLVM_IR ? ".ll" : ".s");
     out_stream.open(out_name);
-    program->compile(out_stream);
+    AsmOut out { out_stream };
+    program->compile(out,passes,cache,target);
+    out.flush();
     out_stream.close();
 }
 
+// compile_and_run
+//
+// Compiles the DwiSlpy program to MIPS32 code straight into SPIM's
+// memory, and runs it there. Gives the program's exit status.
+//
+int DWISLPY::Driver::compile_and_run(PassManager& passes) {
+    program->load_spim(passes);
+    return run_spim_program(src_name);
+}
+
+// compile_image
+//
+// Compiles the DwiSlpy program into SPIM's memory as `compile_and_run`
+// does, and saves what's loaded as an image.
+//
+void DWISLPY::Driver::compile_image(PassManager& passes) {
+    program->load_spim(passes);
+    size_t thedot = src_name.find_last_of("."); 
+    save_spim_image(src_name.substr(0, thedot) + ".img");
+}
+
+// interpret
+//
+// Translates the DwiSlpy program to IR, optimizes it with `passes`, and
+// runs it in the IR interpreter.
+//
+void DWISLPY::Driver::interpret(PassManager& passes) {
+    program->interpret(passes);
+}
+
 // dump
 //
 // Outputs the DwiSlpy program, either by depicting its AST, or by
@@ -101,6 +187,14 @@ void DWISLPY::Driver::dump(bool pretty) {
     }
 }
 
+// dump_cfg
+//
+// Outputs the control-flow graphs of the DwiSlpy program's IR.
+//
+void DWISLPY::Driver::dump_cfg(void) {
+    program->dump_cfg(std::cout);
+}
+
 char* extract_filename(int argc, char** argv) {
     for (int i=1; i<argc; i++) {
         if (argv[i][0] != '-') return argv[i];
@@ -108,12 +202,92 @@ char* extract_filename(int argc, char** argv) {
     return nullptr;
 }
 
+bool has_flag(int argc, char** argv, const char* flag) {
+    for (int i=1; i<argc; i++) {
+        if (std::strcmp(argv[i],flag) == 0) return true;
+    }
+    return false;
+}
+
+//
+// set_passes(argc,argv,passes)
+//
+// Sets up the pass manager according to the -O and --passes= flags.
+// The last of these given wins. Also sets the number of threads it
+// runs the passes on, from --jobs=.
+//
+void set_passes(int argc, char** argv, PassManager& passes) {
+    const char* list = "--passes=";
+    for (int i=1; i<argc; i++) {
+        if (std::strncmp(argv[i],"-O",2) == 0 && std::strlen(argv[i]) == 3
+            && argv[i][2] >= '0' && argv[i][2] <= '2') {
+            passes.set_level(argv[i][2] - '0');
+        } else if (std::strncmp(argv[i],list,std::strlen(list)) == 0) {
+            passes.set_passes(std::string {argv[i] + std::strlen(list)});
+        }
+    }
+    passes.set_stats(has_flag(argc,argv,"--pass-stats"));
+    const char* jobs = "--jobs=";
+    for (int i=1; i<argc; i++) {
+        if (std::strncmp(argv[i],jobs,std::strlen(jobs)) == 0) {
+            int n = std::atoi(argv[i] + std::strlen(jobs));
+            if (n < 1) {
+                throw DwislpyError {Locn {"dwislpyc"}, "Bad number of jobs."};
+            }
+            passes.set_jobs(n);
+        }
+    }
+}
+
+//
+// make_cache(argc,argv)
+//
+// The cache given by --cache=, if any.
+//
+std::unique_ptr<Cache> make_cache(int argc, char** argv) {
+    const char* dir = "--cache=";
+    std::unique_ptr<Cache> cache {};
+    for (int i=1; i<argc; i++) {
+        if (std::strncmp(argv[i],dir,std::strlen(dir)) == 0) {
+            cache.reset(new Cache {std::string {argv[i] + std::strlen(dir)}});
+        }
+    }
+    return cache;
+}
+
+//
+// get_target(argc,argv)
+//
+// The target given by --target=, or MIPS32 if none.
+//
+Target get_target(int argc, char** argv) {
+    const char* name = "--target=";
+    Target target = MIPS32;
+    for (int i=1; i<argc; i++) {
+        if (std::strncmp(argv[i],name,std::strlen(name)) == 0) {
+            std::string arch {argv[i] + std::strlen(name)};
+            if (arch == "mips") {
+                target = MIPS32;
+            } else if (arch == "x86-64") {
+                target = X86_64;
+            } else if (arch == "llvm") {
+                target = LLVM_IR;
+            } else {
+                throw DwislpyError {Locn {"dwislpyc"},
+                                    "Unknown target " + arch + "."};
+            }
+        }
+    }
+    return target;
+}
+
 // * * * * * 
 //
 // main - the DWISLPY interpreter
 //
 int main(int argc, char** argv) {
     
+    int status = 0;
     char* filename = extract_filename(argc,argv);
     
     if (filename) {
@@ -125,6 +299,14 @@ int main(int argc, char** argv) {
         //
         try {
             
+            //
+            // Pick the optimization passes.
+            //
+            PassManager passes {};
+            set_passes(argc,argv,passes);
+            std::unique_ptr<Cache> cache = make_cache(argc,argv);
+            Target target = get_target(argc,argv);
+
             //
             // Parse.
             //
@@ -136,9 +318,33 @@ int main(int argc, char** argv) {
             dwislpy.check();
             
             //
-            // Compile.
+            // Compile, or just show the IR.
             //
-            dwislpy.compile();
+            if (has_flag(argc,argv,"--dump-cfg")) {
+                dwislpy.dump_cfg();
+            } else {
+                bool run = has_flag(argc,argv,"--run");
+                bool image = has_flag(argc,argv,"--image");
+                if ((run || image) && target != MIPS32) {
+                    throw DwislpyError {Locn {"dwislpyc"},
+                                        "--run and --image need --target=mips."};
+                }
+                if (has_flag(argc,argv,"--run-ir")) {
+                    dwislpy.interpret(passes);
+                } else if (run) {
+                    status = dwislpy.compile_and_run(passes);
+                } else if (image) {
+                    dwislpy.compile_image(passes);
+                } else {
+                    dwislpy.compile(passes,cache.get(),target);
+                }
+                if (has_flag(argc,argv,"--pass-stats")) {
+                    passes.report(std::cerr);
+                    if (cache) {
+                        cache->report(std::cerr);
+                    }
+                }
+            }
             
         } catch (DwislpyError se) {
             
@@ -146,6 +352,7 @@ int main(int argc, char** argv) {
             // Report the error.
             //
             std::cerr << se.what() << std::endl;
+            status = 1;
 
         } 
     } else {
@@ -154,6 +361,10 @@ int main(int argc, char** argv) {
         //
         std::cerr << "usage: "
                   << argv[0]
+                  << " [-O0|-O1|-O2] [--passes=<list>] [--pass-stats]"
+                  << " [--jobs=<n>] [--cache=<dir>] [--dump-cfg]"
+                  << " [--target=mips|x86-64|llvm] [--run|--image|--run-ir] <file>"
                   << std::endl;
     }
+    return status;
 }
@@ -1,35 +1,21 @@
 	.data
-L_5:
-	.asciiz "Hello, world!"
-L_4:
-	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
-L_2:
-	.asciiz "False"
-L_1:
-	.asciiz "True"
-L_3:
-	.asciiz "None"
-L_0:
+S_4bd7350d99319bfd:
+	.asciiz "True\n"
+S_b0f65372789f6ad6:
+	.asciiz "False\n"
+S_33546ad8481114a3:
+	.asciiz "None\n"
+S_23f615e78f1ab09a:
+	.ascii "Hello, world!"
+S_af63c74c8601c8dd:
 	.asciiz "\n"
+L_0:
+	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
 	.text
 	.globl main
 main:
-	sw $ra,-12($sp)
-	sw $fp,-16($sp)
-	move $fp, $sp
-	addi $sp,$sp,-32
-	la $t0,L_5
-	sw $t0,-4($fp)
-	li $v0,4
-	lw $a0,-4($fp)
-	syscall
-	la $t0,L_0
-	sw $t0,-8($fp)
+	la $t3,S_23f615e78f1ab09a
 	li $v0,4
-	lw $a0,-8($fp)
+	move $a0,$t3
 	syscall
-main_done:
-	lw $ra,-12($fp)
-	lw $fp,-16($fp)
-	addi $sp,$sp,32
 	jr $ra
@@ -0,0 +1,259 @@
+/* SPIM S20 MIPS simulator.
+   Saving and loading images of assembled programs.
+
+   Distributed under the same license as the rest of SPIM.
+*/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "spim.h"
+#include "string-stream.h"
+#include "spim-utils.h"
+#include "inst.h"
+#include "reg.h"
+#include "mem.h"
+#include "data.h"
+#include "sym-tbl.h"
+#include "parser.h"
+#include "image.h"
+
+
+/* Local functions: */
+
+static bool bad_image (FILE *fp, char *name);
+static void count_symbol (label *l, void *arg);
+static bool get_word (FILE *fp, uint32 *w);
+static void put_word (FILE *fp, uint32 w);
+static void write_data_segment (FILE *fp, int kind, mem_addr bot, mem_addr top);
+static void write_symbol (label *l, void *arg);
+static void write_text_segment (FILE *fp, int kind, mem_addr bot, mem_addr top);
+
+
+
+/* Write the program in memory to an image in file NAME.  Return true if
+   successful and false otherwise. */
+
+bool
+write_image_file (char *name)
+{
+  FILE *fp = fopen (name, "wb");
+  int n_symbols = 0;
+
+  if (fp == NULL)
+    {
+      error ("Cannot open file: `%s'\n", name);
+      return false;
+    }
+
+  put_word (fp, IMAGE_MAGIC);
+  put_word (fp, IMAGE_VERSION);
+  put_word (fp, 4);
+
+  user_kernel_text_segment (false);
+  write_text_segment (fp, IMAGE_TEXT, TEXT_BOT, current_text_pc ());
+  user_kernel_text_segment (true);
+  write_text_segment (fp, IMAGE_K_TEXT, K_TEXT_BOT, current_text_pc ());
+  user_kernel_text_segment (false);
+
+  user_kernel_data_segment (false);
+  write_data_segment (fp, IMAGE_DATA, DATA_BOT, current_data_pc ());
+  user_kernel_data_segment (true);
+  write_data_segment (fp, IMAGE_K_DATA, K_DATA_BOT, current_data_pc ());
+  user_kernel_data_segment (false);
+
+  map_symbols (count_symbol, &n_symbols);
+  put_word (fp, n_symbols);
+  map_symbols (write_symbol, fp);
+
+  if (ferror (fp) | fclose (fp))
+    {
+      error ("Cannot write file: `%s'\n", name);
+      return false;
+    }
+  return true;
+}
+
+
+/* Write the instructions from BOT up to TOP as a segment of KIND. */
+
+static void
+write_text_segment (FILE *fp, int kind, mem_addr bot, mem_addr top)
+{
+  mem_addr addr;
+
+  while (bot < top && read_mem_inst (bot) == NULL)
+    bot += BYTES_PER_WORD;
+
+  put_word (fp, kind);
+  put_word (fp, bot);
+  put_word (fp, top - bot);
+  for (addr = bot; addr < top; addr += BYTES_PER_WORD)
+    put_word (fp, inst_encode (read_mem_inst (addr)));
+}
+
+
+/* Write the bytes from BOT up to TOP as a segment of KIND. */
+
+static void
+write_data_segment (FILE *fp, int kind, mem_addr bot, mem_addr top)
+{
+  mem_addr addr;
+
+  while (bot + BYTES_PER_WORD <= top && read_mem_word (bot) == 0)
+    bot += BYTES_PER_WORD;
+
+  put_word (fp, kind);
+  put_word (fp, bot);
+  put_word (fp, top - bot);
+  for (addr = bot; addr < top; addr += 1)
+    putc (read_mem_byte (addr) & 0xff, fp);
+}
+
+
+static void
+count_symbol (label *, void *arg)
+{
+  *(int *) arg += 1;
+}
+
+
+static void
+write_symbol (label *l, void *arg)
+{
+  FILE *fp = (FILE *) arg;
+  int length = (int) strlen (l->name);
+
+  put_word (fp, (uint32) l->addr);
+  put_word (fp, l->global_flag ? 1 : 0);
+  put_word (fp, length);
+  fwrite (l->name, 1, length, fp);
+}
+
+
+/* Read the image in file NAME into memory and the symbol table.  Return
+   true if successful and false otherwise. */
+
+bool
+read_image_file (char *name)
+{
+  FILE *fp = fopen (name, "rb");
+  uint32 magic, version, n_segments, n_symbols;
+  uint32 i, j;
+
+  if (fp == NULL)
+    {
+      error ("Cannot open file: `%s'\n", name);
+      return false;
+    }
+
+  if (!get_word (fp, &magic) || magic != IMAGE_MAGIC
+      || !get_word (fp, &version) || version != IMAGE_VERSION
+      || !get_word (fp, &n_segments))
+    return bad_image (fp, name);
+
+  for (i = 0; i < n_segments; i ++)
+    {
+      uint32 kind, start, length, word;
+      int c;
+
+      if (!get_word (fp, &kind) || !get_word (fp, &start)
+	  || !get_word (fp, &length))
+	return bad_image (fp, name);
+
+      if (kind == IMAGE_TEXT || kind == IMAGE_K_TEXT)
+	{
+	  user_kernel_text_segment (kind == IMAGE_K_TEXT);
+	  data_dir = false; text_dir = true;
+	  set_text_pc (start);
+	  for (j = 0; j < length; j += BYTES_PER_WORD)
+	    {
+	      if (!get_word (fp, &word))
+		return bad_image (fp, name);
+	      store_instruction (inst_decode (word));
+	    }
+	}
+      else if (kind == IMAGE_DATA || kind == IMAGE_K_DATA)
+	{
+	  user_kernel_data_segment (kind == IMAGE_K_DATA);
+	  data_dir = true; text_dir = false;
+	  set_data_pc (start);
+	  for (j = 0; j < length; j += 1)
+	    {
+	      if ((c = getc (fp)) == EOF)
+		return bad_image (fp, name);
+	      store_byte (c);
+	    }
+	}
+      else
+	return bad_image (fp, name);
+    }
+
+  user_kernel_text_segment (false);
+  user_kernel_data_segment (false);
+  data_dir = false; text_dir = true;
+
+  if (!get_word (fp, &n_symbols))
+    return bad_image (fp, name);
+  for (i = 0; i < n_symbols; i ++)
+    {
+      uint32 addr, flags, length;
+      char *sym;
+
+      if (!get_word (fp, &addr) || !get_word (fp, &flags)
+	  || !get_word (fp, &length) || length > 4096)
+	return bad_image (fp, name);
+      sym = (char *) xmalloc (length + 1);
+      if (fread (sym, 1, length, fp) != length)
+	{
+	  free (sym);
+	  return bad_image (fp, name);
+	}
+      sym[length] = '\0';
+      if (flags & 1)
+	(void)make_label_global (sym);
+      (void)record_label (sym, addr, 0);
+      free (sym);
+    }
+
+  fclose (fp);
+  end_of_assembly_file ();
+  return true;
+}
+
+
+static bool
+bad_image (FILE *fp, char *name)
+{
+  error ("Bad image file: `%s'\n", name);
+  fclose (fp);
+  return false;
+}
+
+
+static void
+put_word (FILE *fp, uint32 w)
+{
+  putc (w & 0xff, fp);
+  putc ((w >> 8) & 0xff, fp);
+  putc ((w >> 16) & 0xff, fp);
+  putc ((w >> 24) & 0xff, fp);
+}
+
+
+static bool
+get_word (FILE *fp, uint32 *w)
+{
+  int i, c;
+
+  *w = 0;
+  for (i = 0; i < 4; i ++)
+    {
+      if ((c = getc (fp)) == EOF)
+	return false;
+      *w |= (uint32) c << (8 * i);
+    }
+  return true;
+}
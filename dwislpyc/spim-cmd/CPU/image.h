@@ -0,0 +1,45 @@
+/* SPIM S20 MIPS simulator.
+   Saving and loading images of assembled programs.
+
+   Distributed under the same license as the rest of SPIM.
+*/
+
+
+/* An image holds a program as it sits in memory once it has been
+   assembled and its labels resolved, so that it can be loaded again
+   without being reassembled.  It holds the encodings of the
+   instructions in the user and kernel text segments, the bytes of the
+   user and kernel data segments, and the symbol table.
+
+   An image is self-contained: its text includes the code that starts
+   the program (at __start) and the exception handler, if any, and so
+   no exception handler should be loaded along with it.
+
+   Every number is a 32-bit little-endian word:
+
+	magic, version		"SPIM" (0x4d495053), then IMAGE_VERSION
+	segment count
+	for each segment:
+	  kind			IMAGE_TEXT, IMAGE_DATA, IMAGE_K_TEXT, IMAGE_K_DATA
+	  address, length	where it starts, and its length in bytes
+	  contents		a word per instruction, or the data's bytes
+	symbol count
+	for each symbol:
+	  address, flags	flags is 1 for a global symbol
+	  length, name		the characters of the name, unterminated
+
+   Leading empty words of each segment are left out. */
+
+#define IMAGE_MAGIC 0x4d495053
+#define IMAGE_VERSION 1
+
+#define IMAGE_TEXT 0
+#define IMAGE_DATA 1
+#define IMAGE_K_TEXT 2
+#define IMAGE_K_DATA 3
+
+
+/* Exported functions: */
+
+bool read_image_file (char *name);
+bool write_image_file (char *name);
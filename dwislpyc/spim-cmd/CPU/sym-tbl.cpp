@@ -461,6 +461,21 @@ print_symbols ()
 }
 
 
+/* Call FN with each defined symbol in the table, along with ARG. */
+
+void
+map_symbols (void (*fn) (label *, void *), void *arg)
+{
+  int i;
+  label *l;
+
+  for (i = 0; i < LABEL_HASH_TABLE_SIZE; i ++)
+    for (l = label_hash_table [i]; l != NULL; l = l->next)
+      if (SYMBOL_IS_DEFINED (l))
+	fn (l, arg);
+}
+
+
 /* Print all undefined symbols in the table. */
 
 void
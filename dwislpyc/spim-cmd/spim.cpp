@@ -76,6 +76,7 @@
 #include "mem.h"
 #include "parser.h"
 #include "sym-tbl.h"
+#include "image.h"
 #include "scanner.h"
 #include "parser_yacc.h"
 #include "data.h"
@@ -278,6 +279,21 @@ main (int argc, char **argv)
 	  assembly_file_loaded = read_assembly_file (argv[++i]) || assembly_file_loaded;
 	  break;
 	}
+      else if (streq (argv [i], "-image") && (i + 1 < argc))
+	{
+	  /* An image holds its own startup code and exception handler,
+	     and everything following it are arguments for program */
+	  program_argc = argc - (i + 1);
+	  program_argv = &argv[i + 1];
+
+	  if (!assembly_file_loaded)
+	    {
+	      initialize_world (NULL, false);
+	      initialize_run_stack (program_argc, program_argv);
+	    }
+	  assembly_file_loaded = read_image_file (argv[++i]) || assembly_file_loaded;
+	  break;
+	}
       else if (streq (argv [i], "-assemble"))
 	{ assemble = true; }
       else if (streq (argv [i], "-dump"))
@@ -306,6 +322,7 @@ main (int argc, char **argv)
 	-mapped_io		Enable memory-mapped IO\n\
 	-nomapped_io		Do not enable memory-mapped IO (default)\n\
 	-file <file> <args>	Assembly code file and arguments to program\n\
+	-image <file> <args>	Image file (from dwislpyc --image) and arguments to program\n\
 	-assemble		Write assembled code to standard output\n\
 	-dump			Write user data and text segments into files\n\
 	-full_dump		Write user and kernel data and text into files.\n");
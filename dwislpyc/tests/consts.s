@@ -0,0 +1,73 @@
+	.data
+S_627b0f61ab208259:
+	.asciiz "never\n"
+S_1a090f1921cb084e:
+	.asciiz "on\n"
+S_1e4ad964daa69365:
+	.ascii "no"
+S_13ca37ede73a08b6:
+	.asciiz "debug\n"
+S_4ef16bb49448a3a0:
+	.asciiz "off\n"
+S_4bd7350d99319bfd:
+	.asciiz "True\n"
+S_b0f65372789f6ad6:
+	.asciiz "False\n"
+S_33546ad8481114a3:
+	.asciiz "None\n"
+S_f6862d190d6f4509:
+	.ascii "c1"
+S_af63c74c8601c8dd:
+	.asciiz "\n"
+L_0:
+	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+	.text
+	.globl main
+main:
+	la $t3,S_1a090f1921cb084e
+	li $v0,4
+	move $a0,$t3
+	syscall
+	la $t4,S_1e4ad964daa69365
+	li $v0,4
+	move $a0,$t4
+	syscall
+	li $t5,0
+	li $t6,0
+	li $t7,8
+	li $t8,0
+	j L_main_12
+L_main_13:
+	add $t6,$t6,$t8
+	addi $t5,$t5,1
+	addiu $t8,$t8,34
+L_main_12:
+	blt $t5,$t7,L_main_13
+	move $a0,$t6
+	li $v0,1
+	syscall
+	la $t9,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t9
+	syscall
+	li $t3,34
+	move $a0,$t3
+	li $v0,1
+	syscall
+	la $t4,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t4
+	syscall
+	li $t5,19
+	move $a0,$t5
+	li $v0,1
+	syscall
+	la $t7,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t7
+	syscall
+	la $t8,S_f6862d190d6f4509
+	li $v0,4
+	move $a0,$t8
+	syscall
+	jr $ra
@@ -0,0 +1,126 @@
+	.data
+S_4bd7350d99319bfd:
+	.asciiz "True\n"
+S_b0f65372789f6ad6:
+	.asciiz "False\n"
+S_33546ad8481114a3:
+	.ascii "None"
+S_af63c74c8601c8dd:
+	.asciiz "\n"
+L_0:
+	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+	.text
+	.globl main
+main:
+	sw $ra,-4($sp)
+	sw $fp,-8($sp)
+	move $fp, $sp
+	addi $sp,$sp,-48
+	sw $s0,-12($fp)
+	sw $s1,-16($fp)
+	sw $s2,-20($fp)
+	sw $s3,-24($fp)
+	sw $s4,-28($fp)
+	li $t3,-3
+	li $t4,0
+	li $t5,13
+	li $t6,0
+	li $t7,100
+	li $t8,0
+	li $t9,100
+	la $s0,S_af63c74c8601c8dd
+	li $s1,-30
+	j L_main_0
+L_main_1:
+	mul $s2,$t3,$t3
+	bge $s2,$t6,L_main_7
+	li $s3,0
+	j L_main_12
+L_main_7:
+	bge $t7,$s2,L_main_9
+	li $s3,100
+	j L_main_12
+L_main_9:
+	move $s3,$s2
+L_main_12:
+	add $t4,$t4,$s3
+	bge $s1,$t8,L_main_15
+	li $s4,0
+	j L_main_20
+L_main_15:
+	bge $t9,$s1,L_main_17
+	li $s4,100
+	j L_main_20
+L_main_17:
+	move $s4,$s1
+L_main_20:
+	move $a0,$s4
+	li $v0,1
+	syscall
+	li $v0,4
+	move $a0,$s0
+	syscall
+	addi $t3,$t3,1
+	addiu $s1,$s1,10
+L_main_0:
+	blt $t3,$t5,L_main_1
+	move $a0,$t4
+	li $v0,1
+	syscall
+	la $t3,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t3
+	syscall
+	li $t5,6
+	move $a0,$t5
+	jal fact
+	move $t6,$v0
+	move $a0,$t6
+	li $v0,1
+	syscall
+	la $t7,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t7
+	syscall
+	li $t8,25
+	move $a0,$t8
+	li $v0,1
+	syscall
+	la $t9,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t9
+	syscall
+	lw $s0,-12($fp)
+	lw $s1,-16($fp)
+	lw $s2,-20($fp)
+	lw $s3,-24($fp)
+	lw $s4,-28($fp)
+	lw $ra,-4($fp)
+	lw $fp,-8($fp)
+	addi $sp,$sp,48
+	jr $ra
+fact:
+	sw $ra,-4($sp)
+	sw $fp,-8($sp)
+	move $fp, $sp
+	addi $sp,$sp,-32
+	sw $s0,-12($fp)
+	move $s0,$a0
+	li $t3,2
+	bge $s0,$t3,L_fact_1
+	li $t4,1
+	move $v0,$t4
+	j fact_done
+L_fact_1:
+	addi $t5,$s0,-1
+	move $a0,$t5
+	jal fact
+	move $t6,$v0
+	mul $t7,$s0,$t6
+	move $v0,$t7
+fact_done:
+	lw $s0,-12($fp)
+	lw $ra,-4($fp)
+	lw $fp,-8($fp)
+	addi $sp,$sp,32
+	jr $ra
@@ -0,0 +1,71 @@
+	.data
+S_4bd7350d99319bfd:
+	.asciiz "True\n"
+S_b0f65372789f6ad6:
+	.asciiz "False\n"
+S_33546ad8481114a3:
+	.ascii "None"
+S_af63c74c8601c8dd:
+	.asciiz "\n"
+L_0:
+	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+	.text
+	.globl main
+main:
+	li $t3,7
+	move $a0,$t3
+	li $v0,1
+	syscall
+	la $t4,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t4
+	syscall
+	li $t5,21
+	move $a0,$t5
+	li $v0,1
+	syscall
+	la $t6,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t6
+	syscall
+	li $t7,20
+	move $a0,$t7
+	li $v0,1
+	syscall
+	la $t8,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t8
+	syscall
+	li $t9,300
+	move $a0,$t9
+	li $v0,1
+	syscall
+	la $t3,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t3
+	syscall
+	li $t4,321
+	move $a0,$t4
+	li $v0,1
+	syscall
+	la $t5,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t5
+	syscall
+	li $t6,5
+	move $a0,$t6
+	li $v0,1
+	syscall
+	la $t7,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t7
+	syscall
+	li $t8,55560
+	move $a0,$t8
+	li $v0,1
+	syscall
+	la $t9,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t9
+	syscall
+	jr $ra
@@ -0,0 +1,198 @@
+@S_112b550079b0072a.str = private unnamed_addr constant [6 x i8] c"even?\00"
+@S_112b550079b0072a = private unnamed_addr constant i8* getelementptr inbounds ([6 x i8], [6 x i8]* @S_112b550079b0072a.str, i64 0, i64 0)
+@S_21fe8219261a24de.str = private unnamed_addr constant [4 x i8] c"n? \00"
+@S_21fe8219261a24de = private unnamed_addr constant i8* getelementptr inbounds ([4 x i8], [4 x i8]* @S_21fe8219261a24de.str, i64 0, i64 0)
+@S_4bd7350d99319bfd.str = private unnamed_addr constant [6 x i8] c"True\0A\00"
+@S_4bd7350d99319bfd = private unnamed_addr constant i8* getelementptr inbounds ([6 x i8], [6 x i8]* @S_4bd7350d99319bfd.str, i64 0, i64 0)
+@S_b0f65372789f6ad6.str = private unnamed_addr constant [7 x i8] c"False\0A\00"
+@S_b0f65372789f6ad6 = private unnamed_addr constant i8* getelementptr inbounds ([7 x i8], [7 x i8]* @S_b0f65372789f6ad6.str, i64 0, i64 0)
+@S_33546ad8481114a3.str = private unnamed_addr constant [6 x i8] c"None\0A\00"
+@S_33546ad8481114a3 = private unnamed_addr constant i8* getelementptr inbounds ([6 x i8], [6 x i8]* @S_33546ad8481114a3.str, i64 0, i64 0)
+@S_af63c74c8601c8dd = private unnamed_addr constant i8* getelementptr inbounds ([6 x i8], [6 x i8]* @S_33546ad8481114a3.str, i64 0, i64 4)
+@S_108da49964d03a79.str = private unnamed_addr constant [8 x i8] c"steps:\09\00"
+@S_108da49964d03a79 = private unnamed_addr constant i8* getelementptr inbounds ([8 x i8], [8 x i8]* @S_108da49964d03a79.str, i64 0, i64 0)
+@L_0.str = private unnamed_addr constant [81 x i8] c"12345678901234567890123456789012345678901234567890123456789012345678901234567890\00"
+@L_0 = private unnamed_addr constant i8* getelementptr inbounds ([81 x i8], [81 x i8]* @L_0.str, i64 0, i64 0)
+define i32 @main() {
+	%ret.val = alloca i64
+	%s.0 = alloca i64
+	%s.1 = alloca i64
+	%s.2 = alloca i64
+	%s.3 = alloca i64
+	%s.4 = alloca i64
+	%s.5 = alloca i64
+	%s.6 = alloca i64
+	%s.7 = alloca i64
+	%s.8 = alloca i64
+	%s.9 = alloca i64
+	%s.10 = alloca i64
+	%s.11 = alloca i64
+	%s.12 = alloca i64
+	%s.13 = alloca i64
+	%v.0 = load i8*, i8** @S_21fe8219261a24de
+	%v.1 = ptrtoint i8* %v.0 to i64
+	store i64 %v.1, i64* %s.0
+	%v.2 = load i64, i64* %s.0
+	%v.3 = inttoptr i64 %v.2 to i8*
+	call void @dwislpy_print_str(i8* %v.3)
+	%v.4 = call i32 @dwislpy_read_int()
+	%v.5 = sext i32 %v.4 to i64
+	store i64 %v.5, i64* %s.1
+	%v.6 = load i8*, i8** @S_108da49964d03a79
+	%v.7 = ptrtoint i8* %v.6 to i64
+	store i64 %v.7, i64* %s.2
+	%v.8 = load i64, i64* %s.1
+	%v.9 = call i64 @dwislpy.collatz(i64 %v.8)
+	store i64 %v.9, i64* %s.3
+	%v.10 = load i64, i64* %s.2
+	%v.11 = inttoptr i64 %v.10 to i8*
+	call void @dwislpy_print_str(i8* %v.11)
+	%v.12 = load i8*, i8** @S_af63c74c8601c8dd
+	%v.13 = ptrtoint i8* %v.12 to i64
+	store i64 %v.13, i64* %s.4
+	%v.14 = load i64, i64* %s.4
+	%v.15 = inttoptr i64 %v.14 to i8*
+	call void @dwislpy_print_str(i8* %v.15)
+	%v.16 = load i64, i64* %s.3
+	%v.17 = trunc i64 %v.16 to i32
+	call void @dwislpy_print_int(i32 %v.17)
+	%v.18 = load i8*, i8** @S_af63c74c8601c8dd
+	%v.19 = ptrtoint i8* %v.18 to i64
+	store i64 %v.19, i64* %s.5
+	%v.20 = load i64, i64* %s.5
+	%v.21 = inttoptr i64 %v.20 to i8*
+	call void @dwislpy_print_str(i8* %v.21)
+	%v.22 = load i8*, i8** @S_112b550079b0072a
+	%v.23 = ptrtoint i8* %v.22 to i64
+	store i64 %v.23, i64* %s.6
+	%v.24 = load i64, i64* %s.1
+	%v.25 = trunc i64 %v.24 to i32
+	%v.26 = srem i32 %v.25, 2
+	%v.27 = sext i32 %v.26 to i64
+	store i64 %v.27, i64* %s.7
+	%v.28 = load i64, i64* %s.6
+	%v.29 = inttoptr i64 %v.28 to i8*
+	call void @dwislpy_print_str(i8* %v.29)
+	%v.30 = load i8*, i8** @S_af63c74c8601c8dd
+	%v.31 = ptrtoint i8* %v.30 to i64
+	store i64 %v.31, i64* %s.8
+	%v.32 = load i64, i64* %s.8
+	%v.33 = inttoptr i64 %v.32 to i8*
+	call void @dwislpy_print_str(i8* %v.33)
+	%v.34 = load i64, i64* %s.7
+	%v.35 = trunc i64 %v.34 to i32
+	call void @dwislpy_print_int(i32 %v.35)
+	%v.36 = load i8*, i8** @S_af63c74c8601c8dd
+	%v.37 = ptrtoint i8* %v.36 to i64
+	store i64 %v.37, i64* %s.9
+	%v.38 = load i64, i64* %s.9
+	%v.39 = inttoptr i64 %v.38 to i8*
+	call void @dwislpy_print_str(i8* %v.39)
+	store i64 5, i64* %s.10
+	%v.40 = load i64, i64* %s.1
+	%v.41 = call i64 @dwislpy.collatz(i64 %v.40)
+	store i64 %v.41, i64* %s.11
+	%v.42 = load i64, i64* %s.10
+	%v.43 = trunc i64 %v.42 to i32
+	%v.44 = load i64, i64* %s.11
+	%v.45 = trunc i64 %v.44 to i32
+	%v.46 = icmp slt i32 %v.43, %v.45
+	br i1 %v.46, label %L_main_0, label %bb.47
+bb.47:
+	store i64 0, i64* %s.12
+	%v.48 = load i64, i64* %s.1
+	%v.49 = trunc i64 %v.48 to i32
+	%v.50 = load i64, i64* %s.12
+	%v.51 = trunc i64 %v.50 to i32
+	%v.52 = icmp sge i32 %v.49, %v.51
+	br i1 %v.52, label %L_main_1, label %bb.53
+bb.53:
+	br label %L_main_0
+L_main_0:
+	%v.54 = load i8*, i8** @S_4bd7350d99319bfd
+	%v.55 = ptrtoint i8* %v.54 to i64
+	store i64 %v.55, i64* %s.13
+	br label %L_main_2
+L_main_1:
+	%v.56 = load i8*, i8** @S_b0f65372789f6ad6
+	%v.57 = ptrtoint i8* %v.56 to i64
+	store i64 %v.57, i64* %s.13
+	br label %L_main_2
+L_main_2:
+	%v.58 = load i64, i64* %s.13
+	%v.59 = inttoptr i64 %v.58 to i8*
+	call void @dwislpy_print_str(i8* %v.59)
+	%v.60 = load i64, i64* %ret.val
+	ret i32 0
+}
+define i64 @dwislpy.collatz(i64 %a.0) {
+	%ret.val = alloca i64
+	%s.0 = alloca i64
+	%s.1 = alloca i64
+	%s.2 = alloca i64
+	%s.3 = alloca i64
+	%s.4 = alloca i64
+	%s.5 = alloca i64
+	%s.6 = alloca i64
+	store i64 %a.0, i64* %s.0
+	store i64 0, i64* %s.1
+	store i64 1, i64* %s.2
+	store i64 0, i64* %s.3
+	store i64 3, i64* %s.4
+	br label %L_collatz_0
+L_collatz_1:
+	%v.0 = load i64, i64* %s.0
+	%v.1 = trunc i64 %v.0 to i32
+	%v.2 = srem i32 %v.1, 2
+	%v.3 = sext i32 %v.2 to i64
+	store i64 %v.3, i64* %s.5
+	%v.4 = load i64, i64* %s.5
+	%v.5 = trunc i64 %v.4 to i32
+	%v.6 = load i64, i64* %s.3
+	%v.7 = trunc i64 %v.6 to i32
+	%v.8 = icmp ne i32 %v.5, %v.7
+	br i1 %v.8, label %L_collatz_4, label %bb.9
+bb.9:
+	%v.10 = load i64, i64* %s.0
+	%v.11 = trunc i64 %v.10 to i32
+	%v.12 = sdiv i32 %v.11, 2
+	%v.13 = sext i32 %v.12 to i64
+	store i64 %v.13, i64* %s.0
+	br label %L_collatz_5
+L_collatz_4:
+	%v.14 = load i64, i64* %s.0
+	%v.15 = trunc i64 %v.14 to i32
+	%v.16 = load i64, i64* %s.4
+	%v.17 = trunc i64 %v.16 to i32
+	%v.18 = mul i32 %v.17, %v.15
+	%v.19 = sext i32 %v.18 to i64
+	store i64 %v.19, i64* %s.6
+	%v.20 = load i64, i64* %s.6
+	%v.21 = trunc i64 %v.20 to i32
+	%v.22 = add i32 %v.21, 1
+	%v.23 = sext i32 %v.22 to i64
+	store i64 %v.23, i64* %s.0
+	br label %L_collatz_5
+L_collatz_5:
+	%v.24 = load i64, i64* %s.1
+	%v.25 = trunc i64 %v.24 to i32
+	%v.26 = add i32 %v.25, 1
+	%v.27 = sext i32 %v.26 to i64
+	store i64 %v.27, i64* %s.1
+	br label %L_collatz_0
+L_collatz_0:
+	%v.28 = load i64, i64* %s.2
+	%v.29 = trunc i64 %v.28 to i32
+	%v.30 = load i64, i64* %s.0
+	%v.31 = trunc i64 %v.30 to i32
+	%v.32 = icmp slt i32 %v.29, %v.31
+	br i1 %v.32, label %L_collatz_1, label %bb.33
+bb.33:
+	%v.34 = load i64, i64* %s.1
+	store i64 %v.34, i64* %ret.val
+	%v.35 = load i64, i64* %ret.val
+	ret i64 %v.35
+}
+declare void @dwislpy_print_int(i32)
+declare void @dwislpy_print_str(i8*)
+declare i32 @dwislpy_read_int()
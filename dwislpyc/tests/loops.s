@@ -0,0 +1,126 @@
+	.data
+S_4bd7350d99319bfd:
+	.asciiz "True\n"
+S_b0f65372789f6ad6:
+	.asciiz "False\n"
+S_33546ad8481114a3:
+	.ascii "None"
+S_af63c74c8601c8dd:
+	.asciiz "\n"
+L_0:
+	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+	.text
+	.globl main
+main:
+	sw $fp,-4($sp)
+	move $fp, $sp
+	addi $sp,$sp,-24
+	sw $s0,-8($fp)
+	sw $s1,-12($fp)
+	sw $s2,-16($fp)
+	sw $s3,-20($fp)
+	sw $s4,-24($fp)
+	li $t3,0
+	li $t4,0
+	li $t5,63
+	li $t6,0
+	j L_main_0
+L_main_1:
+	add $t7,$t4,$t6
+	addi $t4,$t7,27
+	addi $t3,$t3,1
+	addiu $t6,$t6,12
+L_main_0:
+	blt $t3,$t5,L_main_1
+	move $a0,$t4
+	li $v0,1
+	syscall
+	la $t8,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t8
+	syscall
+	li $t9,10
+	li $t7,0
+	li $t3,0
+	li $t5,20
+	li $t6,1000
+	j L_main_3
+L_main_4:
+	li $t8,0
+	li $s0,0
+	li $s1,0
+	j L_main_6
+L_main_7:
+	add $s2,$t7,$t6
+	add $s3,$s2,$s0
+	sra $t2,$s1,31
+	srl $t2,$t2,30
+	addu $t2,$s1,$t2
+	sra $s4,$t2,2
+	add $t7,$s3,$s4
+	addi $t8,$t8,2
+	addiu $s0,$s0,16
+	addiu $s1,$s1,6
+L_main_6:
+	blt $t8,$t5,L_main_7
+	addi $t9,$t9,-1
+	addiu $t5,$t5,-2
+	addiu $t6,$t6,-100
+L_main_3:
+	blt $t3,$t9,L_main_4
+	move $a0,$t7
+	li $v0,1
+	syscall
+	la $t8,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t8
+	syscall
+	li $t9,0
+	li $t3,0
+	li $t5,5
+	j L_main_9
+L_main_10:
+	sll $t6,$t9,16
+	add $t3,$t3,$t6
+	addi $t9,$t9,1
+L_main_9:
+	blt $t9,$t5,L_main_10
+	move $a0,$t3
+	li $v0,1
+	syscall
+	la $t7,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t7
+	syscall
+	li $t8,0
+	li $t6,100
+	bge $t4,$t6,L_main_13
+	li $t9,1
+	j L_main_14
+L_main_13:
+	li $t9,2
+L_main_14:
+	li $t5,4
+	li $t3,0
+	j L_main_15
+L_main_16:
+	add $t9,$t9,$t3
+	addi $t8,$t8,1
+	addiu $t3,$t3,20
+L_main_15:
+	blt $t8,$t5,L_main_16
+	move $a0,$t9
+	li $v0,1
+	syscall
+	la $t7,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t7
+	syscall
+	lw $s0,-8($fp)
+	lw $s1,-12($fp)
+	lw $s2,-16($fp)
+	lw $s3,-20($fp)
+	lw $s4,-24($fp)
+	lw $fp,-4($fp)
+	addi $sp,$sp,24
+	jr $ra
@@ -1,102 +1,51 @@
 	.data
-L_6:
+S_704be0d8faaffc58:
 	.asciiz "string"
-L_5:
-	.asciiz "string"
-L_4:
-	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
-L_2:
-	.asciiz "False"
-L_1:
-	.asciiz "True"
-L_3:
-	.asciiz "None"
-L_0:
+S_4bd7350d99319bfd:
+	.asciiz "True\n"
+S_b0f65372789f6ad6:
+	.asciiz "False\n"
+S_33546ad8481114a3:
+	.ascii "None"
+S_af63c74c8601c8dd:
 	.asciiz "\n"
+L_0:
+	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
 	.text
 	.globl main
 main:
-	sw $ra,-68($sp)
-	sw $fp,-72($sp)
-	move $fp, $sp
-	addi $sp,$sp,-88
-	li $t0,1
-	sw $t0,-4($fp)
-	lw $t1,-4($fp)
-	move $t0,$t1
-	sw $t0,-12($fp)
-	lw $a0,-12($fp)
+	li $t3,1
+	move $a0,$t3
 	li $v0,1
 	syscall
-	la $t0,L_0
-	sw $t0,-16($fp)
+	la $t4,S_af63c74c8601c8dd
 	li $v0,4
-	lw $a0,-16($fp)
+	move $a0,$t4
 	syscall
-	lw $t1,-4($fp)
-	move $t0,$t1
-	sw $t0,-20($fp)
-	li $t0,1
-	sw $t0,-24($fp)
-	lw $t1,-20($fp)
-	lw $t2,-24($fp)
-	add $t0,$t1,$t2
-	sw $t0,-4($fp)
-	lw $t1,-4($fp)
-	move $t0,$t1
-	sw $t0,-28($fp)
-	lw $a0,-28($fp)
+	li $t5,2
+	move $a0,$t5
 	li $v0,1
 	syscall
-	la $t0,L_0
-	sw $t0,-32($fp)
+	la $t6,S_af63c74c8601c8dd
 	li $v0,4
-	lw $a0,-32($fp)
+	move $a0,$t6
 	syscall
-	lw $t1,-4($fp)
-	move $t0,$t1
-	sw $t0,-36($fp)
-	li $t0,1
-	sw $t0,-40($fp)
-	lw $t1,-36($fp)
-	lw $t2,-40($fp)
-	sub $t0,$t1,$t2
-	sw $t0,-4($fp)
-	lw $t1,-4($fp)
-	move $t0,$t1
-	sw $t0,-44($fp)
-	lw $a0,-44($fp)
+	li $t7,1
+	move $a0,$t7
 	li $v0,1
 	syscall
-	la $t0,L_0
-	sw $t0,-48($fp)
+	la $t8,S_af63c74c8601c8dd
 	li $v0,4
-	lw $a0,-48($fp)
+	move $a0,$t8
 	syscall
-	la $t0,L_5
-	sw $t0,-8($fp)
-	lw $t1,-8($fp)
-	move $t0,$t1
-	sw $t0,-52($fp)
-	la $t0,L_6
-	sw $t0,-56($fp)
-	lw $t1,-52($fp)
-	lw $t2,-56($fp)
-	add $t0,$t1,$t2
-	sw $t0,-8($fp)
-	lw $t1,-8($fp)
-	move $t0,$t1
-	sw $t0,-60($fp)
+	la $t9,S_704be0d8faaffc58
+	la $t3,S_704be0d8faaffc58
+	add $t9,$t9,$t3
 	li $v0,4
-	lw $a0,-60($fp)
+	move $a0,$t9
 	syscall
-	la $t0,L_0
-	sw $t0,-64($fp)
+	la $t4,S_af63c74c8601c8dd
 	li $v0,4
-	lw $a0,-64($fp)
+	move $a0,$t4
 	syscall
-main_done:
-	lw $ra,-68($fp)
-	lw $fp,-72($fp)
-	addi $sp,$sp,88
 	jr $ra
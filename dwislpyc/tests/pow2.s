@@ -0,0 +1,241 @@
+	.data
+S_4bd7350d99319bfd:
+	.asciiz "True\n"
+S_b0f65372789f6ad6:
+	.asciiz "False\n"
+S_33546ad8481114a3:
+	.ascii "None"
+S_af63c74c8601c8dd:
+	.asciiz "\n"
+L_0:
+	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+	.text
+	.globl main
+main:
+	sw $fp,-8($sp)
+	move $fp, $sp
+	addi $sp,$sp,-40
+	sw $s0,-12($fp)
+	sw $s1,-16($fp)
+	sw $s2,-20($fp)
+	sw $s3,-24($fp)
+	sw $s4,-28($fp)
+	sw $s5,-32($fp)
+	sw $s6,-36($fp)
+	sw $s7,-40($fp)
+	li $t3,-37
+	li $t4,0
+	li $t5,6
+	la $t6,S_af63c74c8601c8dd
+	la $t7,S_af63c74c8601c8dd
+	la $t8,S_af63c74c8601c8dd
+	la $t9,S_af63c74c8601c8dd
+	li $s0,0
+	la $s1,S_af63c74c8601c8dd
+	la $s2,S_af63c74c8601c8dd
+	la $s3,S_af63c74c8601c8dd
+	la $s4,S_af63c74c8601c8dd
+	la $s5,S_af63c74c8601c8dd
+	la $s6,S_af63c74c8601c8dd
+	li $t0,-148
+	sw $t0,-4($fp)
+	j L_main_0
+L_main_1:
+	sra $t2,$t3,31
+	srl $t2,$t2,29
+	addu $t2,$t3,$t2
+	sra $s7,$t2,3
+	move $a0,$s7
+	li $v0,1
+	syscall
+	li $v0,4
+	move $a0,$t6
+	syscall
+	sra $t2,$t3,31
+	srl $t2,$t2,29
+	addu $t1,$t3,$t2
+	andi $t1,$t1,7
+	subu $s7,$t1,$t2
+	move $a0,$s7
+	li $v0,1
+	syscall
+	li $v0,4
+	move $a0,$t7
+	syscall
+	lw $a0,-4($fp)
+	li $v0,1
+	syscall
+	li $v0,4
+	move $a0,$t8
+	syscall
+	move $a0,$t3
+	li $v0,1
+	syscall
+	li $v0,4
+	move $a0,$t9
+	syscall
+	move $a0,$s0
+	li $v0,1
+	syscall
+	li $v0,4
+	move $a0,$s1
+	syscall
+	move $a0,$t3
+	li $v0,1
+	syscall
+	li $v0,4
+	move $a0,$s2
+	syscall
+	addi $s7,$t3,-5
+	move $a0,$s7
+	li $v0,1
+	syscall
+	li $v0,4
+	move $a0,$s3
+	syscall
+	addi $s7,$t3,3
+	move $a0,$s7
+	li $v0,1
+	syscall
+	li $v0,4
+	move $a0,$s4
+	syscall
+	srl $t2,$t3,31
+	addu $t2,$t3,$t2
+	sra $s7,$t2,1
+	move $a0,$s7
+	li $v0,1
+	syscall
+	li $v0,4
+	move $a0,$s5
+	syscall
+	srl $t2,$t3,31
+	addu $t1,$t3,$t2
+	andi $t1,$t1,1
+	subu $s7,$t1,$t2
+	move $a0,$s7
+	li $v0,1
+	syscall
+	li $v0,4
+	move $a0,$s6
+	syscall
+	sra $t2,$t3,31
+	srl $t2,$t2,28
+	addu $t1,$t3,$t2
+	andi $t1,$t1,15
+	subu $s7,$t1,$t2
+	move $a0,$s7
+	li $v0,1
+	syscall
+	la $s7,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$s7
+	syscall
+	li $s7,9
+	bge $t3,$s7,L_main_4
+	la $s7,S_4bd7350d99319bfd
+	j L_main_5
+L_main_4:
+	la $s7,S_b0f65372789f6ad6
+L_main_5:
+	li $v0,4
+	move $a0,$s7
+	syscall
+	addi $t3,$t3,15
+	lw $t1,-4($fp)
+	addiu $t0,$t1,60
+	sw $t0,-4($fp)
+	addi $t4,$t4,1
+L_main_0:
+	blt $t4,$t5,L_main_1
+	li $t3,110000
+	move $a0,$t3
+	li $v0,1
+	syscall
+	la $t4,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t4
+	syscall
+	li $t5,30000
+	move $a0,$t5
+	li $v0,1
+	syscall
+	la $t6,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t6
+	syscall
+	li $t7,71680000
+	move $a0,$t7
+	li $v0,1
+	syscall
+	la $t8,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t8
+	syscall
+	li $t9,68
+	move $a0,$t9
+	li $v0,1
+	syscall
+	la $t3,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t3
+	syscall
+	li $t4,368
+	move $a0,$t4
+	li $v0,1
+	syscall
+	la $t5,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t5
+	syscall
+	li $t6,-37857
+	move $a0,$t6
+	li $v0,1
+	syscall
+	la $t7,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t7
+	syscall
+	li $t8,-2
+	move $a0,$t8
+	li $v0,1
+	syscall
+	la $t9,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t9
+	syscall
+	li $t3,70000
+	move $a0,$t3
+	li $v0,1
+	syscall
+	la $t4,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t4
+	syscall
+	li $t5,-300001
+	move $a0,$t5
+	li $v0,1
+	syscall
+	la $t6,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t6
+	syscall
+	li $t7,0
+	move $a0,$t7
+	li $v0,1
+	syscall
+	la $t8,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t8
+	syscall
+	lw $s0,-12($fp)
+	lw $s1,-16($fp)
+	lw $s2,-20($fp)
+	lw $s3,-24($fp)
+	lw $s4,-28($fp)
+	lw $s5,-32($fp)
+	lw $s6,-36($fp)
+	lw $s7,-40($fp)
+	lw $fp,-8($fp)
+	addi $sp,$sp,40
+	jr $ra
@@ -0,0 +1,124 @@
+	.data
+S_4bd7350d99319bfd:
+	.asciiz "True\n"
+S_b0f65372789f6ad6:
+	.asciiz "False\n"
+S_33546ad8481114a3:
+	.ascii "None"
+S_af63c74c8601c8dd:
+	.asciiz "\n"
+L_0:
+	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+	.text
+	.globl main
+main:
+	sw $fp,-4($sp)
+	move $fp, $sp
+	addi $sp,$sp,-40
+	sw $s0,-8($fp)
+	sw $s1,-12($fp)
+	sw $s2,-16($fp)
+	sw $s3,-20($fp)
+	sw $s4,-24($fp)
+	sw $s5,-28($fp)
+	sw $s6,-32($fp)
+	sw $s7,-36($fp)
+	li $t3,0
+	li $t4,0
+	li $t5,120
+	li $t6,0
+	li $t7,100
+	li $t8,50
+	li $t9,99
+	j L_main_0
+L_main_1:
+	slt $s0,$t3,$t6
+	xori $s0,$s0,1
+	slt $s1,$t7,$t3
+	xori $s1,$s1,1
+	and $s2,$s0,$s1
+	xor $s3,$t3,$t8
+	sltiu $s3,$s3,1
+	xori $s4,$s3,1
+	and $s5,$s2,$s4
+	slti $s6,$t3,30
+	xor $s7,$t3,$t9
+	sltiu $s7,$s7,1
+	or $s0,$s6,$s7
+	and $s1,$s5,$s0
+	blez $s1,L_main_4
+	addi $t4,$t4,1
+L_main_4:
+	addi $t3,$t3,7
+L_main_0:
+	blt $t3,$t5,L_main_1
+	move $a0,$t4
+	li $v0,1
+	syscall
+	la $t3,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t3
+	syscall
+	la $t5,S_4bd7350d99319bfd
+	li $v0,4
+	move $a0,$t5
+	syscall
+	la $t6,S_b0f65372789f6ad6
+	li $v0,4
+	move $a0,$t6
+	syscall
+	la $t7,S_b0f65372789f6ad6
+	li $v0,4
+	move $a0,$t7
+	syscall
+	la $t8,S_4bd7350d99319bfd
+	li $v0,4
+	move $a0,$t8
+	syscall
+	la $t9,S_4bd7350d99319bfd
+	li $v0,4
+	move $a0,$t9
+	syscall
+	la $t4,S_4bd7350d99319bfd
+	li $v0,4
+	move $a0,$t4
+	syscall
+	la $t3,S_b0f65372789f6ad6
+	li $v0,4
+	move $a0,$t3
+	syscall
+	la $t5,S_4bd7350d99319bfd
+	li $v0,4
+	move $a0,$t5
+	syscall
+	la $t6,S_4bd7350d99319bfd
+	li $v0,4
+	move $a0,$t6
+	syscall
+	la $t7,S_b0f65372789f6ad6
+	li $v0,4
+	move $a0,$t7
+	syscall
+	la $t8,S_4bd7350d99319bfd
+	li $v0,4
+	move $a0,$t8
+	syscall
+	la $t9,S_b0f65372789f6ad6
+	li $v0,4
+	move $a0,$t9
+	syscall
+	la $t4,S_4bd7350d99319bfd
+	li $v0,4
+	move $a0,$t4
+	syscall
+	lw $s0,-8($fp)
+	lw $s1,-12($fp)
+	lw $s2,-16($fp)
+	lw $s3,-20($fp)
+	lw $s4,-24($fp)
+	lw $s5,-28($fp)
+	lw $s6,-32($fp)
+	lw $s7,-36($fp)
+	lw $fp,-4($fp)
+	addi $sp,$sp,40
+	jr $ra
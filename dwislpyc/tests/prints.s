@@ -0,0 +1,61 @@
+	.data
+S_a9bc80cca21f28b3:
+	.asciiz "hello\n"
+S_4bd7350d99319bfd:
+	.asciiz "True\n"
+S_b0f65372789f6ad6:
+	.asciiz "False\n"
+S_33546ad8481114a3:
+	.asciiz "None\n"
+S_2bd2501809bb5bab:
+	.ascii "42"
+S_af63c74c8601c8dd:
+	.asciiz "\n"
+L_0:
+	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+	.text
+	.globl main
+main:
+	la $t4,S_a9bc80cca21f28b3
+	li $v0,4
+	move $a0,$t4
+	syscall
+	la $t5,S_a9bc80cca21f28b3
+	li $v0,4
+	move $a0,$t5
+	syscall
+	la $t6,S_2bd2501809bb5bab
+	li $v0,4
+	move $a0,$t6
+	syscall
+	la $t7,S_4bd7350d99319bfd
+	li $v0,4
+	move $a0,$t7
+	syscall
+	la $t8,S_33546ad8481114a3
+	li $v0,4
+	move $a0,$t8
+	syscall
+	la $t9,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t9
+	syscall
+	li $t4,0
+	slt $t5,$t4,$t3
+	beqz $t5,L_main_1
+	la $t6,S_4bd7350d99319bfd
+	j L_main_2
+L_main_1:
+	la $t6,S_b0f65372789f6ad6
+L_main_2:
+	li $v0,4
+	move $a0,$t6
+	syscall
+	move $a0,$t3
+	li $v0,1
+	syscall
+	la $t7,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t7
+	syscall
+	jr $ra
@@ -0,0 +1,152 @@
+	.data
+S_4bd7350d99319bfd:
+	.asciiz "True\n"
+S_b0f65372789f6ad6:
+	.asciiz "False\n"
+S_33546ad8481114a3:
+	.ascii "None"
+S_af63c74c8601c8dd:
+	.asciiz "\n"
+L_0:
+	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+	.text
+	.globl main
+main:
+	sw $ra,-4($sp)
+	sw $fp,-8($sp)
+	move $fp, $sp
+	addi $sp,$sp,-24
+	li $t3,5000
+	move $a0,$t3
+	jal is_even
+	move $t4,$v0
+	beqz $t4,L_main_1
+	la $t5,S_4bd7350d99319bfd
+	j L_main_2
+L_main_1:
+	la $t5,S_b0f65372789f6ad6
+L_main_2:
+	li $v0,4
+	move $a0,$t5
+	syscall
+	li $t6,777
+	move $a0,$t6
+	jal is_odd
+	move $t7,$v0
+	beqz $t7,L_main_4
+	la $t8,S_4bd7350d99319bfd
+	j L_main_5
+L_main_4:
+	la $t8,S_b0f65372789f6ad6
+L_main_5:
+	li $v0,4
+	move $a0,$t8
+	syscall
+	li $t9,20
+	li $t3,7
+	move $a0,$t9
+	move $a1,$t3
+	jal countdown
+	li $t4,2000
+	move $a0,$t4
+	li $v0,1
+	syscall
+	la $t5,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t5
+	syscall
+	li $t6,2000
+	li $t7,1
+	move $a0,$t6
+	move $a1,$t7
+	jal last
+	move $t8,$v0
+	move $a0,$t8
+	li $v0,1
+	syscall
+	la $t9,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t9
+	syscall
+	li $t3,5
+	move $a0,$t3
+	li $v0,1
+	syscall
+	la $t4,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t4
+	syscall
+	li $t5,5
+	li $t6,1
+	move $a0,$t5
+	move $a1,$t6
+	jal last
+	move $t7,$v0
+	move $a0,$t7
+	li $v0,1
+	syscall
+	la $t8,S_af63c74c8601c8dd
+	li $v0,4
+	move $a0,$t8
+	syscall
+	lw $ra,-4($fp)
+	lw $fp,-8($fp)
+	addi $sp,$sp,24
+	jr $ra
+last:
+	li $t3,0
+	li $t4,3
+	li $t5,1000
+	j L_last_3
+L_last_1:
+	addi $t6,$a0,-1
+	mul $t7,$a1,$t4
+	rem $t8,$t7,$t5
+	add $t9,$t8,$a0
+	move $a0,$t6
+	move $a1,$t9
+L_last_3:
+	bne $a0,$t3,L_last_1
+	move $v0,$a1
+	jr $ra
+countdown:
+	move $t3,$a0
+	li $t4,0
+	la $t5,S_af63c74c8601c8dd
+	j L_countdown_3
+L_countdown_1:
+	move $a0,$t3
+	li $v0,1
+	syscall
+	li $v0,4
+	move $a0,$t5
+	syscall
+	sub $t6,$t3,$a1
+	move $t3,$t6
+L_countdown_3:
+	bge $t3,$t4,L_countdown_1
+	li $t7,0
+	move $v0,$t7
+	jr $ra
+is_odd:
+	move $t3,$a0
+	li $t4,0
+	bne $t3,$t4,L_is_odd_1
+	li $t5,0
+	move $v0,$t5
+	jr $ra
+L_is_odd_1:
+	addi $t6,$t3,-1
+	move $a0,$t6
+	j is_even
+is_even:
+	move $t3,$a0
+	li $t4,0
+	bne $t3,$t4,L_is_even_1
+	li $t5,1
+	move $v0,$t5
+	jr $ra
+L_is_even_1:
+	addi $t6,$t3,-1
+	move $a0,$t6
+	j is_odd
@@ -1,129 +1,61 @@
 	.data
-L_14:
-	.asciiz "I hit 1"
-L_4:
-	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
-L_2:
-	.asciiz "False"
-L_1:
-	.asciiz "True"
-L_3:
-	.asciiz "None"
-L_0:
+S_4bd7350d99319bfd:
+	.asciiz "True\n"
+S_b0f65372789f6ad6:
+	.asciiz "False\n"
+S_33546ad8481114a3:
+	.asciiz "None\n"
+S_95c52e047fb44534:
+	.ascii "I hit 1"
+S_af63c74c8601c8dd:
 	.asciiz "\n"
+L_0:
+	.asciiz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
 	.text
 	.globl main
 main:
-	sw $ra,-84($sp)
-	sw $fp,-88($sp)
-	move $fp, $sp
-	addi $sp,$sp,-104
-	li $t0,0
-	sw $t0,-8($fp)
-L_5:
-	lw $t1,-8($fp)
-	move $t0,$t1
-	sw $t0,-12($fp)
-	li $t0,2
-	sw $t0,-16($fp)
-	lw $t1,-12($fp)
-	lw $t2,-16($fp)
-	blt $t1,$t2,L_6
-	j L_7
-L_6:
-	lw $t1,-8($fp)
-	move $t0,$t1
-	sw $t0,-20($fp)
-	li $t0,1
-	sw $t0,-24($fp)
-	lw $t1,-20($fp)
-	lw $t2,-24($fp)
-	add $t0,$t1,$t2
-	sw $t0,-8($fp)
-	j L_5
-L_7:
-	lw $t1,-8($fp)
-	move $t0,$t1
-	sw $t0,-28($fp)
-	lw $a0,-28($fp)
+	li $t3,0
+	li $t4,2
+	j L_main_0
+L_main_1:
+	addi $t3,$t3,1
+L_main_0:
+	blt $t3,$t4,L_main_1
+	move $a0,$t3
 	li $v0,1
 	syscall
-	la $t0,L_0
-	sw $t0,-32($fp)
+	la $t5,S_af63c74c8601c8dd
 	li $v0,4
-	lw $a0,-32($fp)
-	syscall
-	li $t0,0
-	sw $t0,-8($fp)
-L_8:
-	lw $t1,-8($fp)
-	move $t0,$t1
-	sw $t0,-36($fp)
-	li $t0,2
-	sw $t0,-40($fp)
-	lw $t1,-36($fp)
-	lw $t2,-40($fp)
-	blt $t1,$t2,L_9
-	j L_10
-L_9:
-	lw $t1,-8($fp)
-	move $t0,$t1
-	sw $t0,-44($fp)
-	li $t0,1
-	sw $t0,-48($fp)
-	lw $t1,-44($fp)
-	lw $t2,-48($fp)
-	beq $t1,$t2,L_11
-	j L_12
-L_11:
-	la $t0,L_14
-	sw $t0,-52($fp)
-	li $v0,4
-	lw $a0,-52($fp)
-	syscall
-	la $t0,L_0
-	sw $t0,-56($fp)
+	move $a0,$t5
+	syscall
+	li $t3,0
+	li $t6,2
+	li $t7,1
+	la $t8,S_af63c74c8601c8dd
+	la $t9,S_95c52e047fb44534
+	j L_main_3
+L_main_4:
+	bne $t3,$t7,L_main_7
 	li $v0,4
-	lw $a0,-56($fp)
+	move $a0,$t9
 	syscall
-	j L_13
-L_12:
-	lw $t1,-8($fp)
-	move $t0,$t1
-	sw $t0,-60($fp)
-	lw $a0,-60($fp)
+	j L_main_8
+L_main_7:
+	move $a0,$t3
 	li $v0,1
 	syscall
-	la $t0,L_0
-	sw $t0,-64($fp)
 	li $v0,4
-	lw $a0,-64($fp)
+	move $a0,$t8
 	syscall
-L_13:
-	lw $t1,-8($fp)
-	move $t0,$t1
-	sw $t0,-68($fp)
-	li $t0,1
-	sw $t0,-72($fp)
-	lw $t1,-68($fp)
-	lw $t2,-72($fp)
-	add $t0,$t1,$t2
-	sw $t0,-8($fp)
-	j L_8
-L_10:
-	lw $t1,-8($fp)
-	move $t0,$t1
-	sw $t0,-76($fp)
-	lw $a0,-76($fp)
+L_main_8:
+	addi $t3,$t3,1
+L_main_3:
+	blt $t3,$t6,L_main_4
+	move $a0,$t3
 	li $v0,1
 	syscall
-	la $t0,L_0
-	sw $t0,-80($fp)
+	la $t4,S_af63c74c8601c8dd
 	li $v0,4
-	lw $a0,-80($fp)
+	move $a0,$t4
 	syscall
-main_done:
-	lw $ra,-84($fp)
-	lw $fp,-88($fp)
-	addi $sp,$sp,104
 	jr $ra
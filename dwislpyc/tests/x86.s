@@ -0,0 +1,324 @@
+	.data
+S_21fe8219261a24de:
+	.asciz "n? "
+S_4bd7350d99319bfd:
+	.asciz "True\n"
+S_b0f65372789f6ad6:
+	.asciz "False\n"
+S_33546ad8481114a3:
+	.asciz "None\n"
+S_a65bfaac50fb64d1:
+	.ascii "gcd:"
+S_af63c74c8601c8dd:
+	.asciz "\n"
+L_0:
+	.asciz "12345678901234567890123456789012345678901234567890123456789012345678901234567890"
+	.text
+	.globl _start
+main:
+	pushq %rbp
+	movq %rsp,%rbp
+	subq $32,%rsp
+	movq %rbx,-8(%rbp)
+	movq %r12,-16(%rbp)
+	movq %r13,-24(%rbp)
+	movq %r14,-32(%rbp)
+	leaq S_21fe8219261a24de(%rip),%r8
+	movq %r8,%rdi
+	call dwislpy_print_str
+	call dwislpy_read_int
+	movq %rax,%rbx
+	leaq S_a65bfaac50fb64d1(%rip),%r9
+	movq %r9,%rdi
+	call dwislpy_print_str
+	movl $84,%r8d
+	movl %ebx,%r9d
+	imull %r8d,%r9d
+	movl $126,%r8d
+	movq %r9,%rdi
+	movq %r8,%rsi
+	call gcd
+	movq %rax,%r9
+	movq %r9,%rdi
+	call dwislpy_print_int
+	leaq S_af63c74c8601c8dd(%rip),%r8
+	movq %r8,%rdi
+	call dwislpy_print_str
+	movl $-298,%r9d
+	movq %r9,%rdi
+	call dwislpy_print_int
+	leaq S_af63c74c8601c8dd(%rip),%r8
+	movq %r8,%rdi
+	call dwislpy_print_str
+	movl $3,%r9d
+	movl %ebx,%r8d
+	imull %r9d,%r8d
+	movl %ebx,%r11d
+	shrl $31,%r11d
+	addl %ebx,%r11d
+	sarl $1,%r11d
+	movl %r11d,%r9d
+	movl %r8d,%r11d
+	sarl $31,%r11d
+	shrl $30,%r11d
+	movl %r8d,%r10d
+	addl %r11d,%r10d
+	andl $3,%r10d
+	subl %r11d,%r10d
+	movl %r10d,%r12d
+	movl $100,%r8d
+	movl %r9d,%r13d
+	imull %r8d,%r13d
+	movl %r13d,%r9d
+	addl %r12d,%r9d
+	movq %r9,%rdi
+	call dwislpy_print_int
+	leaq S_af63c74c8601c8dd(%rip),%r8
+	movq %r8,%rdi
+	call dwislpy_print_str
+	movl $0,%r9d
+	movl %r9d,%r8d
+	subl %ebx,%r8d
+	movl %r8d,%r11d
+	sarl $31,%r11d
+	shrl $30,%r11d
+	addl %r8d,%r11d
+	sarl $2,%r11d
+	movl %r11d,%r9d
+	movq %r9,%rdi
+	call dwislpy_print_int
+	leaq S_af63c74c8601c8dd(%rip),%r8
+	movq %r8,%rdi
+	call dwislpy_print_str
+	movl $0,%r9d
+	movl %r9d,%r8d
+	subl %ebx,%r8d
+	movl %r8d,%r11d
+	sarl $31,%r11d
+	shrl $30,%r11d
+	movl %r8d,%r10d
+	addl %r11d,%r10d
+	andl $3,%r10d
+	subl %r11d,%r10d
+	movl %r10d,%r9d
+	movq %r9,%rdi
+	call dwislpy_print_int
+	leaq S_af63c74c8601c8dd(%rip),%r8
+	movq %r8,%rdi
+	call dwislpy_print_str
+	movl $6,%r9d
+	cmpl %r9d,%ebx
+	jg L_main_1
+	movl $7,%r8d
+	cmpl %r8d,%ebx
+	je L_main_1
+	leaq S_4bd7350d99319bfd(%rip),%r9
+	jmp L_main_2
+L_main_1:
+	leaq S_b0f65372789f6ad6(%rip),%r9
+L_main_2:
+	movq %r9,%rdi
+	call dwislpy_print_str
+	movl $0,%r8d
+	movl $0,%r9d
+	jmp L_main_4
+L_main_5:
+	movl %r8d,%r14d
+	imull %r8d,%r14d
+	addl %r14d,%r9d
+	leal 1(%r8),%r8d
+L_main_4:
+	cmpl %ebx,%r8d
+	jl L_main_5
+	movq %r9,%rdi
+	call dwislpy_print_int
+	leaq S_af63c74c8601c8dd(%rip),%r8
+	movq %r8,%rdi
+	call dwislpy_print_str
+	movl $-2147483648,%r9d
+	movq %r9,%rdi
+	call dwislpy_print_int
+	leaq S_af63c74c8601c8dd(%rip),%r8
+	movq %r8,%rdi
+	call dwislpy_print_str
+	movq -8(%rbp),%rbx
+	movq -16(%rbp),%r12
+	movq -24(%rbp),%r13
+	movq -32(%rbp),%r14
+	leave
+	ret
+gcd:
+	pushq %rbp
+	movq %rsp,%rbp
+	movl $0,%r8d
+	jmp L_gcd_3
+L_gcd_1:
+	movl %edi,%eax
+	movq %rdx,%r10
+	cltd
+	idivl %esi
+	movl %edx,%r9d
+	movq %r10,%rdx
+	movq %rsi,%rdi
+	movq %r9,%rsi
+L_gcd_3:
+	cmpl %r8d,%esi
+	jne L_gcd_1
+	movq %rdi,%rax
+	leave
+	ret
+_start:
+	call main
+	call dwislpy_flush
+	movl $60,%eax
+	xorl %edi,%edi
+	syscall
+dwislpy_flush:
+	pushq %rax
+	pushq %rdi
+	pushq %rsi
+	pushq %rdx
+	pushq %rcx
+	pushq %r11
+	leaq dwislpy_out_buf(%rip),%rsi
+	movq dwislpy_out_len(%rip),%rdx
+1:	testq %rdx,%rdx
+	jle 2f
+	movl $1,%eax
+	movl $1,%edi
+	syscall
+	testq %rax,%rax
+	jle 2f
+	addq %rax,%rsi
+	subq %rax,%rdx
+	jmp 1b
+2:	movq $0,dwislpy_out_len(%rip)
+	popq %r11
+	popq %rcx
+	popq %rdx
+	popq %rsi
+	popq %rdi
+	popq %rax
+	ret
+dwislpy_putc:
+	pushq %rdx
+	pushq %rcx
+	leaq dwislpy_out_buf(%rip),%rcx
+	movq dwislpy_out_len(%rip),%rdx
+	movb %al,(%rcx,%rdx)
+	incq %rdx
+	movq %rdx,dwislpy_out_len(%rip)
+	cmpq $4096,%rdx
+	jb 1f
+	call dwislpy_flush
+1:	popq %rcx
+	popq %rdx
+	ret
+dwislpy_print_str:
+	pushq %rsi
+	movq %rdi,%rsi
+1:	movzbl (%rsi),%eax
+	testl %eax,%eax
+	jz 2f
+	call dwislpy_putc
+	incq %rsi
+	jmp 1b
+2:	popq %rsi
+	ret
+dwislpy_print_int:
+	pushq %rdx
+	pushq %rcx
+	pushq %rsi
+	subq $24,%rsp
+	movslq %edi,%rax
+	movq %rax,%rcx
+	testq %rax,%rax
+	jns 1f
+	negq %rax
+1:	leaq 23(%rsp),%rsi
+	movq $10,%rdi
+2:	xorl %edx,%edx
+	divq %rdi
+	addb $48,%dl
+	movb %dl,(%rsi)
+	decq %rsi
+	testq %rax,%rax
+	jnz 2b
+	testq %rcx,%rcx
+	jns 3f
+	movb $45,(%rsi)
+	decq %rsi
+3:	incq %rsi
+	leaq 24(%rsp),%rdx
+4:	movb (%rsi),%al
+	call dwislpy_putc
+	incq %rsi
+	cmpq %rdx,%rsi
+	jb 4b
+	addq $24,%rsp
+	popq %rsi
+	popq %rcx
+	popq %rdx
+	ret
+dwislpy_read_int:
+	call dwislpy_flush
+	pushq %rdi
+	pushq %rsi
+	pushq %rdx
+	pushq %rcx
+	pushq %r11
+	pushq %rbx
+	pushq %r8
+	pushq %r9
+	subq $8,%rsp
+	xorl %r8d,%r8d
+	xorl %r9d,%r9d
+	xorl %ebx,%ebx
+1:	xorl %eax,%eax
+	xorl %edi,%edi
+	movq %rsp,%rsi
+	movl $1,%edx
+	syscall
+	testq %rax,%rax
+	jle 3f
+	movzbl (%rsp),%eax
+	cmpl $10,%eax
+	je 3f
+	cmpl $2,%ebx
+	je 1b
+	subl $48,%eax
+	cmpl $9,%eax
+	ja 2f
+	imull $10,%r8d,%r8d
+	addl %eax,%r8d
+	movl $1,%ebx
+	jmp 1b
+2:	testl %ebx,%ebx
+	jnz 4f
+	cmpl $-3,%eax
+	jne 1b
+	xorl $1,%r9d
+	jmp 1b
+4:	movl $2,%ebx
+	jmp 1b
+3:	movl %r8d,%eax
+	testl %r9d,%r9d
+	jz 5f
+	negl %eax
+5:	addq $8,%rsp
+	popq %r9
+	popq %r8
+	popq %rbx
+	popq %r11
+	popq %rcx
+	popq %rdx
+	popq %rsi
+	popq %rdi
+	ret
+	.data
+dwislpy_out_len:
+	.quad 0
+	.bss
+dwislpy_out_buf:
+	.skip 4096
+	.section .note.GNU-stack,"",@progbits